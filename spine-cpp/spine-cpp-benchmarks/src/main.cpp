@@ -0,0 +1,1269 @@
+#include <spine/spine.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <thread>
+
+#ifdef MSVC
+#pragma warning(disable : 4710)
+#endif
+
+using namespace spine;
+
+static double nanoTime() {
+	return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						   std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
+
+/// Builds an animation with a rotate and a translate timeline keyed keyCount times on the given bone.
+static Animation *createKeyedAnimation(int boneIndex, size_t keyCount) {
+	RotateTimeline *rotate = new (__FILE__, __LINE__) RotateTimeline(keyCount, 0, boneIndex);
+	TranslateTimeline *translate = new (__FILE__, __LINE__) TranslateTimeline(keyCount, 0, boneIndex);
+	for (size_t i = 0; i < keyCount; i++) {
+		float time = i / 30.0f;
+		rotate->setFrame(i, time, (float) (i % 360));
+		translate->setFrame(i, time, (float) i, -(float) i);
+	}
+	Vector<Timeline *> timelines;
+	timelines.add(rotate);
+	timelines.add(translate);
+	return new (__FILE__, __LINE__) Animation("keyed", timelines, (keyCount - 1) / 30.0f);
+}
+
+void benchmarkKeyframeSearch() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+	printf("keyframe search: apply cost per timeline by key count\n");
+	const size_t keyCounts[] = {4, 64, 1024, 16384};
+	const int iterations = 1000000;
+	for (size_t k = 0; k < sizeof(keyCounts) / sizeof(keyCounts[0]); k++) {
+		Animation *animation = createKeyedAnimation(1, keyCounts[k]);
+		float duration = animation->getDuration();
+		size_t timelineCount = animation->getTimelines().size();
+
+		// Playback advances by one frame per apply, seeking jumps by a stride that doesn't line up with the keys.
+		float strides[] = {1 / 60.0f, duration * 0.618034f};
+		double nsPerTimeline[2];
+		for (int s = 0; s < 2; s++) {
+			float time = 0;
+			double start = nanoTime();
+			for (int i = 0; i < iterations; i++) {
+				animation->apply(*skeleton, time, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				time += strides[s];
+				if (time > duration) time -= duration;
+			}
+			nsPerTimeline[s] = (nanoTime() - start) / iterations / timelineCount;
+		}
+		printf("  %6zu keys: %7.2f ns/timeline playback, %7.2f ns/timeline seeking\n", keyCounts[k],
+			   nsPerTimeline[0], nsPerTimeline[1]);
+		delete animation;
+	}
+
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkUpdateWorldTransform(bool batchUpdate) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+
+	const int skeletonCount = 2000, frames = 100;
+	Vector<Skeleton *> skeletons;
+	Vector<AnimationState *> states;
+	for (int i = 0; i < skeletonCount; i++) {
+		skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData, batchUpdate));
+		AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+		state->setAnimation(0, "walk", true)->setTrackTime(i * 0.01f);
+		states.add(state);
+	}
+
+	double elapsed = 0;
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < skeletonCount; i++) {
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+		}
+		double start = nanoTime();
+		for (int i = 0; i < skeletonCount; i++)
+			skeletons[i]->updateWorldTransform();
+		elapsed += nanoTime() - start;
+	}
+	printf("updateWorldTransform, %d raptors, %s: %.2f ns/skeleton\n", skeletonCount,
+		   batchUpdate ? "batch update" : "bones", elapsed / frames / skeletonCount);
+
+	for (int i = 0; i < skeletonCount; i++) {
+		delete states[i];
+		delete skeletons[i];
+	}
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkTrig() {
+#ifdef SPINE_FAST_TRIG
+	const char *backend = "polynomials";
+#else
+	const char *backend = "C library";
+#endif
+	const int calls = 10000000;
+	float sum = 0;
+	double start = nanoTime();
+	for (int i = 0; i < calls; i++)
+		sum += MathUtil::sinDeg(i * 0.01f) + MathUtil::cosDeg(i * 0.01f);
+	double separate = (nanoTime() - start) / calls;
+	start = nanoTime();
+	for (int i = 0; i < calls; i++) {
+		float sine, cosine;
+		MathUtil::sincosDeg(i * 0.01f, sine, cosine);
+		sum += sine + cosine;
+	}
+	double combined = (nanoTime() - start) / calls;
+	start = nanoTime();
+	for (int i = 0; i < calls; i++)
+		sum += MathUtil::atan2(i * 0.001f - 5000, 300);
+	double atan2 = (nanoTime() - start) / calls;
+	printf("trig, %s: %.2f ns sinDeg + cosDeg, %.2f ns sincosDeg, %.2f ns atan2 (%g)\n", backend, separate, combined,
+		   atan2, sum);
+
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	skeletonData->findAnimation("walk")->apply(*skeleton, 0, 0.3f, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+	const int iterations = 100000;
+	start = nanoTime();
+	for (int i = 0; i < iterations; i++)
+		skeleton->updateWorldTransform();
+	printf("trig, %s: %.2f ns/bone updateWorldTransform\n", backend,
+		   (nanoTime() - start) / iterations / skeleton->getBones().size());
+
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkWeightedVertices(const char *atlasFile, const char *skeletonFile, const char *animationName) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, animationName, true);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+	Vector<float> worldVertices;
+	const int frames = 20000;
+	size_t vertexCount = 0;
+	double elapsed = 0;
+	for (int frame = 0; frame < frames; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		double start = nanoTime();
+		for (size_t i = 0, n = skeleton->getSlots().size(); i < n; i++) {
+			Slot &slot = *skeleton->getSlots()[i];
+			Attachment *attachment = slot.getAttachment();
+			if (!attachment || !attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			if (mesh->getBones().size() == 0) continue;
+			size_t length = mesh->getWorldVerticesLength();
+			if (worldVertices.size() < length) worldVertices.setSize(length, 0);
+			mesh->computeWorldVertices(slot, 0, length, worldVertices.buffer(), 0, 2);
+			if (frame == 0) vertexCount += length >> 1;
+		}
+		elapsed += nanoTime() - start;
+	}
+	printf("weighted computeWorldVertices, %s: %.2f ns/vertex\n", skeletonFile, elapsed / frames / vertexCount);
+
+	delete skeleton;
+	delete state;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkSkeletonRenderer(const char *atlasFile, const char *skeletonFile, const char *animationName) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, animationName, true);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+	SkeletonRenderer renderer;
+	const int frames = 20000;
+	double elapsed = 0;
+	for (int frame = 0; frame < frames; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		double start = nanoTime();
+		renderer.render(*skeleton);
+		elapsed += nanoTime() - start;
+	}
+	printf("SkeletonRenderer render, %s: %.2f us/frame, %d commands, %d vertices\n", skeletonFile, elapsed / frames / 1000,
+		   (int) renderer.getCommands().size(), (int) renderer.getVertices().size());
+
+	delete skeleton;
+	delete state;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkAnimationBaker(const char *atlasFile, const char *skeletonFile, const char *animationName) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	Animation *animation = skeletonData->findAnimation(animationName);
+
+	AnimationBaker baker(skeletonData);
+	double start = nanoTime();
+	BakedAnimation *baked = baker.bake(*animation, 30);
+	printf("AnimationBaker bake, %s %s: %.2f ms, %d frames, %.1f KB\n", skeletonFile, animationName,
+		   (nanoTime() - start) / 1000000, (int) baked->getFrameCount(), baked->getMemoryUsage() / 1024.0);
+
+	const int count = 200, frames = 300;
+	Vector<Skeleton *> skeletons;
+	Vector<AnimationState *> states;
+	for (int i = 0; i < count; i++) {
+		skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+		states.add(new (__FILE__, __LINE__) AnimationState(stateData));
+		states[i]->setAnimation(0, animation, true)->setTrackTime(i * 0.01f);
+	}
+
+	start = nanoTime();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < count; i++) {
+			states[i]->update(1 / 60.0f);
+			states[i]->apply(*skeletons[i]);
+			skeletons[i]->updateWorldTransform();
+		}
+	}
+	double live = (nanoTime() - start) / frames / count;
+
+	start = nanoTime();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < count; i++)
+			baked->apply(*skeletons[i], frame / 60.0f + i * 0.01f, true, true);
+	}
+	double played = (nanoTime() - start) / frames / count;
+	printf("AnimationBaker playback, %s %s: live %.2f us, baked %.2f us per skeleton\n", skeletonFile, animationName,
+		   live / 1000, played / 1000);
+
+	for (int i = 0; i < count; i++) {
+		delete states[i];
+		delete skeletons[i];
+	}
+	delete baked;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkSkeletonUpdateBatch() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+
+	const int skeletonCount = 2000, frames = 100;
+	Vector<Skeleton *> skeletons;
+	Vector<AnimationState *> states;
+	for (int i = 0; i < skeletonCount; i++) {
+		skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+		AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+		state->setAnimation(0, "walk", true)->setTrackTime(i * 0.01f);
+		states.add(state);
+	}
+
+	size_t maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) maxThreads = 1;
+	double singleThreaded = 0;
+	for (size_t threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+		SkeletonUpdateBatch batch(threads);
+		for (int i = 0; i < skeletonCount; i++)
+			batch.add(*skeletons[i], *states[i]);
+		batch.update(1 / 60.0f);
+
+		double start = nanoTime();
+		for (int frame = 0; frame < frames; frame++)
+			batch.update(1 / 60.0f);
+		double nsPerSkeleton = (nanoTime() - start) / frames / skeletonCount;
+		if (threads == 1) singleThreaded = nsPerSkeleton;
+		printf("SkeletonUpdateBatch, %d raptors, %zu threads: %.2f ns/skeleton, %.2fx\n", skeletonCount, threads,
+			   nsPerSkeleton, singleThreaded / nsPerSkeleton);
+		if (threads == maxThreads) break;
+	}
+
+	for (int i = 0; i < skeletonCount; i++) {
+		delete states[i];
+		delete skeletons[i];
+	}
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkAnimationsChanged() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+
+	// 10 tracks, each playing one of 2 animations with 30 timelines, 300 timelines in total.
+	const int trackCount = 10, timelinesPerAnimation = 30, iterations = 20000;
+	int boneCount = (int) skeletonData->getBones().size();
+	Vector<Animation *> animations;
+	for (int i = 0; i < trackCount * 2; i++) {
+		Vector<Timeline *> timelines;
+		for (int ii = 0; ii < timelinesPerAnimation; ii += 3) {
+			int bone = ((i % trackCount) * timelinesPerAnimation / 3 + ii / 3) % boneCount;
+			RotateTimeline *rotate = new (__FILE__, __LINE__) RotateTimeline(2, 0, bone);
+			rotate->setFrame(0, 0, 0);
+			rotate->setFrame(1, 1, 90);
+			TranslateTimeline *translate = new (__FILE__, __LINE__) TranslateTimeline(2, 0, bone);
+			translate->setFrame(0, 0, 0, 0);
+			translate->setFrame(1, 1, 10, 10);
+			ScaleTimeline *scale = new (__FILE__, __LINE__) ScaleTimeline(2, 0, bone);
+			scale->setFrame(0, 0, 1, 1);
+			scale->setFrame(1, 1, 2, 2);
+			timelines.add(rotate);
+			timelines.add(translate);
+			timelines.add(scale);
+		}
+		animations.add(new (__FILE__, __LINE__) Animation(String("animation").append(i), timelines, 1));
+	}
+	for (int i = 0; i < trackCount; i++)
+		state->setAnimation(i, animations[i], true);
+	state->apply(*skeleton);
+
+	// Changing the animation of a track makes the next apply recompute the timeline modes of all tracks.
+	double start = nanoTime();
+	for (int i = 0; i < iterations; i++) {
+		int track = i % trackCount;
+		state->setAnimation(track, animations[track + (i / trackCount % 2) * trackCount], true);
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+	}
+	printf("animationsChanged, %d tracks, %d timelines: %.2f ns/change\n", trackCount,
+		   trackCount * timelinesPerAnimation, (nanoTime() - start) / iterations);
+
+	delete state;
+	delete stateData;
+	delete skeleton;
+	for (size_t i = 0; i < animations.size(); i++)
+		delete animations[i];
+	delete skeletonData;
+	delete atlas;
+}
+
+/// Tracks the bytes allocated through SpineExtension, their peak and the number of allocations.
+class CountingExtension : public DefaultSpineExtension {
+public:
+	CountingExtension() : _used(0), _peak(0), _allocations(0) {
+	}
+
+	void resetPeak() {
+		_peak = _used;
+	}
+
+	size_t getUsed() {
+		return _used;
+	}
+
+	size_t getPeak() {
+		return _peak;
+	}
+
+	size_t getAllocations() {
+		return _allocations;
+	}
+
+protected:
+	// Each allocation is prefixed with its size.
+	static const size_t Header = 16;
+
+	virtual void *_alloc(size_t size, const char *file, int line) {
+		SP_UNUSED(file);
+		SP_UNUSED(line);
+		if (size == 0) return NULL;
+		char *mem = (char *) ::malloc(size + Header);
+		*(size_t *) mem = size;
+		added(size);
+		_allocations++;
+		return mem + Header;
+	}
+
+	virtual void *_calloc(size_t size, const char *file, int line) {
+		void *mem = _alloc(size, file, line);
+		if (mem) memset(mem, 0, size);
+		return mem;
+	}
+
+	virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
+		if (!ptr) return _alloc(size, file, line);
+		char *mem = (char *) ptr - Header;
+		_used -= *(size_t *) mem;
+		mem = (char *) ::realloc(mem, size + Header);
+		*(size_t *) mem = size;
+		added(size);
+		_allocations++;
+		return mem + Header;
+	}
+
+	virtual void _free(void *ptr, const char *file, int line) {
+		SP_UNUSED(file);
+		SP_UNUSED(line);
+		if (!ptr) return;
+		char *mem = (char *) ptr - Header;
+		_used -= *(size_t *) mem;
+		::free(mem);
+	}
+
+private:
+	size_t _used, _peak, _allocations;
+
+	void added(size_t size) {
+		_used += size;
+		if (_used > _peak) _peak = _used;
+	}
+};
+
+/// Loads a .skel either through readSkeletonDataFile or by reading the file into memory first.
+static SkeletonData *loadBinary(Atlas *atlas, const char *file, bool readFile) {
+	SkeletonBinary binary(atlas);
+	if (!readFile) return binary.readSkeletonDataFile(file);
+	int length = 0;
+	char *data = SpineExtension::readFile(file, &length);
+	SkeletonData *skeletonData = binary.readSkeletonData((unsigned char *) data, length);
+	SpineExtension::free(data, __FILE__, __LINE__);
+	return skeletonData;
+}
+
+void benchmarkLayeredApply() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	stateData->setDefaultMix(0.25f);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+
+	// 4 layered tracks, the upper ones partially transparent, with the base and shoot tracks switching animations so
+	// the mixing path is measured as well.
+	const char *baseAnimations[] = {"run", "walk"};
+	state->setAnimation(0, baseAnimations[0], true);
+	state->setAnimation(1, "aim", true)->setAlpha(0.5f);
+	state->setAnimation(2, "shoot", true)->setAlpha(0.75f);
+	state->setAnimation(3, "idle", true)->setAlpha(0.25f);
+	state->update(0);
+	state->apply(*skeleton);
+
+	const int iterations = 100000;
+	double start = nanoTime();
+	for (int i = 0; i < iterations; i++) {
+		if (i % 120 == 0) {
+			state->setAnimation(0, baseAnimations[i / 120 % 2], true);
+			state->setAnimation(2, "shoot", false)->setAlpha(0.75f);
+		}
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+	}
+	printf("AnimationState apply, spineboy, 4 tracks: %.2f ns/apply\n", (nanoTime() - start) / iterations);
+
+	delete state;
+	delete stateData;
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+void benchmarkBinaryLoading(const char *atlasFile, const char *skeletonFile) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	SpineExtension::setInstance(&counting);
+
+	for (int readFile = 1; readFile >= 0; readFile--) {
+		const int iterations = 200;
+		size_t peak = 0, retained = 0;
+		double start = nanoTime();
+		for (int i = 0; i < iterations; i++) {
+			size_t used = counting.getUsed();
+			counting.resetPeak();
+			SkeletonData *skeletonData = loadBinary(atlas, skeletonFile, readFile != 0);
+			assert(skeletonData);
+			peak = counting.getPeak() - used;
+			retained = counting.getUsed() - used;
+			delete skeletonData;
+		}
+		printf("binary loading, %s, %s: %.2f us/load, %zu bytes peak, %zu bytes retained\n", skeletonFile,
+			   readFile ? "readFile" : "readSkeletonDataFile", (nanoTime() - start) / iterations / 1000, peak,
+			   retained);
+	}
+
+	SpineExtension::setInstance(extension);
+	delete atlas;
+}
+
+void benchmarkArena(const char *atlasFile, const char *skeletonFile) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	ArenaExtension arenaExtension(&counting);
+	SpineExtension::setInstance(&arenaExtension);
+
+	for (int useArena = 0; useArena <= 1; useArena++) {
+		SkeletonBinary binary(atlas);
+		binary.setUseArena(useArena != 0);
+		const int iterations = 200, skeletonCount = 200;
+		double loading = 0, deleting = 0;
+		size_t allocations = counting.getAllocations();
+		for (int i = 0; i < iterations; i++) {
+			double start = nanoTime();
+			SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+			assert(skeletonData);
+			loading += nanoTime() - start;
+			start = nanoTime();
+			delete skeletonData;
+			deleting += nanoTime() - start;
+		}
+		printf("arena, %s, %s: %.2f us/load, %.2f us/delete, %zu allocations/load\n", skeletonFile,
+			   useArena ? "arena" : "heap", loading / iterations / 1000, deleting / iterations / 1000,
+			   (counting.getAllocations() - allocations) / iterations);
+
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		Vector<Skeleton *> skeletons;
+		skeletons.setSize(skeletonCount, NULL);
+		allocations = counting.getAllocations();
+		double start = nanoTime();
+		for (int i = 0; i < skeletonCount; i++)
+			skeletons[i] = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		double creating = nanoTime() - start;
+		size_t skeletonAllocations = counting.getAllocations() - allocations;
+		start = nanoTime();
+		for (int i = 0; i < skeletonCount; i++)
+			delete skeletons[i];
+		deleting = nanoTime() - start;
+		printf("arena, %s, %s: %.2f us/skeleton created, %.2f us/skeleton deleted, %zu allocations/skeleton\n",
+			   skeletonFile, useArena ? "arena" : "heap", creating / skeletonCount / 1000,
+			   deleting / skeletonCount / 1000, skeletonAllocations / skeletonCount);
+		delete skeletonData;
+	}
+
+	SpineExtension::setInstance(extension);
+	delete atlas;
+}
+
+void benchmarkLazyAnimations(const char *atlasFile, const char *skeletonFile, const char *animationName) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	SpineExtension::setInstance(&counting);
+
+	// The mapped skeleton file kept by lazily loaded skeleton data is not counted as retained.
+	for (int lazy = 0; lazy <= 1; lazy++) {
+		SkeletonBinary binary(atlas);
+		binary.setLazyAnimations(lazy != 0);
+		const int iterations = 200;
+		size_t retained = 0, decoded = 0;
+		double loading = 0, decoding = 0;
+		for (int i = 0; i < iterations; i++) {
+			size_t used = counting.getUsed();
+			double start = nanoTime();
+			SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+			loading += nanoTime() - start;
+			assert(skeletonData);
+			retained = counting.getUsed() - used;
+			start = nanoTime();
+			skeletonData->findAnimation(animationName);
+			decoding += nanoTime() - start;
+			decoded = counting.getUsed() - used;
+			delete skeletonData;
+		}
+		printf("lazy animations, %s, %s: %.2f us/load, %zu bytes retained, %.2f us to find %s, %zu bytes retained "
+			   "after\n",
+			   skeletonFile, lazy ? "lazy" : "eager", loading / iterations / 1000, retained,
+			   decoding / iterations / 1000, animationName, decoded);
+	}
+
+	SpineExtension::setInstance(extension);
+	delete atlas;
+}
+
+void benchmarkParallelLoading(const char *atlasFile, const char *skeletonFile) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonBinary binary(atlas);
+	double sequential = 0;
+	size_t threadCounts[] = {1, 2, 4, 8};
+	for (int i = 0; i < 4; i++) {
+		binary.setThreadCount(threadCounts[i]);
+		const int iterations = 200;
+		double start = nanoTime();
+		for (int ii = 0; ii < iterations; ii++) {
+			SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+			assert(skeletonData);
+			delete skeletonData;
+		}
+		double time = (nanoTime() - start) / iterations;
+		if (i == 0) sequential = time;
+		printf("parallel loading, %s, %zu threads: %.2f us/load, %.2fx speedup (%u hardware threads)\n", skeletonFile,
+			   threadCounts[i], time / 1000, sequential / time, std::thread::hardware_concurrency());
+	}
+	delete atlas;
+}
+
+void benchmarkJsonLoading(const char *atlasFile, const char *skeletonFile) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	int length = 0;
+	char *json = SpineExtension::readFile(skeletonFile, &length);
+	assert(json);
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	SpineExtension::setInstance(&counting);
+
+	const int iterations = 100;
+	size_t allocations = counting.getAllocations();
+	double start = nanoTime();
+	for (int i = 0; i < iterations; i++) {
+		Json *root = new (__FILE__, __LINE__) Json(json);
+		delete root;
+	}
+	printf("json loading, %s, parse: %.2f us/load, %zu allocations/load\n", skeletonFile,
+		   (nanoTime() - start) / iterations / 1000, (counting.getAllocations() - allocations) / iterations);
+
+	SkeletonJson *reader = new (__FILE__, __LINE__) SkeletonJson(atlas);
+	allocations = counting.getAllocations();
+	start = nanoTime();
+	for (int i = 0; i < iterations; i++) {
+		SkeletonData *skeletonData = reader->readSkeletonData(json);
+		assert(skeletonData);
+		delete skeletonData;
+	}
+	printf("json loading, %s, readSkeletonData: %.2f us/load, %zu allocations/load\n", skeletonFile,
+		   (nanoTime() - start) / iterations / 1000, (counting.getAllocations() - allocations) / iterations);
+	delete reader;
+
+	SpineExtension::setInstance(extension);
+	SpineExtension::free(json, __FILE__, __LINE__);
+	delete atlas;
+}
+
+void benchmarkJsonWideObject(int width) {
+	// An object with many fields, like the bones or slots of an animation in a large skeleton, read field by field.
+	String json("{");
+	char field[32];
+	for (int i = 0; i < width; i++) {
+		sprintf(field, "\"field%d\": %d,", i, i);
+		json.append(field);
+	}
+	json.append("\"last\": 0}");
+	Json *root = new (__FILE__, __LINE__) Json(json.buffer());
+	assert(!root->getError());
+
+	const int iterations = 20;
+	int sum = 0;
+	double start = nanoTime();
+	for (int i = 0; i < iterations; i++) {
+		for (int ii = 0; ii < width; ii++) {
+			sprintf(field, "field%d", ii);
+			sum += Json::getInt(root, field, 0);
+		}
+	}
+	printf("json wide object, %d fields: %.2f ns/getItem (%d)\n", width,
+		   (nanoTime() - start) / iterations / width, sum);
+	delete root;
+}
+
+void benchmarkDeformTimeline(bool quantize) {
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	SpineExtension::setInstance(&counting);
+
+	// A face mesh with 1000 vertices where each of 300 frames moves the 100 vertices of a feature.
+	const size_t vertexCount = 1000 * 2, frameCount = 300, movedCount = 100 * 2;
+	MeshAttachment *mesh = new (__FILE__, __LINE__) MeshAttachment("face");
+	mesh->getVertices().setSize(vertexCount, 0);
+	for (size_t i = 0; i < vertexCount; i++)
+		mesh->getVertices()[i] = (float) (i % 97);
+	SkeletonData *skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	BoneData *boneData = new (__FILE__, __LINE__) BoneData(0, "root", NULL);
+	skeletonData->getBones().add(boneData);
+	skeletonData->getSlots().add(new (__FILE__, __LINE__) SlotData(0, "face", *boneData));
+
+	size_t used = counting.getUsed();
+	DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(frameCount, 0, 0, mesh);
+	{
+		Vector<float> vertices;
+		for (size_t frame = 0; frame < frameCount; frame++) {
+			vertices.clearAndAddAll(mesh->getVertices());
+			size_t start = frame % 8 * movedCount;
+			for (size_t i = start; i < start + movedCount; i++)
+				vertices[i] += (float) ((frame + i) % 13) * 0.5f;
+			timeline->setFrame((int) frame, frame / 30.0f, vertices);
+		}
+	}
+	if (quantize) timeline->quantize();
+	size_t retained = counting.getUsed() - used;
+
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	skeleton->getSlots()[0]->setAttachment(mesh);
+	const int iterations = 20000;
+	double start = nanoTime();
+	for (int i = 0; i < iterations; i++)
+		timeline->apply(*skeleton, 0, (i % 600) / 60.0f, NULL, 0.5f, MixBlend_Replace, MixDirection_In);
+	printf("deform timeline, %zu frames of %zu vertices, %s: %.2f us/apply, %zu bytes, %zu bytes as dense frames\n",
+		   frameCount, vertexCount / 2, quantize ? "quantized" : "float", (nanoTime() - start) / iterations / 1000,
+		   retained, frameCount * vertexCount * sizeof(float));
+
+	delete skeleton;
+	delete timeline;
+	delete skeletonData;
+	delete mesh;
+	SpineExtension::setInstance(extension);
+}
+
+/// Updates and renders 5000 skeletons for a frame with and without levels of detail. Most skeletons of a crowd are far from
+/// the camera: a tenth are near, a fifth at medium distance, the rest far or very far.
+void benchmarkSkeletonLod() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/spineboy/spineboy.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+
+	LodTier tiers[3];
+	tiers[0].minMetric = 1;
+	tiers[0].updateInterval = 2;
+	tiers[0].interpolate = true;
+	tiers[0].skippedConstraints = ConstraintType_Path;
+	tiers[1].minMetric = 2;
+	tiers[1].updateInterval = 4;
+	tiers[1].interpolate = true;
+	tiers[1].skippedConstraints = ConstraintType_Path | ConstraintType_Transform;
+	tiers[1].freezeDeform = true;
+	tiers[1].minSlotSize = 50;
+	tiers[2].minMetric = 3;
+	tiers[2].updateInterval = 8;
+	tiers[2].skippedConstraints = ConstraintType_Path | ConstraintType_Transform | ConstraintType_Ik;
+	tiers[2].freezeDeform = true;
+	tiers[2].minSlotSize = 100;
+
+	const int skeletonCount = 5000, frames = 32;
+	const char *animations[] = {"walk", "run", "idle", "shoot"};
+	Vector<SkeletonLod *> lods;
+	Vector<float> metrics;
+	for (int i = 0; i < skeletonCount; i++) {
+		Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+		state->setAnimation(0, animations[i % 4], true)->setTrackTime(i * 0.01f);
+		SkeletonLod *lod = new (__FILE__, __LINE__) SkeletonLod(*skeleton, *state);
+		for (int ii = 0; ii < 3; ii++)
+			lod->addTier(tiers[ii]);
+		lods.add(lod);
+		int percent = i * 37 % 100;
+		metrics.add(percent < 10 ? 0.0f : percent < 30 ? 1.0f : percent < 60 ? 2.0f : 3.0f);
+	}
+
+	SkeletonRenderer renderer;
+	for (int useLod = 0; useLod <= 1; useLod++) {
+		double updating = 0, rendering = 0;
+		size_t vertices = 0;
+		for (int frame = 0; frame < frames; frame++) {
+			for (int i = 0; i < skeletonCount; i++) {
+				SkeletonLod &lod = *lods[i];
+				double start = nanoTime();
+				lod.update(1 / 60.0f, useLod ? metrics[i] : 0);
+				updating += nanoTime() - start;
+				start = nanoTime();
+				renderer.setMinSlotSize(lod.getTier().minSlotSize);
+				renderer.render(lod.getSkeleton());
+				rendering += nanoTime() - start;
+				vertices += renderer.getVertices().size();
+			}
+		}
+		// Skeletons that aren't updated are cold when rendered, so only the total compares fairly.
+		printf("skeleton lod, %d spineboys, %s: %.2f ms/frame, %.2f updating, %.2f rendering, %zu vertices/frame\n",
+			   skeletonCount, useLod ? "10% near, 20% medium, 30% far, 40% very far" : "full detail",
+			   (updating + rendering) / frames / 1000000, updating / frames / 1000000, rendering / frames / 1000000,
+			   vertices / frames);
+	}
+
+	for (int i = 0; i < skeletonCount; i++) {
+		SkeletonLod *lod = lods[i];
+		delete &lod->getState();
+		delete &lod->getSkeleton();
+		delete lod;
+	}
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+/// Times updating the world transforms of a skeleton with path constraints while it is animated and while it holds a pose,
+/// with the cached world paths and with the caches reset before each update as if there were none.
+void benchmarkPathConstraint(const char *atlasFile, const char *skeletonFile, const char *animationName) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, animationName, true);
+	Vector<PathConstraint *> &constraints = skeleton->getPathConstraints();
+
+	const int iterations = 20000;
+	for (int animated = 1; animated >= 0; animated--) {
+		for (int cached = 1; cached >= 0; cached--) {
+			double elapsed = 0;
+			for (int i = 0; i < iterations; i++) {
+				if (animated) state->update(1 / 60.0f);
+				state->apply(*skeleton);
+				if (!cached) {
+					for (size_t ii = 0; ii < constraints.size(); ii++)
+						constraints[ii]->setTarget(constraints[ii]->getTarget());
+				}
+				double start = nanoTime();
+				skeleton->updateWorldTransform();
+				elapsed += nanoTime() - start;
+			}
+			printf("path constraint, %s, %zu paths, %s, %s: %.2f us/update\n", skeletonFile, constraints.size(),
+				   animated ? "animated" : "still", cached ? "cached" : "uncached", elapsed / iterations / 1000);
+		}
+	}
+
+	delete state;
+	delete skeleton;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+/// Times applying the attachment timelines of animations that switch attachments often, finding the attachments by key and,
+/// as before attachment keys, by name.
+void benchmarkAttachmentKeys() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+
+	Vector<AttachmentTimeline *> timelines;
+	const char *animations[] = {"dress-up", "blink"};
+	for (int i = 0; i < 2; i++) {
+		Vector<Timeline *> &animationTimelines = skeletonData->findAnimation(animations[i])->getTimelines();
+		for (size_t ii = 0; ii < animationTimelines.size(); ii++)
+			if (animationTimelines[ii]->getRTTI().isExactly(AttachmentTimeline::rtti))
+				timelines.add(static_cast<AttachmentTimeline *>(animationTimelines[ii]));
+	}
+
+	const int skeletonCount = 100, frames = 1000;
+	Vector<Skeleton *> skeletons;
+	for (int i = 0; i < skeletonCount; i++) {
+		Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		skeleton->setSkin(i % 2 ? "full-skins/girl" : "full-skins/boy");
+		skeletons.add(skeleton);
+	}
+
+	for (int keyed = 1; keyed >= 0; keyed--) {
+		if (!keyed) {
+			for (size_t i = 0; i < timelines.size(); i++) {
+				Vector<int> &keys = timelines[i]->getAttachmentKeys();
+				for (size_t ii = 0; ii < keys.size(); ii++)
+					keys[ii] = -1;
+			}
+		}
+		double start = nanoTime();
+		for (int frame = 0; frame < frames; frame++) {
+			float time = (frame % 300) / 60.0f;
+			for (int i = 0; i < skeletonCount; i++) {
+				for (size_t ii = 0; ii < timelines.size(); ii++)
+					timelines[ii]->apply(*skeletons[i], 0, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+			}
+		}
+		printf("attachment keys, %zu attachment timelines of dress-up and blink, %s: %.1f ns/apply\n", timelines.size(),
+			   keyed ? "by key" : "by name", (nanoTime() - start) / ((double) frames * skeletonCount * timelines.size()));
+	}
+
+	for (int i = 0; i < skeletonCount; i++)
+		delete skeletons[i];
+	delete skeletonData;
+	delete atlas;
+}
+
+/// Times changing the skins of mix-and-match skeletons to outfits composed at runtime, like an equipment system does, with
+/// few outfits that are worn again, with more outfits than update orders are kept, and without sharing update orders.
+void benchmarkSkinSwaps() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+
+	const char *parts[][4] = {{"skin-base", "skin-base", "skin-base", "skin-base"},
+							  {"clothes/dress-blue", "clothes/dress-green", "clothes/hoodie-blue-and-scarf", "clothes/hoodie-orange"},
+							  {"legs/boots-pink", "legs/boots-red", "legs/pants-green", "legs/pants-jeans"},
+							  {"hair/blue", "hair/brown", "hair/pink", "hair/short-red"},
+							  {"accessories/backpack", "accessories/bag", "accessories/cape-blue", "accessories/hat-red-yellow"}};
+	const int skeletonCount = 100, swaps = 20000;
+	Vector<Skeleton *> skeletons;
+	for (int i = 0; i < skeletonCount; i++)
+		skeletons.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+
+	for (int mode = 0; mode < 3; mode++) {
+		skeletonData->setShareUpdateOrders(mode < 2);
+		// 8 outfits or all 256 combinations of the parts.
+		int outfitCount = mode == 0 ? 8 : 256;
+		// The skin each skeleton wears, deleted when the skeleton changes to the next one.
+		Vector<Skin *> worn;
+		worn.setSize(skeletonCount, NULL);
+		double elapsed = 0;
+		for (int i = 0; i < swaps; i++) {
+			int outfit = (i * 37) % outfitCount;
+			Skin *skin = new (__FILE__, __LINE__) Skin("outfit");
+			skin->addSkin(skeletonData->findSkin(parts[0][0]));
+			for (int part = 1; part < 5; part++)
+				skin->addSkin(skeletonData->findSkin(parts[part][(outfit >> ((part - 1) * 2)) & 3]));
+			Skeleton *skeleton = skeletons[i % skeletonCount];
+			double start = nanoTime();
+			skeleton->setSkin(skin);
+			elapsed += nanoTime() - start;
+			delete worn[i % skeletonCount];
+			worn[i % skeletonCount] = skin;
+		}
+		printf("skin swaps, mix-and-match, %s: %.2f us/setSkin\n",
+			   mode == 0 ? "8 outfits, shared update orders" : mode == 1 ? "256 outfits, shared update orders" : "256 outfits, not shared",
+			   elapsed / swaps / 1000);
+		for (int i = 0; i < skeletonCount; i++) {
+			skeletons[i]->setSkin((Skin *) NULL);
+			delete worn[i];
+		}
+	}
+
+	for (int i = 0; i < skeletonCount; i++)
+		delete skeletons[i];
+	delete skeletonData;
+	delete atlas;
+}
+
+/// Accumulates the time and the allocations of the operations run between start() and stop().
+class Measurement {
+public:
+	explicit Measurement(CountingExtension &counting) : _counting(counting), _elapsed(0), _start(0), _operations(0),
+														 _allocations(0), _startAllocations(0) {
+	}
+
+	void start() {
+		_startAllocations = _counting.getAllocations();
+		_start = nanoTime();
+	}
+
+	void stop() {
+		_elapsed += nanoTime() - _start;
+		_allocations += _counting.getAllocations() - _startAllocations;
+		_operations++;
+	}
+
+	/// Prints a line of the suite's CSV output: benchmark, skeleton, ns/op, allocations/op.
+	void report(const char *benchmark, const char *skeleton) {
+		printf("%s,%s,%.1f,%.2f\n", benchmark, skeleton, _elapsed / _operations, (double) _allocations / _operations);
+	}
+
+private:
+	CountingExtension &_counting;
+	double _elapsed, _start;
+	size_t _operations, _allocations, _startAllocations;
+};
+
+/// Clips the attachments of the skeleton like a renderer does, computing world vertices only for clipped attachments.
+static void clipSkeleton(Skeleton &skeleton, SkeletonClipping &clipper, Vector<float> &worldVertices) {
+	static unsigned short quadIndices[] = {0, 1, 2, 2, 3, 0};
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0, n = drawOrder.size(); i < n; i++) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || !slot.getBone().isActive()) {
+			clipper.clipEnd(slot);
+			continue;
+		}
+		if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+			clipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+			continue;
+		}
+		if (clipper.isClipping()) {
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+				RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+				worldVertices.setSize(8, 0);
+				region->computeWorldVertices(slot.getBone(), worldVertices, 0, 2);
+				clipper.clipTriangles(worldVertices.buffer(), quadIndices, 6, region->getUVs().buffer(), 2);
+			} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+				worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+				mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices, 0, 2);
+				clipper.clipTriangles(worldVertices.buffer(), mesh->getTriangles().buffer(), mesh->getTriangles().size(),
+									  mesh->getUVs().buffer(), 2);
+			}
+		}
+		clipper.clipEnd(slot);
+	}
+	clipper.clipEnd();
+}
+
+/// Runs each measured operation of the suite on one example skeleton and reports it.
+static void runSuite(CountingExtension &counting, const char *name) {
+	String atlasFile = String("testdata/").append(name).append("/").append(name).append(".atlas");
+	String jsonFile = String("testdata/").append(name).append("/").append(name).append("-pro.json");
+	String binaryFile = String("testdata/").append(name).append("/").append(name).append("-pro.skel");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	int jsonLength = 0, binaryLength = 0;
+	char *json = SpineExtension::readFile(jsonFile, &jsonLength);
+	char *binary = SpineExtension::readFile(binaryFile, &binaryLength);
+	assert(json && binary);
+
+	const int loads = 20;
+	SkeletonJson *jsonReader = new (__FILE__, __LINE__) SkeletonJson(atlas);
+	Measurement loadJson(counting);
+	for (int i = 0; i < loads; i++) {
+		loadJson.start();
+		SkeletonData *skeletonData = jsonReader->readSkeletonData(json);
+		loadJson.stop();
+		assert(skeletonData);
+		delete skeletonData;
+	}
+	loadJson.report("loadJson", name);
+	delete jsonReader;
+
+	SkeletonBinary *binaryReader = new (__FILE__, __LINE__) SkeletonBinary(atlas);
+	Measurement loadBinary(counting);
+	for (int i = 0; i < loads; i++) {
+		loadBinary.start();
+		SkeletonData *skeletonData = binaryReader->readSkeletonData((unsigned char *) binary, binaryLength);
+		loadBinary.stop();
+		assert(skeletonData);
+		delete skeletonData;
+	}
+	loadBinary.report("loadBinary", name);
+	SkeletonData *skeletonData = binaryReader->readSkeletonData((unsigned char *) binary, binaryLength);
+	assert(skeletonData);
+	delete binaryReader;
+
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	// The first skin of skeletons with several skins is the empty default skin.
+	if (skeletonData->getSkins().size() > 1) skeleton->setSkin(skeletonData->getSkins()[1]);
+	skeleton->setSlotsToSetupPose();
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	stateData->setDefaultMix(0.25f);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+
+	SkeletonBounds *bounds = new (__FILE__, __LINE__) SkeletonBounds();
+	SkeletonClipping *clipper = new (__FILE__, __LINE__) SkeletonClipping();
+	SkeletonRenderer *renderer = new (__FILE__, __LINE__) SkeletonRenderer();
+	Vector<float> *worldVertices = new (__FILE__, __LINE__) Vector<float>();
+	Measurement apply(counting), updateWorldTransform(counting), skinning(counting), clipping(counting),
+			boundingBoxes(counting), skeletonBounds(counting), render(counting);
+	// The animations are switched every half second, so a quarter of the frames mix two animations.
+	const int frames = 2000;
+	for (int frame = 0; frame < frames; frame++) {
+		if (frame % 30 == 0) state->setAnimation(0, animations[frame / 30 % animations.size()], true);
+
+		apply.start();
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		apply.stop();
+
+		updateWorldTransform.start();
+		skeleton->updateWorldTransform();
+		updateWorldTransform.stop();
+
+		skinning.start();
+		for (size_t i = 0, n = skeleton->getSlots().size(); i < n; i++) {
+			Slot &slot = *skeleton->getSlots()[i];
+			Attachment *attachment = slot.getAttachment();
+			if (!attachment || !attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			worldVertices->setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), *worldVertices, 0, 2);
+		}
+		skinning.stop();
+
+		clipping.start();
+		clipSkeleton(*skeleton, *clipper, *worldVertices);
+		clipping.stop();
+
+		boundingBoxes.start();
+		bounds->update(*skeleton, true);
+		boundingBoxes.stop();
+
+		float x, y, width, height;
+		skeletonBounds.start();
+		skeleton->getBounds(x, y, width, height, *worldVertices);
+		skeletonBounds.stop();
+
+		render.start();
+		renderer->render(*skeleton);
+		render.stop();
+	}
+	apply.report("apply", name);
+	updateWorldTransform.report("updateWorldTransform", name);
+	skinning.report("skinning", name);
+	clipping.report("clipping", name);
+	boundingBoxes.report("boundingBoxes", name);
+	skeletonBounds.report("bounds", name);
+	render.report("render", name);
+
+	// Snapshots of the animated skeleton, and skeletons created in the same skin by copying it or from the data.
+	SkeletonPose *pose = new (__FILE__, __LINE__) SkeletonPose();
+	Measurement capturePose(counting), restorePose(counting), copySkeleton(counting), newSkeleton(counting);
+	for (int i = 0; i < 1000; i++) {
+		capturePose.start();
+		pose->capture(*skeleton);
+		capturePose.stop();
+		restorePose.start();
+		pose->restore(*skeleton);
+		restorePose.stop();
+	}
+	for (int i = 0; i < 100; i++) {
+		copySkeleton.start();
+		Skeleton *copy = skeleton->copy();
+		copySkeleton.stop();
+		delete copy;
+		newSkeleton.start();
+		copy = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		copy->setSkin(skeleton->getSkin());
+		newSkeleton.stop();
+		delete copy;
+	}
+	capturePose.report("capturePose", name);
+	restorePose.report("restorePose", name);
+	copySkeleton.report("copySkeleton", name);
+	newSkeleton.report("newSkeleton", name);
+
+	delete pose;
+	delete worldVertices;
+	delete renderer;
+	delete clipper;
+	delete bounds;
+	delete state;
+	delete stateData;
+	delete skeleton;
+	delete skeletonData;
+	SpineExtension::free(binary, __FILE__, __LINE__);
+	SpineExtension::free(json, __FILE__, __LINE__);
+	delete atlas;
+}
+
+/// Measures the hot paths on each example skeleton. The results are printed as CSV, one line per benchmark and skeleton
+/// with the nanoseconds and allocations per operation, so they can be tracked over time.
+void benchmarkSuite() {
+	SpineExtension *extension = SpineExtension::getInstance();
+	CountingExtension counting;
+	SpineExtension::setInstance(&counting);
+
+	printf("benchmark,skeleton,ns/op,allocations/op\n");
+	const char *skeletons[] = {"spineboy", "raptor", "goblins", "tank", "stretchyman", "coin", "owl"};
+	for (size_t i = 0; i < sizeof(skeletons) / sizeof(skeletons[0]); i++)
+		runSuite(counting, skeletons[i]);
+
+	SpineExtension::setInstance(extension);
+}
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		return new DefaultSpineExtension();
+	}
+}// namespace spine
+
+/// Benchmarks run if no names are given on the command line, or if their name contains one of the given names.
+static bool shouldRun(int argc, char **argv, const char *benchmark) {
+	if (argc < 2) return true;
+	for (int i = 1; i < argc; i++)
+		if (strstr(benchmark, argv[i])) return true;
+	return false;
+}
+
+int main(int argc, char **argv) {
+	if (shouldRun(argc, argv, "keyframeSearch")) benchmarkKeyframeSearch();
+	if (shouldRun(argc, argv, "updateWorldTransform")) {
+		benchmarkUpdateWorldTransform(false);
+		benchmarkUpdateWorldTransform(true);
+	}
+	if (shouldRun(argc, argv, "trig")) benchmarkTrig();
+	if (shouldRun(argc, argv, "weightedVertices")) {
+		benchmarkWeightedVertices("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel", "walk");
+		benchmarkWeightedVertices("testdata/stretchyman/stretchyman.atlas", "testdata/stretchyman/stretchyman-pro.skel",
+								  "sneak");
+	}
+	if (shouldRun(argc, argv, "skeletonRenderer")) {
+		benchmarkSkeletonRenderer("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel", "walk");
+		benchmarkSkeletonRenderer("testdata/tank/tank.atlas", "testdata/tank/tank-pro.skel", "drive");
+	}
+	if (shouldRun(argc, argv, "animationBaker")) {
+		benchmarkAnimationBaker("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel", "walk");
+		benchmarkAnimationBaker("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.skel", "run");
+	}
+	if (shouldRun(argc, argv, "skeletonUpdateBatch")) benchmarkSkeletonUpdateBatch();
+	if (shouldRun(argc, argv, "animationsChanged")) benchmarkAnimationsChanged();
+	if (shouldRun(argc, argv, "layeredApply")) benchmarkLayeredApply();
+	if (shouldRun(argc, argv, "binaryLoading")) {
+		benchmarkBinaryLoading("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.skel");
+		benchmarkBinaryLoading("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel");
+		benchmarkBinaryLoading("testdata/stretchyman/stretchyman.atlas", "testdata/stretchyman/stretchyman-pro.skel");
+	}
+	if (shouldRun(argc, argv, "arena")) {
+		benchmarkArena("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.skel");
+		benchmarkArena("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel");
+	}
+	if (shouldRun(argc, argv, "lazyAnimations")) {
+		benchmarkLazyAnimations("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.skel", "run");
+		benchmarkLazyAnimations("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel", "walk");
+	}
+	if (shouldRun(argc, argv, "parallelLoading")) {
+		benchmarkParallelLoading("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.skel");
+		benchmarkParallelLoading("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.skel");
+		benchmarkParallelLoading("testdata/tank/tank.atlas", "testdata/tank/tank-pro.skel");
+	}
+	if (shouldRun(argc, argv, "deformTimeline")) {
+		benchmarkDeformTimeline(false);
+		benchmarkDeformTimeline(true);
+	}
+	if (shouldRun(argc, argv, "jsonLoading")) {
+		benchmarkJsonLoading("testdata/spineboy/spineboy.atlas", "testdata/spineboy/spineboy-pro.json");
+		benchmarkJsonLoading("testdata/raptor/raptor.atlas", "testdata/raptor/raptor-pro.json");
+		benchmarkJsonLoading("testdata/tank/tank.atlas", "testdata/tank/tank-pro.json");
+		benchmarkJsonWideObject(16);
+		benchmarkJsonWideObject(1000);
+		benchmarkJsonWideObject(10000);
+	}
+	if (shouldRun(argc, argv, "skeletonLod")) benchmarkSkeletonLod();
+	if (shouldRun(argc, argv, "pathConstraint")) {
+		benchmarkPathConstraint("testdata/vine/vine.atlas", "testdata/vine/vine-pro.skel", "grow");
+		benchmarkPathConstraint("testdata/stretchyman/stretchyman.atlas", "testdata/stretchyman/stretchyman-pro.skel",
+								"sneak");
+	}
+	if (shouldRun(argc, argv, "attachmentKeys")) benchmarkAttachmentKeys();
+	if (shouldRun(argc, argv, "skinSwaps")) benchmarkSkinSwaps();
+	if (shouldRun(argc, argv, "suite")) benchmarkSuite();
+}
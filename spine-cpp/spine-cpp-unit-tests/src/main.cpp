@@ -1,6 +1,9 @@
 #include <spine/Debug.h>
 #include <spine/spine.h>
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
+#include <thread>
 
 #ifdef MSVC
 #pragma warning(disable : 4710)
@@ -98,19 +101,1987 @@ void testLoading() {
 	}
 }
 
+void testTimelineSearch() {
+	printf("Testing timeline keyframe search\n");
+	const size_t frameCount = 257;
+	RotateTimeline rotate(frameCount, 0, 0);
+	TranslateTimeline translate(frameCount, 0, 0);
+	for (size_t i = 0; i < frameCount; i++) {
+		rotate.setFrame(i, (float) i, (float) i * 2);
+		translate.setFrame(i, (float) i, (float) i, (float) i * -3);
+	}
+
+	// Exact keys, in between keys and past the last key.
+	for (size_t i = 0; i < frameCount - 1; i++) {
+		assert(MathUtil::abs(rotate.getCurveValue((float) i) - i * 2) < 0.0001f);
+		assert(MathUtil::abs(rotate.getCurveValue(i + 0.25f) - (i + 0.25f) * 2) < 0.0001f);
+	}
+	assert(rotate.getCurveValue(frameCount + 10.0f) == (frameCount - 1) * 2);
+
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/coin/coin.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/coin/coin-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	Bone *bone = skeleton->getBones()[0];
+	for (size_t i = 0; i < frameCount - 1; i++) {
+		float time = i + 0.5f;
+		translate.apply(*skeleton, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+		assert(MathUtil::abs(bone->getX() - (bone->getData().getX() + time)) < 0.0001f);
+		assert(MathUtil::abs(bone->getY() - (bone->getData().getY() - time * 3)) < 0.0001f);
+	}
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+void testBatchUpdate() {
+	printf("Testing batch update\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, "walk", true);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	Skeleton *batched = new (__FILE__, __LINE__) Skeleton(skeletonData, true);
+	assert(!skeleton->getBatchUpdate());
+	assert(batched->getBatchUpdate());
+
+	size_t boneCount = skeletonData->getBones().size();
+	for (int frame = 0; frame < 30; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		state->apply(*batched);
+		skeleton->updateWorldTransform();
+		batched->updateWorldTransform();
+		for (size_t i = 0; i < boneCount; i++) {
+			Bone *expected = skeleton->getBones()[i], *actual = batched->getBones()[i];
+			assert(expected->getA() == actual->getA() && expected->getB() == actual->getB());
+			assert(expected->getC() == actual->getC() && expected->getD() == actual->getD());
+			assert(expected->getWorldX() == actual->getWorldX() && expected->getWorldY() == actual->getWorldY());
+		}
+	}
+
+	delete batched;
+	delete skeleton;
+	delete state;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
 namespace spine {
 	SpineExtension *getDefaultExtension() {
 		return new DefaultSpineExtension();
 	}
 }// namespace spine
 
+/// Skins the vertices of a weighted attachment one influence at a time, as the reference for computeWorldVertices.
+static void computeWeightedReference(Slot &slot, VertexAttachment &attachment, size_t start, size_t count,
+									 Vector<float> &worldVertices) {
+	Vector<size_t> &bones = attachment.getBones();
+	Vector<float> &vertices = attachment.getVertices();
+	Vector<float> &deform = slot.getDeform();
+	worldVertices.setSize(count, 0);
+	size_t v = 0, b = 0;
+	for (size_t i = 0; i < start; i += 2) {
+		b += bones[v];
+		v += bones[v] + 1;
+	}
+	for (size_t w = 0; w < count; w += 2) {
+		float wx = 0, wy = 0;
+		for (size_t n = bones[v++]; n > 0; n--, v++, b++) {
+			Bone &bone = *slot.getSkeleton().getBones()[bones[v]];
+			float vx = vertices[b * 3], vy = vertices[b * 3 + 1], weight = vertices[b * 3 + 2];
+			if (deform.size() > 0) {
+				vx += deform[b * 2];
+				vy += deform[b * 2 + 1];
+			}
+			wx += (vx * bone.getA() + vy * bone.getB() + bone.getWorldX()) * weight;
+			wy += (vx * bone.getC() + vy * bone.getD() + bone.getWorldY()) * weight;
+		}
+		worldVertices[w] = wx;
+		worldVertices[w + 1] = wy;
+	}
+}
+
+void testWeightedVertices() {
+	printf("Testing weighted vertices\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, "walk", true);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	state->update(0.3f);
+	state->apply(*skeleton);
+	skeleton->updateWorldTransform();
+
+	int tested = 0;
+	Vector<float> expected, actual;
+	for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+		Slot &slot = *skeleton->getSlots()[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || !attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+		VertexAttachment &mesh = *static_cast<VertexAttachment *>(attachment);
+		if (mesh.getBones().size() == 0) continue;
+		size_t length = mesh.getWorldVerticesLength();
+
+		// Full range, a range starting on a block of 4 vertices, and a range that doesn't.
+		Vector<float> savedDeform;
+		savedDeform.addAll(slot.getDeform());
+		for (int withDeform = 0; withDeform < 2; withDeform++) {
+			if (withDeform) {
+				slot.getDeform().setSize(mesh.getVertices().size() / 3 * 2, 0);
+				for (size_t ii = 0; ii < slot.getDeform().size(); ii++)
+					slot.getDeform()[ii] = (float) (ii % 7) - 3.5f;
+			}
+			size_t starts[] = {0, length > 16 ? (size_t) 16 : 0, length > 2 ? (size_t) 2 : 0};
+			for (int s = 0; s < 3; s++) {
+				size_t count = length - starts[s];
+				computeWeightedReference(slot, mesh, starts[s], count, expected);
+				actual.setSize(count + 2, 0);
+				mesh.computeWorldVertices(slot, starts[s], count, actual.buffer(), 2, 2);
+				for (size_t ii = 0; ii < count; ii++)
+					assert(expected[ii] == actual[ii + 2]);
+			}
+		}
+		slot.getDeform().clearAndAddAll(savedDeform);
+
+		// A bone with non-finite values only affects the vertices it influences.
+		Bone &infinite = *skeleton->getBones()[mesh.getBones()[1]];
+		infinite.setA(INFINITY);
+		infinite.setWorldX(INFINITY);
+		computeWeightedReference(slot, mesh, 0, length, expected);
+		actual.setSize(length, 0);
+		mesh.computeWorldVertices(slot, 0, length, actual.buffer(), 0, 2);
+		for (size_t ii = 0; ii < length; ii++) {
+			if (expected[ii] == expected[ii]) assert(expected[ii] == actual[ii]);
+		}
+		skeleton->updateWorldTransform();
+		tested++;
+	}
+	assert(tested > 0);
+
+	delete skeleton;
+	delete state;
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+void testSkeletonUpdateBatch() {
+	printf("Testing skeleton update batch\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(skeletonData);
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	stateData->setDefaultMix(0.2f);
+
+	// Pairs updated by the batch on 4 threads are compared to pairs updated one after the other.
+	const int count = 24;
+	SkeletonUpdateBatch batch(4);
+	assert(batch.getThreadCount() == 4);
+	Vector<Skeleton *> skeletons, expectedSkeletons;
+	Vector<AnimationState *> states, expectedStates;
+	for (int i = 0; i < count * 2; i++) {
+		Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+		AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+		state->setAnimation(0, "walk", true)->setTrackTime((i % count) * 0.1f);
+		if (i % 2) state->addAnimation(0, "roar", false, 0.5f);
+		(i < count ? skeletons : expectedSkeletons).add(skeleton);
+		(i < count ? states : expectedStates).add(state);
+		if (i < count) batch.add(*skeleton, *state);
+	}
+	assert(batch.size() == count);
+
+	for (int frame = 0; frame < 30; frame++) {
+		batch.update(1 / 30.0f);
+		for (int i = 0; i < count; i++) {
+			expectedStates[i]->update(1 / 30.0f);
+			expectedStates[i]->apply(*expectedSkeletons[i]);
+			expectedSkeletons[i]->updateWorldTransform();
+			for (size_t ii = 0; ii < skeletonData->getBones().size(); ii++) {
+				Bone *expected = expectedSkeletons[i]->getBones()[ii], *actual = skeletons[i]->getBones()[ii];
+				assert(expected->getA() == actual->getA() && expected->getD() == actual->getD());
+				assert(expected->getWorldX() == actual->getWorldX() && expected->getWorldY() == actual->getWorldY());
+			}
+		}
+	}
+
+	batch.clear();
+	assert(batch.size() == 0);
+	for (int i = 0; i < count; i++) {
+		delete skeletons[i];
+		delete states[i];
+		delete expectedSkeletons[i];
+		delete expectedStates[i];
+	}
+	delete stateData;
+	delete skeletonData;
+	delete atlas;
+}
+
+template<typename T>
+static void checkFindWithName(Vector<T *> &items, T *(SkeletonData::*find)(const String &), SkeletonData *skeletonData) {
+	for (size_t i = 0; i < items.size(); i++)
+		assert((skeletonData->*find)(items[i]->getName()) == ContainerUtil::findWithName(items, items[i]->getName()));
+	assert((skeletonData->*find)("not a name") == NULL);
+}
+
+void testNameLookup() {
+	printf("Testing name lookup\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadJson("testdata/spineboy/spineboy-pro.json", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData,
+			 skeleton, state);
+
+	checkFindWithName(skeletonData->getBones(), &SkeletonData::findBone, skeletonData);
+	checkFindWithName(skeletonData->getSlots(), &SkeletonData::findSlot, skeletonData);
+	checkFindWithName(skeletonData->getSkins(), &SkeletonData::findSkin, skeletonData);
+	checkFindWithName(skeletonData->getAnimations(), &SkeletonData::findAnimation, skeletonData);
+	checkFindWithName(skeletonData->getIkConstraints(), &SkeletonData::findIkConstraint, skeletonData);
+	checkFindWithName(skeletonData->getTransformConstraints(), &SkeletonData::findTransformConstraint, skeletonData);
+	checkFindWithName(skeletonData->getPathConstraints(), &SkeletonData::findPathConstraint, skeletonData);
+	for (size_t i = 0; i < skeletonData->getEvents().size(); i++) {
+		EventData *event = skeletonData->getEvents()[i];
+		assert(skeletonData->findEvent(event->getName()) == event);
+	}
+
+	for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+		Bone *bone = skeleton->getBones()[i];
+		assert(skeleton->findBone(bone->getData().getName()) == bone);
+	}
+	for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+		Slot *slot = skeleton->getSlots()[i];
+		assert(skeleton->findSlot(slot->getData().getName()) == slot);
+	}
+	for (size_t i = 0; i < skeleton->getIkConstraints().size(); i++) {
+		IkConstraint *constraint = skeleton->getIkConstraints()[i];
+		assert(skeleton->findIkConstraint(constraint->getData().getName()) == constraint);
+	}
+	assert(skeleton->findBone("not a name") == NULL);
+	assert(skeleton->findSlot("not a name") == NULL);
+
+	// Regions with the same name and different indices resolve to the first one.
+	for (size_t i = 0; i < atlas->getRegions().size(); i++) {
+		AtlasRegion *region = atlas->getRegions()[i];
+		AtlasRegion *first = NULL;
+		for (size_t ii = 0; ii < atlas->getRegions().size() && !first; ii++)
+			if (atlas->getRegions()[ii]->name == region->name) first = atlas->getRegions()[ii];
+		assert(atlas->findRegion(region->name) == first);
+	}
+	assert(atlas->findRegion("not a name") == NULL);
+
+	// Items added, replaced or removed after loading are found once the indexes are rebuilt. A replaced item is never
+	// returned for the name of the item it replaced, even before.
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	Animation *animation = animations[0];
+	Vector<Timeline *> timelines;
+	Animation *added = new (__FILE__, __LINE__) Animation("added", timelines, 1);
+	animations.add(added);
+	skeletonData->rebuildNameIndexes();
+	assert(skeletonData->findAnimation("added") == added);
+	assert(skeletonData->findAnimation(animation->getName()) == animation);
+	Animation *replaced = new (__FILE__, __LINE__) Animation("replaced", timelines, 1);
+	animations[0] = replaced;
+	skeletonData->rebuildNameIndexes();
+	assert(skeletonData->findAnimation("replaced") == replaced);
+	assert(skeletonData->findAnimation(animation->getName()) == NULL);
+	animations[0] = animation;
+	delete replaced;
+	animations.removeAt(animations.size() - 1);
+	skeletonData->rebuildNameIndexes();
+	assert(skeletonData->findAnimation("added") == NULL);
+	assert(skeletonData->findAnimation(animation->getName()) == animation);
+	delete added;
+
+	Vector<AtlasRegion *> &regions = atlas->getRegions();
+	AtlasRegion *region = regions[0];
+	regions.removeAt(0);
+	atlas->rebuildRegionIndex();
+	assert(atlas->findRegion(region->name) != region);
+	regions.add(region);
+	atlas->rebuildRegionIndex();
+	assert(atlas->findRegion(region->name) != NULL);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testHashMap() {
+	printf("Testing hash map\n");
+	HashMap<PropertyId, int> map;
+	const int count = 1000;
+	for (int i = 0; i < count; i++)
+		map.put(((PropertyId) (i % 20) << 32) + i / 20, i);
+	assert(map.size() == count);
+	map.put(0, -1);
+	assert(map.size() == count);
+	assert(map[0] == -1);
+
+	// Removing entries must keep the remaining entries reachable.
+	for (int i = 0; i < count; i += 2)
+		assert(map.remove(((PropertyId) (i % 20) << 32) + i / 20));
+	assert(!map.remove(0));
+	assert(map.size() == count / 2);
+	for (int i = 0; i < count; i++) {
+		PropertyId key = ((PropertyId) (i % 20) << 32) + i / 20;
+		assert(map.containsKey(key) == (i % 2 == 1));
+		if (i % 2 == 1) assert(map[key] == i);
+	}
+
+	int entries = 0;
+	HashMap<PropertyId, int>::Entries iterator = map.getEntries();
+	while (iterator.hasNext()) {
+		HashMap<PropertyId, int>::Pair pair = iterator.next();
+		assert(pair.value % 2 == 1);
+		entries++;
+	}
+	assert(entries == count / 2);
+
+	map.clear();
+	assert(map.size() == 0 && !map.containsKey(1));
+	Vector<PropertyId> keys;
+	keys.add(1);
+	keys.add(2);
+	assert(map.addAll(keys, 7));
+	assert(!map.addAll(keys, 7));
+
+	HashMap<String, int> strings;
+	strings.put("bone", 1);
+	strings.put("slot", 2);
+	strings.put(String("bone"), 3);
+	assert(strings.size() == 2);
+	assert(strings["bone"] == 3 && strings["slot"] == 2);
+	assert(!strings.containsKey("skin"));
+}
+
+void testBinaryLoading() {
+	printf("Testing binary loading\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *mapped = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+	assert(mapped);
+	int length = 0;
+	char *data = SpineExtension::readFile("testdata/raptor/raptor-pro.skel", &length);
+	SkeletonData *read = binary.readSkeletonData((unsigned char *) data, length);
+	SpineExtension::free(data, __FILE__, __LINE__);
+	assert(read);
+
+	assert(mapped->getBones().size() == read->getBones().size());
+	assert(mapped->getAnimations().size() == read->getAnimations().size());
+	for (size_t i = 0; i < mapped->getAnimations().size(); i++) {
+		Vector<Timeline *> &mappedTimelines = mapped->getAnimations()[i]->getTimelines();
+		Vector<Timeline *> &readTimelines = read->getAnimations()[i]->getTimelines();
+		assert(mappedTimelines.size() == readTimelines.size());
+		for (size_t ii = 0; ii < mappedTimelines.size(); ii++) {
+			assert(mappedTimelines[ii]->getFrames() == readTimelines[ii]->getFrames());
+			if (!mappedTimelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *mappedDeform = static_cast<DeformTimeline *>(mappedTimelines[ii]);
+			DeformTimeline *readDeform = static_cast<DeformTimeline *>(readTimelines[ii]);
+			Vector<float> mappedVertices, readVertices;
+			for (size_t frame = 0; frame < mappedDeform->getFrameCount(); frame++) {
+				mappedDeform->getFrameVertices(frame, mappedVertices);
+				readDeform->getFrameVertices(frame, readVertices);
+				assert(mappedVertices == readVertices);
+			}
+		}
+	}
+
+	assert(binary.readSkeletonDataFile("testdata/raptor/missing.skel") == NULL);
+	assert(!binary.getError().isEmpty());
+
+	delete read;
+	delete mapped;
+	delete atlas;
+}
+
+void testArena() {
+	printf("Testing arena\n");
+	// Everything allocated while the arena extension is installed is freed before it's uninstalled.
+	SpineExtension *extension = SpineExtension::getInstance();
+	ArenaExtension arenaExtension(extension);
+	SpineExtension::setInstance(&arenaExtension);
+	{
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/raptor/raptor.atlas", NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *heapData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+		binary.setUseArena(true);
+		SkeletonData *arenaData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+		assert(heapData && arenaData);
+		assert(heapData->getArena() == NULL && arenaData->getArena() != NULL);
+		Arena *arena = arenaData->getArena();
+		assert(arena->getUsedMemory() > 0 && arena->getUsedMemory() <= arena->getReservedMemory());
+		assert(arena->getBlockCount() < 16);
+
+		// Skeletons of data in an arena get an arena of their own, and pose the same as others.
+		Skeleton *heapSkeleton = new (__FILE__, __LINE__) Skeleton(heapData);
+		Skeleton *arenaSkeleton = new (__FILE__, __LINE__) Skeleton(arenaData);
+		heapData->findAnimation("walk")->apply(*heapSkeleton, 0, 0.5f, true, NULL, 1, MixBlend_Setup,
+												 MixDirection_In);
+		arenaData->findAnimation("walk")->apply(*arenaSkeleton, 0, 0.5f, true, NULL, 1, MixBlend_Setup,
+												  MixDirection_In);
+		heapSkeleton->updateWorldTransform();
+		arenaSkeleton->updateWorldTransform();
+		for (size_t i = 0; i < heapSkeleton->getBones().size(); i++) {
+			assert(heapSkeleton->getBones()[i]->getWorldX() == arenaSkeleton->getBones()[i]->getWorldX());
+			assert(heapSkeleton->getBones()[i]->getWorldY() == arenaSkeleton->getBones()[i]->getWorldY());
+		}
+		// Memory of an arena grown outside of its scope moves to the heap.
+		arenaSkeleton->getSlots()[0]->getDeform().setSize(1000, 0);
+		delete arenaSkeleton;
+		delete heapSkeleton;
+
+		// Lazily decoded animations of data in an arena live on the heap, so they can be evicted.
+		binary.setLazyAnimations(true);
+		SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/raptor/raptor-pro.skel");
+		assert(lazyData && lazyData->getArena());
+		Animation *walk = lazyData->findAnimation("walk");
+		assert(walk->getTimelines().size() == arenaData->findAnimation("walk")->getTimelines().size());
+		lazyData->evictAnimation(walk);
+		lazyData->prefetchAnimation(walk);
+		assert(lazyData->isAnimationDecoded(walk));
+		delete lazyData;
+
+		// The loader and its error outlive the arena of skeleton data that failed to load.
+		SkeletonJson json(atlas);
+		json.setUseArena(true);
+		assert(!json.readSkeletonData("{\"bones\":[{\"name\":\"root\"}],\"slots\":[{\"name\":\"a\",\"bone\":\"b\"}]}"));
+		assert(json.getError() == "Slot bone not found: b");
+		SkeletonData *jsonData = json.readSkeletonDataFile("testdata/raptor/raptor-pro.json");
+		assert(jsonData && jsonData->getArena());
+		assert(jsonData->getAnimations().size() == arenaData->getAnimations().size());
+
+		delete jsonData;
+		delete arenaData;
+		delete heapData;
+		delete atlas;
+	}
+	SpineExtension::setInstance(extension);
+}
+
+void testTrig() {
+	printf("Testing trig\n");
+#ifdef SPINE_FAST_TRIG
+	const double degreesError = 1e-7;
+#else
+	// Converting the degrees to float radians loses precision for large angles.
+	const double degreesError = 2e-6;
+#endif
+	double maxError = 0, maxDegreesError = 0;
+	for (float degrees = -1000; degrees < 1000; degrees += 0.0037f) {
+		double radians = degrees * 3.14159265358979323846 / 180;
+		float sine, cosine;
+		MathUtil::sincosDeg(degrees, sine, cosine);
+		assert(sine == MathUtil::sinDeg(degrees) && cosine == MathUtil::cosDeg(degrees));
+		maxDegreesError = fmax(maxDegreesError, fmax(fabs(sine - sin(radians)), fabs(cosine - cos(radians))));
+
+		float r = degrees * 0.05f;
+		MathUtil::sincos(r, sine, cosine);
+		assert(sine == MathUtil::sin(r) && cosine == MathUtil::cos(r));
+		maxError = fmax(maxError, fmax(fabs(sine - sin((double) r)), fabs(cosine - cos((double) r))));
+	}
+	assert(maxDegreesError < degreesError);
+	assert(maxError < 1e-7);
+
+#ifdef SPINE_FAST_TRIG
+	// Large angles are reduced exactly, up to the C library fallback at 1e8 degrees.
+	maxDegreesError = 0;
+	const float largeDegrees[] = {33554432, 67124704, 99999992};
+	for (int i = 0; i < 3; i++) {
+		float end = fminf(largeDegrees[i] + 4096, 1e8f);
+		for (float degrees = largeDegrees[i] - 4096; degrees < end; degrees = nextafterf(degrees, end)) {
+			double radians = fmod((double) degrees, 360) * 3.14159265358979323846 / 180;
+			float sine, cosine;
+			MathUtil::sincosDeg(degrees, sine, cosine);
+			maxDegreesError = fmax(maxDegreesError, fmax(fabs(sine - sin(radians)), fabs(cosine - cos(radians))));
+			maxDegreesError = fmax(maxDegreesError, fmax(fabs(MathUtil::sinDeg(-degrees) + sin(radians)),
+															fabs(MathUtil::cosDeg(-degrees) - cos(radians))));
+		}
+	}
+	assert(maxDegreesError < degreesError);
+#endif
+
+	maxError = 0;
+	const float radii[] = {0.001f, 1, 1000};
+	for (float angle = -3.2f; angle < 3.2f; angle += 0.0001f) {
+		for (int i = 0; i < 3; i++) {
+			float x = radii[i] * (float) cos(angle), y = radii[i] * (float) sin(angle);
+			maxError = fmax(maxError, fabs(MathUtil::atan2(y, x) - atan2((double) y, (double) x)));
+		}
+	}
+	assert(maxError < 3e-7);
+	assert(MathUtil::atan2(0, -1) == MathUtil::Pi && MathUtil::atan2(0, 0) == 0);
+	float nan = MathUtil::sinDeg(NAN);
+	assert(nan != nan);
+}
+
+/// Checks that the commands cover the vertex and index buffers in order and only merge different textures or blend modes.
+static void checkRenderCommands(SkeletonRenderer &renderer) {
+	Vector<RenderCommand> &commands = renderer.getCommands();
+	size_t vertexStart = 0, indexStart = 0;
+	for (size_t i = 0; i < commands.size(); i++) {
+		RenderCommand &command = commands[i];
+		assert(command.vertexStart == vertexStart && command.indexStart == indexStart);
+		assert(command.vertexCount > 0 && command.indexCount % 3 == 0);
+		for (size_t ii = 0; ii < command.indexCount; ii++)
+			assert(renderer.getIndices()[command.indexStart + ii] < command.vertexCount);
+		if (i > 0)
+			assert(commands[i - 1].texture != command.texture || commands[i - 1].blendMode != command.blendMode);
+		vertexStart += command.vertexCount;
+		indexStart += command.indexCount;
+	}
+	assert(vertexStart == renderer.getVertices().size() && indexStart == renderer.getIndices().size());
+}
+
+void testSkeletonRenderer() {
+	printf("Testing skeleton renderer\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", atlas, skeletonData, stateData,
+			   skeleton, state);
+	skeleton->updateWorldTransform();
+
+	SkeletonRenderer renderer;
+	renderer.render(*skeleton);
+	checkRenderCommands(renderer);
+
+	// Without clipping, every visible attachment adds its vertices in draw order.
+	size_t vertexCount = 0;
+	Vector<float> worldVertices;
+	for (size_t i = 0; i < skeleton->getDrawOrder().size(); i++) {
+		Slot &slot = *skeleton->getDrawOrder()[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0) continue;
+		Vector<float> *uvs;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			worldVertices.setSize(8, 0);
+			region->computeWorldVertices(slot.getBone(), worldVertices, 0, 2);
+			uvs = &region->getUVs();
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, worldVertices);
+			uvs = &mesh->getUVs();
+		} else
+			continue;
+		for (size_t ii = 0; ii < worldVertices.size() >> 1; ii++) {
+			RenderVertex &vertex = renderer.getVertices()[vertexCount + ii];
+			assert(vertex.x == worldVertices[ii << 1] && vertex.y == worldVertices[(ii << 1) + 1]);
+			assert(vertex.u == (*uvs)[ii << 1] && vertex.v == (*uvs)[(ii << 1) + 1]);
+			assert(vertex.darkColor == 0);
+		}
+		vertexCount += worldVertices.size() >> 1;
+	}
+	assert(vertexCount == renderer.getVertices().size());
+	// Raptor has a single atlas page and only normal blending.
+	assert(renderer.getCommands().size() == 1);
+
+	// Rendering again reuses the buffers.
+	RenderVertex *vertices = renderer.getVertices().buffer();
+	unsigned short *indices = renderer.getIndices().buffer();
+	renderer.render(*skeleton);
+	assert(renderer.getVertices().buffer() == vertices && renderer.getIndices().buffer() == indices);
+
+	// Channels outside [0, 1] are clamped instead of overflowing into the neighboring channel.
+	skeleton->getColor().r = 2;
+	skeleton->getColor().g = 1.5f;
+	skeleton->getColor().b = -1;
+	renderer.render(*skeleton);
+	vertexCount = 0;
+	for (size_t i = 0; i < skeleton->getDrawOrder().size(); i++) {
+		Slot &slot = *skeleton->getDrawOrder()[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0) continue;
+		Color *color;
+		size_t count;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			color = &static_cast<RegionAttachment *>(attachment)->getColor();
+			count = 4;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			color = &static_cast<MeshAttachment *>(attachment)->getColor();
+			count = static_cast<MeshAttachment *>(attachment)->getWorldVerticesLength() >> 1;
+		} else
+			continue;
+		float r = MathUtil::clamp(2 * slot.getColor().r * color->r, 0, 1);
+		float g = MathUtil::clamp(1.5f * slot.getColor().g * color->g, 0, 1);
+		float a = MathUtil::clamp(slot.getColor().a * color->a, 0, 1);
+		unsigned int packed = ((unsigned int) (a * 255) << 24) | ((unsigned int) (r * 255) << 16) |
+							  ((unsigned int) (g * 255) << 8);
+		for (size_t ii = 0; ii < count; ii++)
+			assert(renderer.getVertices()[vertexCount + ii].color == packed);
+		vertexCount += count;
+	}
+	assert(vertexCount == renderer.getVertices().size());
+	skeleton->getColor().set(1, 1, 1, 1);
+
+	skeleton->getColor().a = 0;
+	renderer.render(*skeleton);
+	assert(renderer.getCommands().size() == 0 && renderer.getVertices().size() == 0);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+
+	loadBinary("testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas", atlas, skeletonData, stateData, skeleton,
+			   state);
+	skeleton->updateWorldTransform();
+	renderer.render(*skeleton);
+	checkRenderCommands(renderer);
+	assert(renderer.getCommands().size() > 0);
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+static void checkBakedPose(Skeleton &live, Skeleton &baked) {
+	for (size_t i = 0; i < live.getBones().size(); i++) {
+		Bone &liveBone = *live.getBones()[i], &bakedBone = *baked.getBones()[i];
+		assert(MathUtil::abs(liveBone.getA() - bakedBone.getA()) < 0.0001f);
+		assert(MathUtil::abs(liveBone.getB() - bakedBone.getB()) < 0.0001f);
+		assert(MathUtil::abs(liveBone.getC() - bakedBone.getC()) < 0.0001f);
+		assert(MathUtil::abs(liveBone.getD() - bakedBone.getD()) < 0.0001f);
+		assert(MathUtil::abs(liveBone.getWorldX() - bakedBone.getWorldX()) < 0.01f);
+		assert(MathUtil::abs(liveBone.getWorldY() - bakedBone.getWorldY()) < 0.01f);
+	}
+	for (size_t i = 0; i < live.getSlots().size(); i++) {
+		Slot &liveSlot = *live.getSlots()[i], &bakedSlot = *baked.getSlots()[i];
+		assert(liveSlot.getAttachment() == bakedSlot.getAttachment());
+		// Colors are baked with 8 bits per channel.
+		assert(MathUtil::abs(liveSlot.getColor().r - bakedSlot.getColor().r) < 1.0f / 255);
+		assert(MathUtil::abs(liveSlot.getColor().g - bakedSlot.getColor().g) < 1.0f / 255);
+		assert(MathUtil::abs(liveSlot.getColor().b - bakedSlot.getColor().b) < 1.0f / 255);
+		assert(MathUtil::abs(liveSlot.getColor().a - bakedSlot.getColor().a) < 1.0f / 255);
+		assert(liveSlot.getDeform().size() == bakedSlot.getDeform().size());
+		for (size_t ii = 0; ii < liveSlot.getDeform().size(); ii++)
+			assert(MathUtil::abs(liveSlot.getDeform()[ii] - bakedSlot.getDeform()[ii]) < 0.001f);
+		assert(&live.getDrawOrder()[i]->getData() == &baked.getDrawOrder()[i]->getData());
+	}
+}
+
+/// Checks the baked animation against live evaluation at the sample points, for skeletons placed away from the origin.
+static void checkBakedAnimation(Animation &animation, BakedAnimation &baked, Skeleton &live, Skeleton &played) {
+	live.setPosition(100, -50);
+	played.setPosition(100, -50);
+	for (size_t frame = 0; frame < baked.getFrameCount(); frame++) {
+		float time = MathUtil::min(frame / baked.getSampleRate(), animation.getDuration());
+		live.setToSetupPose();
+		animation.apply(live, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		live.updateWorldTransform();
+		baked.apply(played, time, false, true);
+		checkBakedPose(live, played);
+		baked.apply(played, time, false, false);
+		checkBakedPose(live, played);
+	}
+
+	// Looping wraps the time around the duration.
+	float time = 1.5f / baked.getSampleRate();
+	baked.apply(live, time, false, true);
+	baked.apply(played, time + animation.getDuration() * 2, true, true);
+	checkBakedPose(live, played);
+}
+
+void testAnimationBaker() {
+	printf("Testing animation baker\n");
+	const char *files[][3] = {{"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", "walk"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas", "shoot"}};
+	for (int i = 0; i < 2; i++) {
+		Atlas *atlas = NULL;
+		SkeletonData *skeletonData = NULL;
+		AnimationStateData *stateData = NULL;
+		Skeleton *skeleton = NULL;
+		AnimationState *state = NULL;
+		loadBinary(files[i][0], files[i][1], atlas, skeletonData, stateData, skeleton, state);
+		Animation *animation = skeletonData->findAnimation(files[i][2]);
+		Skeleton *played = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+		AnimationBaker baker(skeletonData);
+		BakedAnimation *baked = baker.bake(*animation, 30);
+		assert(baked->getFrameCount() >= (size_t) (animation->getDuration() * 30) + 1);
+		assert(baked->getMemoryUsage() >=
+			   baked->getFrameCount() * (skeletonData->getBones().size() * 6 * sizeof(float) +
+										 skeletonData->getSlots().size() * (sizeof(unsigned int) + sizeof(void *))));
+		checkBakedAnimation(*animation, *baked, *skeleton, *played);
+		delete baked;
+
+		// Mirrored skeletons are played back from a mirrored bake.
+		baker.setScale(-1, 1);
+		baked = baker.bake(*animation, 30);
+		skeleton->setScaleX(-1);
+		played->setScaleX(-1);
+		checkBakedAnimation(*animation, *baked, *skeleton, *played);
+		delete baked;
+
+		// Colors outside of 0 to 1 are baked clamped.
+		baker.setScale(1, 1);
+		Vector<Timeline *> timelines;
+		AlphaTimeline *alpha = new (__FILE__, __LINE__) AlphaTimeline(2, 0, 0);
+		alpha->setFrame(0, 0, 1.5f);
+		alpha->setFrame(1, 1, -0.5f);
+		timelines.add(alpha);
+		Animation overshoot("overshoot", timelines, 1);
+		baked = baker.bake(overshoot, 30);
+		baked->apply(*played, 0, false, false);
+		assert(played->getSlots()[0]->getColor().a == 1);
+		baked->apply(*played, 1, false, false);
+		assert(played->getSlots()[0]->getColor().a == 0);
+		delete baked;
+
+		delete played;
+		dispose(atlas, skeletonData, stateData, skeleton, state);
+	}
+}
+
+void checkSameAnimations(SkeletonData *eager, SkeletonData *lazy) {
+	assert(eager->getAnimations().size() == lazy->getAnimations().size());
+	for (size_t i = 0; i < eager->getAnimations().size(); i++) {
+		Animation *eagerAnimation = eager->getAnimations()[i];
+		Animation *lazyAnimation = lazy->findAnimation(eagerAnimation->getName());
+		assert(lazyAnimation == lazy->getAnimations()[i] && lazy->isAnimationDecoded(lazyAnimation));
+		assert(eagerAnimation->getDuration() == lazyAnimation->getDuration());
+		Vector<Timeline *> &eagerTimelines = eagerAnimation->getTimelines();
+		Vector<Timeline *> &lazyTimelines = lazyAnimation->getTimelines();
+		assert(eagerTimelines.size() == lazyTimelines.size());
+		for (size_t ii = 0; ii < eagerTimelines.size(); ii++) {
+			assert(eagerTimelines[ii]->getRTTI().isExactly(lazyTimelines[ii]->getRTTI()));
+			assert(eagerTimelines[ii]->getFrames() == lazyTimelines[ii]->getFrames());
+			if (!eagerTimelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *eagerDeform = static_cast<DeformTimeline *>(eagerTimelines[ii]);
+			DeformTimeline *lazyDeform = static_cast<DeformTimeline *>(lazyTimelines[ii]);
+			Vector<float> eagerVertices, lazyVertices;
+			for (size_t frame = 0; frame < eagerDeform->getFrameCount(); frame++) {
+				eagerDeform->getFrameVertices(frame, eagerVertices);
+				lazyDeform->getFrameVertices(frame, lazyVertices);
+				assert(eagerVertices == lazyVertices);
+			}
+		}
+	}
+}
+
+void testJsonParsing() {
+	printf("Testing JSON parsing\n");
+	Json *root = new (__FILE__, __LINE__) Json("{\"Name\": \"a\\tb\", \"int\": 7, \"negative\": -2.5, \"exponent\": 1.5e3, "
+											   "\"fraction\": 0.1, \"flag\": true, \"none\": null}");
+	assert(!root->getError());
+	assert(strcmp(Json::getString(root, "name", NULL), "a\tb") == 0);
+	assert(!Json::getItem(root, "nam"));
+	assert(Json::getItem(root, "none"));
+	assert(Json::getBoolean(root, "FLAG", false));
+	assert(Json::getInt(root, "int", 0) == 7);
+	assert(Json::getFloat(root, "negative", 0) == -2.5f);
+	assert(Json::getFloat(root, "exponent", 0) == 1500);
+	assert(Json::getFloat(root, "fraction", 0) == 0.1f);
+
+	// Wide objects are looked up through their hash table: case insensitive, the first of duplicate names, and misses.
+	char wide[4096];
+	int length = sprintf(wide, "{");
+	for (int i = 0; i < 100; i++)
+		length += sprintf(wide + length, "\"Item%d\": %d, ", i, i);
+	sprintf(wide + length, "\"item7\": -1}");
+	Json *wideRoot = new (__FILE__, __LINE__) Json(wide);
+	assert(!wideRoot->getError());
+	for (int i = 0; i < 100; i++) {
+		char name[16];
+		sprintf(name, "ITEM%d", i);
+		assert(Json::getInt(wideRoot, name, -2) == i);
+	}
+	assert(!Json::getItem(wideRoot, "item100") && !Json::getItem(wideRoot, "Item"));
+	delete wideRoot;
+
+	// Errors belong to the document that failed to parse.
+	const char *invalid = "{\"values\": [1, 2}";
+	Json *failed = new (__FILE__, __LINE__) Json(invalid);
+	assert(failed->getError() == invalid + 16);
+	assert(!root->getError());
+	delete failed;
+	delete root;
+
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/coin/coin.atlas", NULL);
+	SkeletonJson *json = new (__FILE__, __LINE__) SkeletonJson(atlas);
+	assert(!json->readSkeletonData(invalid));
+	assert(strncmp(json->getError().buffer(), "Invalid skeleton JSON: ", 23) == 0);
+	delete json;
+	delete atlas;
+}
+
+/// The stat of the phase recorded under the name for the skeleton data, or NULL. A NULL name finds unnamed stats.
+static ProfileStat *findStat(ProfileStats &stats, ProfilePhase phase, SkeletonData *skeletonData, const char *name) {
+	for (size_t i = 0; i < stats.getStats().size(); i++) {
+		ProfileStat &stat = stats.getStats()[i];
+		if (stat.phase != phase || stat.skeletonData != skeletonData) continue;
+		if (name ? stat.name == name : stat.name.isEmpty()) return &stat;
+	}
+	return NULL;
+}
+
+void testProfiler() {
+	printf("Testing profiler\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/tank/tank.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/tank/tank-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	skeleton->setSlotsToSetupPose();
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, "drive", true);
+	SkeletonRenderer *renderer = new (__FILE__, __LINE__) SkeletonRenderer();
+	ProfileStats *stats = new (__FILE__, __LINE__) ProfileStats();
+
+	// Scopes record only while a profiler is installed.
+	{
+		ProfileScope scope(ProfilePhase_Bone, skeleton, &skeleton->getRootBone()->getData().getName(), 2);
+	}
+	assert(stats->getStats().size() == 0);
+	Profiler::setInstance(stats);
+	for (int i = 0; i < 3; i++) {
+		ProfileScope scope(ProfilePhase_Bone, skeleton, &skeleton->getRootBone()->getData().getName(), 2);
+	}
+	ProfileStat *root = findStat(*stats, ProfilePhase_Bone, skeletonData, "root");
+	assert(root && root->calls == 3 && root->count == 6);
+	SP_UNUSED(root);
+	stats->clear();
+
+	for (int i = 0; i < 10; i++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		renderer->render(*skeleton);
+	}
+	// The attachment clipped by the tank is only shown when shooting, so a triangle is clipped explicitly.
+	{
+		SkeletonClipping clipper;
+		Slot *slot = skeleton->findSlot("clipping");
+		clipper.clipStart(*slot, static_cast<ClippingAttachment *>(slot->getAttachment()));
+		float vertices[] = {0, 0, 100, 0, 0, 100}, uvs[] = {0, 0, 1, 0, 0, 1};
+		unsigned short triangles[] = {0, 1, 2};
+		clipper.clipTriangles(vertices, triangles, 3, uvs, 2);
+		clipper.clipEnd();
+	}
+#ifdef SPINE_PROFILING
+	ProfileStat *apply = findStat(*stats, ProfilePhase_Apply, skeletonData, NULL);
+	assert(apply && apply->calls == 10 && apply->count == 10);
+	SP_UNUSED(apply);
+	assert(findStat(*stats, ProfilePhase_Bone, skeletonData, "tank-root"));
+	assert(findStat(*stats, ProfilePhase_IkConstraint, skeletonData, "cannon-ik"));
+	assert(findStat(*stats, ProfilePhase_PathConstraint, skeletonData, "treads-path"));
+	assert(findStat(*stats, ProfilePhase_TransformConstraint, skeletonData, "wheel-big-transform"));
+	assert(findStat(*stats, ProfilePhase_Clipping, skeletonData, "clipping"));
+	assert(findStat(*stats, ProfilePhase_WorldVertices, skeletonData, "antenna"));
+	assert(stats->getNanoseconds(ProfilePhase_Apply) > 0);
+#else
+	assert(stats->getStats().size() == 0);
+#endif
+	Profiler::setInstance(NULL);
+
+	delete stats;
+	delete renderer;
+	delete state;
+	delete stateData;
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+static void setAllAnimations(SkeletonData *skeletonData) {
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	AnimationState state(&stateData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++) {
+		state.setAnimation(0, animations[i]->getName(), false);
+		state.update(0.1f);
+		state.apply(skeleton);
+		skeleton.updateWorldTransform();
+	}
+}
+
+void testLazyAnimations() {
+	printf("Testing lazy animations\n");
+	const char *files[][2] = {{"testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"},
+							  {"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"}};
+	for (int i = 0; i < 6; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *eager = binary.readSkeletonDataFile(files[i][0]);
+		binary.setLazyAnimations(true);
+		SkeletonData *mapped = binary.readSkeletonDataFile(files[i][0]);
+		int length = 0;
+		char *data = SpineExtension::readFile(files[i][0], &length);
+		SkeletonData *read = binary.readSkeletonData((unsigned char *) data, length);
+		SpineExtension::free(data, __FILE__, __LINE__);
+		assert(eager && mapped && read);
+
+		// Durations are known before decoding.
+		for (size_t ii = 0; ii < eager->getAnimations().size(); ii++) {
+			Animation *animation = mapped->getAnimations()[ii];
+			assert(!mapped->isAnimationDecoded(animation) && animation->getTimelines().size() == 0);
+			assert(animation->getDuration() == eager->getAnimations()[ii]->getDuration());
+		}
+		checkSameAnimations(eager, mapped);
+		checkSameAnimations(eager, read);
+
+		// Evicted animations are decoded again when they are set on an animation state.
+		Animation *animation = read->getAnimations()[0];
+		read->evictAnimation(animation);
+		assert(!read->isAnimationDecoded(animation) && animation->getTimelines().size() == 0);
+		AnimationStateData stateData(read);
+		AnimationState state(&stateData);
+		state.setAnimation(0, animation, true);
+		assert(read->isAnimationDecoded(animation));
+		assert(animation->getTimelines().size() == eager->getAnimations()[0]->getTimelines().size());
+		assert(eager->isAnimationDecoded(eager->getAnimations()[0]));
+
+		// Skeletons sharing lazily loaded data decode the animations they find on different threads.
+		SkeletonData *shared = binary.readSkeletonDataFile(files[i][0]);
+		assert(shared);
+		std::thread threads[4];
+		for (int ii = 0; ii < 4; ii++) threads[ii] = std::thread(setAllAnimations, shared);
+		for (int ii = 0; ii < 4; ii++) threads[ii].join();
+		for (size_t ii = 0; ii < shared->getAnimations().size(); ii++)
+			assert(shared->isAnimationDecoded(shared->getAnimations()[ii]));
+		assert(shared->getAttachmentKeyCount() == eager->getAttachmentKeyCount());
+		checkSameAnimations(eager, shared);
+		delete shared;
+
+		delete read;
+		delete mapped;
+		delete eager;
+		delete atlas;
+	}
+}
+
+void testParallelLoading() {
+	printf("Testing parallel loading\n");
+	const char *files[][2] = {{"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+							  {"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"}};
+	for (int i = 0; i < 3; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *sequential = binary.readSkeletonDataFile(files[i][0]);
+		assert(sequential);
+		// More threads than animations are fine, the loaded data is the same for any number of threads.
+		size_t threadCounts[] = {2, 4, 64};
+		for (int ii = 0; ii < 3; ii++) {
+			binary.setThreadCount(threadCounts[ii]);
+			SkeletonData *parallel = binary.readSkeletonDataFile(files[i][0]);
+			assert(parallel);
+			checkSameAnimations(sequential, parallel);
+			delete parallel;
+		}
+		binary.setThreadCount(1);
+		delete sequential;
+		delete atlas;
+	}
+}
+
+void testDeformTimeline() {
+	printf("Testing deform timeline\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/goblins/goblins.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *exact = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	binary.setQuantizeDeform(true);
+	SkeletonData *quantized = binary.readSkeletonDataFile("testdata/goblins/goblins-pro.skel");
+	assert(exact && quantized);
+
+	size_t deformCount = 0;
+	Vector<float> exactVertices, quantizedVertices, setVertices;
+	for (size_t i = 0; i < exact->getAnimations().size(); i++) {
+		Vector<Timeline *> &exactTimelines = exact->getAnimations()[i]->getTimelines();
+		Vector<Timeline *> &quantizedTimelines = quantized->getAnimations()[i]->getTimelines();
+		for (size_t ii = 0; ii < exactTimelines.size(); ii++) {
+			if (!exactTimelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *exactDeform = static_cast<DeformTimeline *>(exactTimelines[ii]);
+			DeformTimeline *quantizedDeform = static_cast<DeformTimeline *>(quantizedTimelines[ii]);
+			assert(!exactDeform->isQuantized() && quantizedDeform->isQuantized());
+			deformCount++;
+
+			// Frames set from all vertices keep the same vertices.
+			VertexAttachment *attachment = exactDeform->getAttachment();
+			bool weighted = attachment->getBones().size() > 0;
+			DeformTimeline set(exactDeform->getFrameCount(), 0, exactDeform->getSlotIndex(), attachment);
+			for (size_t frame = 0; frame < exactDeform->getFrameCount(); frame++) {
+				exactDeform->getFrameVertices(frame, exactVertices);
+				quantizedDeform->getFrameVertices(frame, quantizedVertices);
+				assert(exactVertices.size() == exactDeform->getVertexCount());
+				set.setFrame((int) frame, exactDeform->getFrames()[frame], exactVertices);
+				set.getFrameVertices(frame, setVertices);
+
+				// Quantized offsets are off by at most half a step of the frame's largest offset.
+				float maxOffset = 0;
+				for (size_t v = 0; v < exactVertices.size(); v++) {
+					float offset = weighted ? exactVertices[v] : exactVertices[v] - attachment->getVertices()[v];
+					maxOffset = MathUtil::max(maxOffset, MathUtil::abs(offset));
+				}
+				for (size_t v = 0; v < exactVertices.size(); v++) {
+					assert(MathUtil::abs(exactVertices[v] - setVertices[v]) < 1e-4f);
+					assert(MathUtil::abs(exactVertices[v] - quantizedVertices[v]) <= maxOffset / 32767 * 0.5f + 1e-4f);
+				}
+			}
+			assert(set.getVertices().size() == exactDeform->getFrameCount());
+
+			// Frames keep their vertices when the attachment changes, stored relative to its setup vertices.
+			VertexAttachment *moved = static_cast<VertexAttachment *>(attachment->copy());
+			if (!weighted) {
+				for (size_t v = 0; v < moved->getVertices().size(); v++)
+					moved->getVertices()[v] += 1;
+			}
+			Vector<Vector<float> > frameVertices;
+			frameVertices.clearAndAddAll(exactDeform->getVertices());
+			for (int quantize = 0; quantize < 2; quantize++) {
+				if (quantize) set.quantize();
+				set.setAttachment(moved);
+				assert(set.getAttachment() == moved && set.isQuantized() == (quantize == 1));
+				assert(set.getVertexCount() == exactDeform->getVertexCount());
+				for (size_t frame = 0; frame < exactDeform->getFrameCount(); frame++) {
+					Vector<float> &vertices = set.getVertices()[frame];
+					for (size_t v = 0; v < vertices.size(); v++)
+						assert(MathUtil::abs(vertices[v] - frameVertices[frame][v]) < (quantize ? 1e-2f : 1e-4f));
+				}
+				set.setAttachment(attachment);
+			}
+			if (!weighted) {
+				// With fewer vertices, the frames are cut.
+				VertexAttachment *cut = static_cast<VertexAttachment *>(attachment->copy());
+				cut->getVertices().setSize(cut->getVertices().size() - 2, 0);
+				set.setAttachment(cut);
+				assert(set.getVertexCount() == cut->getVertices().size());
+				for (size_t frame = 0; frame < exactDeform->getFrameCount(); frame++) {
+					set.getFrameVertices(frame, setVertices);
+					assert(setVertices.size() == set.getVertexCount());
+				}
+				set.setAttachment(attachment);
+				delete cut;
+			}
+			delete moved;
+		}
+	}
+	assert(deformCount > 0);
+
+	// Applied quantized timelines stay close to the exact ones.
+	Skeleton exactSkeleton(exact), quantizedSkeleton(quantized);
+	exactSkeleton.setSkin("goblin");
+	quantizedSkeleton.setSkin("goblin");
+	for (size_t i = 0; i < exact->getAnimations().size(); i++) {
+		Animation *exactAnimation = exact->getAnimations()[i];
+		Animation *quantizedAnimation = quantized->getAnimations()[i];
+		for (float time = 0; time < exactAnimation->getDuration(); time += 0.1f) {
+			exactSkeleton.setToSetupPose();
+			quantizedSkeleton.setToSetupPose();
+			exactAnimation->apply(exactSkeleton, 0, time, false, NULL, 0.75f, MixBlend_Setup, MixDirection_In);
+			quantizedAnimation->apply(quantizedSkeleton, 0, time, false, NULL, 0.75f, MixBlend_Setup,
+									  MixDirection_In);
+			for (size_t ii = 0; ii < exactSkeleton.getSlots().size(); ii++) {
+				Vector<float> &exactDeform = exactSkeleton.getSlots()[ii]->getDeform();
+				Vector<float> &quantizedDeform = quantizedSkeleton.getSlots()[ii]->getDeform();
+				assert(exactDeform.size() == quantizedDeform.size());
+				for (size_t v = 0; v < exactDeform.size(); v++)
+					assert(MathUtil::abs(exactDeform[v] - quantizedDeform[v]) < 1e-3f);
+			}
+		}
+	}
+
+	delete quantized;
+	delete exact;
+	delete atlas;
+}
+
+static unsigned long long hashFloats(unsigned long long hash, const float *values, size_t count) {
+	for (size_t i = 0; i < count; i++) {
+		unsigned int bits;
+		memcpy(&bits, &values[i], sizeof(bits));
+		for (int byte = 0; byte < 4; byte++) {
+			hash ^= (bits >> (byte * 8)) & 0xff;
+			hash *= 0x100000001b3ULL;
+		}
+	}
+	return hash;
+}
+
+static double sumFloats(double sum, const float *values, size_t count) {
+	for (size_t i = 0; i < count; i++)
+		sum += values[i] * (double) (1 + i % 7);
+	return sum;
+}
+
+/// Hashes the frame vertices of all deform timelines and sums the deform they apply between frames. The curves are
+/// computed differently depending on the optimization level, so the applied deform is compared with a tolerance.
+static void hashDeformTimelines(SkeletonData *skeletonData, size_t &timelineCount, unsigned long long &framesHash,
+								double &appliedSum) {
+	timelineCount = 0;
+	framesHash = 0xcbf29ce484222325ULL;
+	appliedSum = 0;
+	Skeleton skeleton(skeletonData);
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Vector<Timeline *> &timelines = skeletonData->getAnimations()[i]->getTimelines();
+		for (size_t ii = 0; ii < timelines.size(); ii++) {
+			if (!timelines[ii]->getRTTI().isExactly(DeformTimeline::rtti)) continue;
+			DeformTimeline *timeline = static_cast<DeformTimeline *>(timelines[ii]);
+			timelineCount++;
+			Vector<Vector<float> > &vertices = timeline->getVertices();
+			for (size_t frame = 0; frame < vertices.size(); frame++)
+				framesHash = hashFloats(framesHash, vertices[frame].buffer(), vertices[frame].size());
+			Slot *slot = skeleton.getSlots()[timeline->getSlotIndex()];
+			slot->setAttachment(timeline->getAttachment());
+			Vector<float> &frames = timeline->getFrames();
+			for (size_t frame = 0; frame < frames.size(); frame++) {
+				float time = frame + 1 < frames.size() ? (frames[frame] + frames[frame + 1]) / 2 : frames[frame] + 1;
+				timeline->apply(skeleton, 0, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+				appliedSum = sumFloats(appliedSum, slot->getDeform().buffer(), slot->getDeform().size());
+				timeline->apply(skeleton, 0, time, NULL, 0.5f, MixBlend_Replace, MixDirection_In);
+				appliedSum = sumFloats(appliedSum, slot->getDeform().buffer(), slot->getDeform().size());
+			}
+			slot->getDeform().clear();
+		}
+	}
+}
+
+void testDeformGolden() {
+	printf("Testing deform golden\n");
+	// Computed by the dense deform timeline, which kept all vertices of every frame, before frames were stored as
+	// offsets. The frames computed from the offsets must have the same bits.
+	struct Golden {
+		const char *path;
+		size_t timelineCount;
+		unsigned long long framesHash;
+		double appliedSum;
+	} goldens[] = {
+		{"testdata/goblins/goblins-pro.json", 11, 0x0b68ff2540c9815bULL, 123116.783},
+		{"testdata/goblins/goblins-pro.skel", 11, 0x22991683cd695dedULL, 123116.806},
+		{"testdata/spineboy/spineboy-pro.json", 4, 0x6a6a8d3d18eb4e0cULL, -45817.965},
+		{"testdata/spineboy/spineboy-pro.skel", 4, 0xbd965fab39c141b3ULL, -45818.462},
+		{"testdata/stretchyman/stretchyman-pro.json", 2, 0x6be77069c781c436ULL, -18579.963},
+		{"testdata/stretchyman/stretchyman-pro.skel", 2, 0xdc40d19d012af6f6ULL, -18573.984},
+		{"testdata/tank/tank-pro.json", 2, 0x0e3ebc54cf7d5441ULL, -4483.200},
+		{"testdata/tank/tank-pro.skel", 2, 0xfdf190cef0fd9eadULL, -4483.200}};
+	const char *atlases[] = {"testdata/goblins/goblins.atlas", "testdata/spineboy/spineboy.atlas",
+							 "testdata/stretchyman/stretchyman.atlas", "testdata/tank/tank.atlas"};
+	for (int i = 0; i < 8; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(atlases[i / 2], NULL);
+		SkeletonData *skeletonData;
+		if (i % 2 == 0) {
+			SkeletonJson json(atlas);
+			skeletonData = json.readSkeletonDataFile(goldens[i].path);
+		} else {
+			SkeletonBinary binary(atlas);
+			skeletonData = binary.readSkeletonDataFile(goldens[i].path);
+		}
+		assert(skeletonData);
+		size_t timelineCount;
+		unsigned long long framesHash;
+		double appliedSum;
+		hashDeformTimelines(skeletonData, timelineCount, framesHash, appliedSum);
+		assert(timelineCount == goldens[i].timelineCount);
+		assert(framesHash == goldens[i].framesHash);
+		assert(fabs(appliedSum - goldens[i].appliedSum) < 0.01);
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+static float polygonArea(const float *vertices, size_t count) {
+	float area = 0;
+	for (size_t i = 0, j = count - 1; i < count; j = i++)
+		area += vertices[j * 2] * vertices[i * 2 + 1] - vertices[i * 2] * vertices[j * 2 + 1];
+	return area / 2;
+}
+
+void testClipping() {
+	printf("Testing clipping\n");
+	// A clockwise concave comb, whose ears are all cut next to concave vertices.
+	float comb[] = {0, 4, 2, 4, 2, 1, 4, 1, 4, 4, 6, 4, 6, 1, 8, 1, 8, 4, 10, 4, 10, 0, 0, 0};
+	Vector<float> vertices;
+	for (size_t i = 0; i < 24; i++)
+		vertices.add(comb[i]);
+	Triangulator triangulator;
+	Vector<int> &triangles = triangulator.triangulate(vertices);
+	assert(triangles.size() == (12 - 2) * 3);
+	float area = 0;
+	for (size_t i = 0; i < triangles.size(); i += 3) {
+		float triangle[] = {comb[triangles[i] * 2], comb[triangles[i] * 2 + 1], comb[triangles[i + 1] * 2],
+							comb[triangles[i + 1] * 2 + 1], comb[triangles[i + 2] * 2], comb[triangles[i + 2] * 2 + 1]};
+		assert(polygonArea(triangle, 3) <= 0);
+		area += polygonArea(triangle, 3);
+	}
+	assert(area == polygonArea(comb, 12));
+	SP_UNUSED(area);
+
+	// Clipping with a cached decomposition matches clipping with a new one while the skeleton moves and flips.
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/tank/tank.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/tank/tank-pro.skel");
+	assert(skeletonData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	skeleton->setSlotsToSetupPose();
+	Slot *slot = skeleton->findSlot("clipping");
+	ClippingAttachment *attachment = static_cast<ClippingAttachment *>(slot->getAttachment());
+	SkeletonClipping cached;
+	float triangle[] = {-500, -500, 500, -500, 0, 500}, uvs[] = {0, 0, 1, 0, 0, 1};
+	unsigned short indices[] = {0, 1, 2};
+	for (int i = 0; i < 4; i++) {
+		skeleton->setX(i * 50.0f);
+		skeleton->setScaleX(i == 2 ? -1.0f : 1.0f);
+		skeleton->getRootBone()->setRotation(i * 30.0f);
+		skeleton->updateWorldTransform();
+		SkeletonClipping fresh;
+		size_t polygons = fresh.clipStart(*slot, attachment);
+		assert(cached.clipStart(*slot, attachment) == polygons);
+		SP_UNUSED(polygons);
+		fresh.clipTriangles(triangle, indices, 3, uvs, 2);
+		cached.clipTriangles(triangle, indices, 3, uvs, 2);
+		assert(fresh.getClippedVertices().size() > 0);
+		assert(fresh.getClippedVertices() == cached.getClippedVertices());
+		assert(fresh.getClippedTriangles() == cached.getClippedTriangles());
+		fresh.clipEnd();
+		cached.clipEnd();
+	}
+
+	delete skeleton;
+	delete skeletonData;
+	delete atlas;
+}
+
+void testZeroAllocationAnimationState(DebugExtension &debug) {
+	printf("Testing zero allocation animation state\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData,
+			   skeleton, state);
+	stateData->setDefaultMix(0.2f);
+	const char *names[] = {"run", "walk", "jump", "idle", "death", "portal", "hoverboard", "idle-turn"};
+	Animation *animations[8];
+	for (int i = 0; i < 8; i++)
+		animations[i] = skeletonData->findAnimation(names[i]);
+	Animation *shoot = skeletonData->findAnimation("shoot"), *aim = skeletonData->findAnimation("aim");
+	// Mixes out like setEmptyAnimation(), whose shared empty animation would only be freed at exit.
+	Vector<Timeline *> noTimelines;
+	Animation *empty = new (__FILE__, __LINE__) Animation("empty", noTimelines, 0);
+
+	// Switches animations on several tracks with mixing, empty animations and queued entries. The pattern repeats every
+	// 6300 frames. Mixes can overlap slightly differently in the first repetitions, after which every buffer and pool has
+	// reached its final size.
+	size_t allocations = 0, reallocations = 0;
+	for (int frame = 0; frame < 6300 * 3; frame++) {
+		if (frame == 6300 * 2) {
+			allocations = debug.getAllocations();
+			reallocations = debug.getReallocations();
+		}
+		if (frame % 30 == 0) {
+			state->setAnimation(0, animations[(frame / 30) % 8], false);
+			state->addAnimation(0, animations[(frame / 30 + 1) % 8], true, 0);
+		}
+		if (frame % 45 == 0) state->setAnimation(1, shoot, false);
+		if (frame % 100 == 0) {
+			TrackEntry *entry = state->setAnimation(1, empty, false);
+			entry->setMixDuration(0.1f);
+			entry->setTrackEnd(0.1f);
+		}
+		if (frame % 70 == 0) state->setAnimation(2, aim, true)->setAlpha(0.5f);
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+	}
+	assert(debug.getAllocations() == allocations);
+	assert(debug.getReallocations() == reallocations);
+	SP_UNUSED(allocations);
+	SP_UNUSED(reallocations);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+	delete empty;
+}
+
+static void checkSameSkeleton(Skeleton &expected, Skeleton &actual) {
+	for (size_t i = 0; i < expected.getBones().size(); i++) {
+		Bone *e = expected.getBones()[i], *a = actual.getBones()[i];
+		assert(e->getX() == a->getX() && e->getY() == a->getY() && e->getRotation() == a->getRotation());
+		assert(e->getA() == a->getA() && e->getB() == a->getB() && e->getC() == a->getC() && e->getD() == a->getD());
+		assert(e->getWorldX() == a->getWorldX() && e->getWorldY() == a->getWorldY());
+		assert(e->isActive() == a->isActive());
+		SP_UNUSED(e);
+		SP_UNUSED(a);
+	}
+	for (size_t i = 0; i < expected.getSlots().size(); i++) {
+		Slot *e = expected.getSlots()[i], *a = actual.getSlots()[i];
+		assert(e->getAttachment() == a->getAttachment());
+		assert(e->getColor().r == a->getColor().r && e->getColor().a == a->getColor().a);
+		assert(e->getDeform() == a->getDeform());
+		assert(expected.getDrawOrder()[i]->getData().getIndex() == actual.getDrawOrder()[i]->getData().getIndex());
+		SP_UNUSED(e);
+		SP_UNUSED(a);
+	}
+	for (size_t i = 0; i < expected.getPathConstraints().size(); i++)
+		assert(expected.getPathConstraints()[i]->getPosition() == actual.getPathConstraints()[i]->getPosition());
+	assert(expected.getUpdateCacheList().size() == actual.getUpdateCacheList().size());
+}
+
+static int planKind(Timeline *timeline) {
+	if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) return 0;
+	if (timeline->getRTTI().isExactly(RotateTimeline::rtti)) return 1;
+	if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti)) return 3;
+	if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) return 4;
+	return 2;
+}
+
+void testTimelinePlan() {
+	printf("Testing timeline plan\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData,
+			   skeleton, state);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+
+	// A single track at full alpha applies the planned timelines like Animation::apply() applies them in their order.
+	Skeleton *expected = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	for (size_t i = 0; i < animations.size(); i++) {
+		skeleton->setToSetupPose();
+		expected->setToSetupPose();
+		TrackEntry *entry = state->setAnimation(0, animations[i], true);
+		for (int frame = 0; frame < 20; frame++) {
+			state->update(1 / 15.0f);
+			state->apply(*skeleton);
+			animations[i]->apply(*expected, 0, entry->getAnimationTime(), false, NULL, 1, MixBlend_First, MixDirection_In);
+			skeleton->updateWorldTransform();
+			expected->updateWorldTransform();
+			checkSameSkeleton(*expected, *skeleton);
+		}
+		state->clearTrack(0);
+	}
+
+	// With mixing and layered tracks, the plan applies the timelines like copies of the animations whose timelines are
+	// already grouped by kind, for which the plan keeps the order.
+	Vector<Animation *> grouped;
+	for (size_t i = 0; i < animations.size(); i++) {
+		Vector<Timeline *> timelines;
+		for (int kind = 0; kind < 5; kind++)
+			for (size_t ii = 0; ii < animations[i]->getTimelines().size(); ii++)
+				if (planKind(animations[i]->getTimelines()[ii]) == kind) timelines.add(animations[i]->getTimelines()[ii]);
+		grouped.add(new (__FILE__, __LINE__) Animation(animations[i]->getName(), timelines, animations[i]->getDuration()));
+	}
+	AnimationState *groupedState = new (__FILE__, __LINE__) AnimationState(stateData);
+	skeleton->setToSetupPose();
+	expected->setToSetupPose();
+	for (int frame = 0; frame < 600; frame++) {
+		if (frame % 40 == 0) {
+			size_t index = (frame / 40) % animations.size();
+			state->setAnimation(0, animations[index], true);
+			groupedState->setAnimation(0, grouped[index], true);
+		}
+		if (frame % 55 == 0) {
+			size_t index = (frame / 55 + 3) % animations.size();
+			state->setAnimation(1, animations[index], false)->setAlpha(0.6f);
+			groupedState->setAnimation(1, grouped[index], false)->setAlpha(0.6f);
+		}
+		state->update(1 / 30.0f);
+		groupedState->update(1 / 30.0f);
+		state->apply(*skeleton);
+		groupedState->apply(*expected);
+		skeleton->updateWorldTransform();
+		expected->updateWorldTransform();
+		checkSameSkeleton(*expected, *skeleton);
+	}
+	delete groupedState;
+	for (size_t i = 0; i < grouped.size(); i++) {
+		// The timelines are owned by the original animations.
+		grouped[i]->getTimelines().clear();
+		delete grouped[i];
+	}
+
+	// A pooled entry that held a plan applies nothing for an animation without timelines. A layered track applies the
+	// runs of every kind, not only up to the plan size.
+	state->clearTracks();
+	state->setAnimation(1, "walk", true);
+	state->update(0.5f);
+	state->apply(*skeleton);
+	state->clearTrack(1);
+	Vector<Timeline *> noTimelines;
+	Animation *empty = new (__FILE__, __LINE__) Animation("empty", noTimelines, 0);
+	state->setAnimation(1, empty, true);
+	skeleton->setToSetupPose();
+	expected->setToSetupPose();
+	state->update(0.5f);
+	state->apply(*skeleton);
+	skeleton->updateWorldTransform();
+	expected->updateWorldTransform();
+	checkSameSkeleton(*expected, *skeleton);
+
+	delete expected;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+	delete empty;
+}
+
+void testSkeletonPose() {
+	printf("Testing skeleton pose\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas", atlas, skeletonData, stateData, skeleton, state);
+	state->setAnimation(0, "drive", true);
+	state->setAnimation(1, "shoot", false);
+	for (int frame = 0; frame < 20; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+	}
+
+	// The shoot animation has keyed deform and draw order by now, which the pose and the copy must carry over.
+	SkeletonPose pose;
+	pose.capture(*skeleton);
+	assert(pose.getData() == skeletonData);
+	Skeleton *copy = skeleton->copy();
+	checkSameSkeleton(*skeleton, *copy);
+
+	for (int frame = 0; frame < 40; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+	}
+	pose.restore(*skeleton);
+	skeleton->updateWorldTransform();
+	copy->updateWorldTransform();
+	checkSameSkeleton(*copy, *skeleton);
+
+	// Restoring works between skeletons with and without batch updates.
+	Skeleton *batched = new (__FILE__, __LINE__) Skeleton(skeletonData, true);
+	pose.restore(*batched);
+	batched->updateWorldTransform();
+	checkSameSkeleton(*copy, *batched);
+	pose.capture(*batched);
+	Skeleton *batchedCopy = batched->copy();
+	pose.restore(*copy);
+	checkSameSkeleton(*batchedCopy, *copy);
+
+	// The copy updates like the original.
+	for (int frame = 0; frame < 10; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		state->apply(*batchedCopy);
+		skeleton->updateWorldTransform();
+		batchedCopy->updateWorldTransform();
+		checkSameSkeleton(*skeleton, *batchedCopy);
+	}
+
+	delete batchedCopy;
+	delete batched;
+	delete copy;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testSkeletonLod() {
+	printf("Testing skeleton level of detail\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas", atlas, skeletonData, stateData, skeleton, state);
+	Skeleton *reference = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationState *referenceState = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, "drive", true);
+	state->setAnimation(1, "shoot", true);
+	referenceState->setAnimation(0, "drive", true);
+	referenceState->setAnimation(1, "shoot", true);
+
+	SkeletonLod lod(*skeleton, *state);
+	LodTier near;
+	near.minMetric = 10;
+	near.skippedConstraints = ConstraintType_Path;
+	near.freezeDeform = true;
+	lod.addTier(near);
+	LodTier far;
+	far.minMetric = 20;
+	far.updateInterval = 3;
+	far.interpolate = true;
+	lod.addTier(far);
+
+	// Full detail updates like the animation state and skeleton do by themselves.
+	for (int frame = 0; frame < 10; frame++) {
+		assert(lod.update(1 / 30.0f, 5));
+		referenceState->update(1 / 30.0f);
+		referenceState->apply(*reference);
+		reference->updateWorldTransform();
+		checkSameSkeleton(*reference, *skeleton);
+	}
+	assert(lod.getTierIndex() == -1);
+
+	// Skipping path constraints is the same as a mix of 0. Frozen deform keeps the last deform.
+	Vector<float> deform;
+	Slot *deformed = NULL;
+	for (size_t i = 0; i < skeleton->getSlots().size() && !deformed; i++)
+		if (skeleton->getSlots()[i]->getDeform().size() > 0) deformed = skeleton->getSlots()[i];
+	assert(deformed);
+	deform.clearAndAddAll(deformed->getDeform());
+	for (int frame = 0; frame < 10; frame++) {
+		assert(lod.update(1 / 30.0f, 15));
+		referenceState->update(1 / 30.0f);
+		referenceState->apply(*reference);
+		for (size_t i = 0; i < reference->getPathConstraints().size(); i++) {
+			PathConstraint *constraint = reference->getPathConstraints()[i];
+			constraint->setMixRotate(0);
+			constraint->setMixX(0);
+			constraint->setMixY(0);
+		}
+		reference->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *expected = reference->getBones()[i], *actual = skeleton->getBones()[i];
+			assert(expected->getWorldX() == actual->getWorldX() && expected->getWorldY() == actual->getWorldY());
+			assert(expected->getA() == actual->getA() && expected->getD() == actual->getD());
+			SP_UNUSED(expected);
+			SP_UNUSED(actual);
+		}
+		assert(deformed->getDeform() == deform);
+	}
+	assert(lod.getTierIndex() == 0 && lod.getTier().freezeDeform);
+
+	// Every third frame updates. After the tier changes, the first update is shown at once. Each later update is shown
+	// at the next update, with the frames in between moving toward it.
+	size_t boneCount = skeleton->getBones().size();
+	Vector<float> shown[12];
+	for (int frame = 0; frame < 12; frame++) {
+		assert(lod.update(1 / 30.0f, 25) == (frame % 3 == 0));
+		for (size_t i = 0; i < boneCount; i++)
+			shown[frame].add(skeleton->getBones()[i]->getWorldX());
+	}
+	assert(shown[1] == shown[0] && shown[2] == shown[0] && shown[3] == shown[0]);
+	for (int frame = 4; frame < 9; frame++) {
+		if (frame % 3 == 0) continue;
+		int from = frame - frame % 3, to = from + 3;
+		for (size_t i = 0; i < boneCount; i++) {
+			float expected = shown[from][i] + (shown[to][i] - shown[from][i]) * (frame % 3) / 3;
+			assert(MathUtil::abs(shown[frame][i] - expected) < 0.001f);
+			SP_UNUSED(expected);
+		}
+	}
+	assert(lod.getTierIndex() == 1);
+
+	// The frames between updates follow the skeleton as it moves, both before the tier has two updates to move between
+	// and after.
+	assert(lod.update(1 / 30.0f, 15));
+	Vector<float> moved[12];
+	for (int frame = 0; frame < 12; frame++) {
+		skeleton->setPosition(frame * 10.0f, frame * -5.0f);
+		assert(lod.update(1 / 30.0f, 25) == (frame % 3 == 0));
+		for (size_t i = 0; i < boneCount; i++) {
+			moved[frame].add(skeleton->getBones()[i]->getWorldX() - skeleton->getX());
+			moved[frame].add(skeleton->getBones()[i]->getWorldY() - skeleton->getY());
+		}
+	}
+	for (size_t i = 0; i < boneCount * 2; i++) {
+		assert(MathUtil::abs(moved[1][i] - moved[0][i]) < 0.001f);
+		assert(MathUtil::abs(moved[2][i] - moved[0][i]) < 0.001f);
+	}
+	for (int frame = 4; frame < 9; frame++) {
+		if (frame % 3 == 0) continue;
+		int from = frame - frame % 3, to = from + 3;
+		for (size_t i = 0; i < boneCount * 2; i++) {
+			float expected = moved[from][i] + (moved[to][i] - moved[from][i]) * (frame % 3) / 3;
+			assert(MathUtil::abs(moved[frame][i] - expected) < 0.001f);
+			SP_UNUSED(expected);
+		}
+	}
+	skeleton->setPosition(0, 0);
+
+	// Attachments smaller than the minimum slot size are not rendered.
+	SkeletonRenderer renderer;
+	renderer.render(*skeleton);
+	size_t vertexCount = renderer.getVertices().size();
+	assert(vertexCount > 0);
+	renderer.setMinSlotSize(0.001f);
+	renderer.render(*skeleton);
+	assert(renderer.getVertices().size() == vertexCount);
+	renderer.setMinSlotSize(100000);
+	renderer.render(*skeleton);
+	assert(renderer.getVertices().size() == 0);
+	SP_UNUSED(vertexCount);
+
+	delete referenceState;
+	delete reference;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/// Resets the cached world path of each path constraint, so the next update computes it from scratch.
+static void resetPathCaches(Skeleton &skeleton) {
+	for (size_t i = 0; i < skeleton.getPathConstraints().size(); i++) {
+		PathConstraint *constraint = skeleton.getPathConstraints()[i];
+		constraint->setTarget(constraint->getTarget());
+	}
+}
+
+void testPathConstraintCache() {
+	printf("Testing path constraint cache\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas", atlas,
+			   skeletonData, stateData, skeleton, state);
+	Skeleton *reference = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	AnimationState *referenceState = new (__FILE__, __LINE__) AnimationState(stateData);
+	state->setAnimation(0, "sneak", true);
+	referenceState->setAnimation(0, "sneak", true);
+
+	// Moving bones and deform invalidate the cache.
+	for (int frame = 0; frame < 20; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		referenceState->update(1 / 30.0f);
+		referenceState->apply(*reference);
+		resetPathCaches(*reference);
+		reference->updateWorldTransform();
+		checkSameSkeleton(*reference, *skeleton);
+	}
+
+	// A still skeleton reuses the cached path.
+	for (int frame = 0; frame < 3; frame++) {
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		checkSameSkeleton(*reference, *skeleton);
+	}
+
+	// Changing the position or spacing reuses the cached path but positions the bones again.
+	PathConstraint *constraint = skeleton->getPathConstraints()[0];
+	PathConstraint *referenceConstraint = reference->getPathConstraints()[0];
+	constraint->setPosition(constraint->getPosition() + 0.1f);
+	referenceConstraint->setPosition(constraint->getPosition());
+	constraint->setSpacing(constraint->getSpacing() * 0.5f);
+	referenceConstraint->setSpacing(constraint->getSpacing());
+	skeleton->updateWorldTransform();
+	resetPathCaches(*reference);
+	reference->updateWorldTransform();
+	checkSameSkeleton(*reference, *skeleton);
+
+	// Changing the deform of the target slot invalidates the cache.
+	Slot *target = constraint->getTarget(), *referenceTarget = referenceConstraint->getTarget();
+	PathAttachment *path = static_cast<PathAttachment *>(target->getAttachment());
+	target->getDeform().clearAndAddAll(path->getVertices());
+	referenceTarget->getDeform().clearAndAddAll(path->getVertices());
+	for (int change = 0; change < 2; change++) {
+		target->getDeform()[8] += 3;
+		referenceTarget->getDeform()[8] += 3;
+		skeleton->updateWorldTransform();
+		resetPathCaches(*reference);
+		reference->updateWorldTransform();
+		checkSameSkeleton(*reference, *skeleton);
+	}
+
+	delete referenceState;
+	delete reference;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/// Checks that finding attachments by key finds the same attachments as finding them by name.
+static void checkAttachmentKeys(Skeleton &skeleton) {
+	SkeletonData *skeletonData = skeleton.getData();
+	for (size_t slotIndex = 0; slotIndex < skeletonData->getSlots().size(); slotIndex++) {
+		Vector<String> names;
+		for (size_t i = 0; i < skeletonData->getSkins().size(); i++)
+			skeletonData->getSkins()[i]->findNamesForSlot(slotIndex, names);
+		for (size_t i = 0; i < names.size(); i++) {
+			int key = skeletonData->findAttachmentKey(slotIndex, names[i]);
+			if (key == -1) continue;
+			assert(skeleton.getAttachment(key) == skeleton.getAttachment((int) slotIndex, names[i]));
+		}
+	}
+}
+
+void testAttachmentKeys() {
+	printf("Testing attachment keys\n");
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas", atlas, skeletonData, stateData,
+			   skeleton, state);
+
+	// Each attachment name of the setup pose and of the attachment timelines has a key.
+	for (size_t i = 0; i < skeletonData->getSlots().size(); i++) {
+		SlotData *slot = skeletonData->getSlots()[i];
+		assert(slot->getAttachmentKey() ==
+			   (slot->getAttachmentName().isEmpty() ? -1 : skeletonData->findAttachmentKey(i, slot->getAttachmentName())));
+		assert(slot->getAttachmentName().isEmpty() || slot->getAttachmentKey() != -1);
+	}
+	size_t timelineCount = 0;
+	Vector<Timeline *> &timelines = skeletonData->findAnimation("walk")->getTimelines();
+	for (size_t i = 0; i < timelines.size(); i++) {
+		if (!timelines[i]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+		AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[i]);
+		for (size_t ii = 0; ii < timeline->getAttachmentNames().size(); ii++) {
+			const String &name = timeline->getAttachmentNames()[ii];
+			assert(timeline->getAttachmentKeys()[ii] ==
+				   (name.isEmpty() ? -1 : skeletonData->findAttachmentKey(timeline->getSlotIndex(), name)));
+			assert(name.isEmpty() || timeline->getAttachmentKeys()[ii] != -1);
+		}
+		timelineCount++;
+	}
+	assert(timelineCount > 0);
+	SP_UNUSED(timelineCount);
+
+	// Keyed attachments follow skin changes and changes to the skins.
+	checkAttachmentKeys(*skeleton);
+	skeleton->setSkin("goblin");
+	checkAttachmentKeys(*skeleton);
+	skeleton->setSkin("goblingirl");
+	checkAttachmentKeys(*skeleton);
+	Skin *skin = skeleton->getSkin();
+	for (size_t i = 0; i < skeletonData->getSlots().size(); i++) {
+		SlotData *slot = skeletonData->getSlots()[i];
+		if (slot->getAttachmentKey() == -1 || !skin->getAttachment(i, slot->getAttachmentName())) continue;
+		skin->removeAttachment(i, slot->getAttachmentName());
+		assert(skeleton->getAttachment(slot->getAttachmentKey()) == skeleton->getAttachment(i, slot->getAttachmentName()));
+		break;
+	}
+	checkAttachmentKeys(*skeleton);
+	skeleton->setSlotsToSetupPose();
+
+	// A copy keeps the keyed attachments, animations find them by key.
+	Skeleton *copy = skeleton->copy();
+	checkAttachmentKeys(*copy);
+	TrackEntry *entry = state->setAnimation(0, "walk", true);
+	for (int frame = 0; frame < 30; frame++) {
+		state->update(1 / 30.0f);
+		state->apply(*skeleton);
+		for (size_t i = 0; i < timelines.size(); i++) {
+			if (!timelines[i]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+			AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[i]);
+			Vector<float> &frames = timeline->getFrames();
+			if (entry->getAnimationTime() < frames[0]) continue;
+			size_t last = 0;
+			while (last + 1 < frames.size() && frames[last + 1] <= entry->getAnimationTime())
+				last++;
+			const String &name = timeline->getAttachmentNames()[last];
+			assert(skeleton->getSlots()[timeline->getSlotIndex()]->getAttachment() ==
+				   skeleton->getAttachment(timeline->getSlotIndex(), name));
+			SP_UNUSED(name);
+		}
+	}
+
+	// Restoring a pose with another skin and replacing the default skin change the keyed attachments too, even when the
+	// skins have the same number of changes.
+	state->clearTracks();
+	Slot *head = skeleton->findSlot("head");
+	int headIndex = head->getData().getIndex();
+	Attachment *goblinHead = skeletonData->findSkin("goblin")->getAttachment(headIndex, "head");
+	Skin *first = new (__FILE__, __LINE__) Skin("first"), *second = new (__FILE__, __LINE__) Skin("second");
+	first->setAttachment(headIndex, "head", goblinHead->copy());
+	second->setAttachment(headIndex, "head", goblinHead->copy());
+	skeleton->setSkin(first);
+	skeleton->setSlotsToSetupPose();
+	assert(head->getAttachment() == first->getAttachment(headIndex, "head"));
+	SkeletonPose pose;
+	pose.capture(*skeleton);
+	skeleton->setSkin(second);
+	skeleton->setSlotsToSetupPose();
+	assert(head->getAttachment() == second->getAttachment(headIndex, "head"));
+	pose.restore(*skeleton);
+	skeleton->setSlotsToSetupPose();
+	assert(head->getAttachment() == first->getAttachment(headIndex, "head"));
+	checkAttachmentKeys(*skeleton);
+
+	Skin *defaultSkin = skeletonData->getDefaultSkin();
+	skeleton->setSkin((Skin *) NULL);
+	skeletonData->setDefaultSkin(first);
+	skeleton->setSlotsToSetupPose();
+	assert(head->getAttachment() == first->getAttachment(headIndex, "head"));
+	skeletonData->setDefaultSkin(second);
+	skeleton->setSlotsToSetupPose();
+	assert(head->getAttachment() == second->getAttachment(headIndex, "head"));
+	skeletonData->setDefaultSkin(defaultSkin);
+	skeleton->setSlotsToSetupPose();
+	delete first;
+	delete second;
+
+	delete copy;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+/// Describes the update cache of a skeleton by bone index and constraint order, followed by which bones and constraints are
+/// active.
+static void describeUpdateCache(Skeleton &skeleton, Vector<int> &description) {
+	description.clear();
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+	for (size_t i = 0; i < updateCache.size(); i++) {
+		Updatable *updatable = updateCache[i];
+		if (updatable->getRTTI().isExactly(Bone::rtti))
+			description.add(static_cast<Bone *>(updatable)->getData().getIndex());
+		else if (updatable->getRTTI().isExactly(IkConstraint::rtti))
+			description.add(-1 - (int) static_cast<IkConstraint *>(updatable)->getData().getOrder());
+		else if (updatable->getRTTI().isExactly(TransformConstraint::rtti))
+			description.add(-1 - (int) static_cast<TransformConstraint *>(updatable)->getData().getOrder());
+		else
+			description.add(-1 - (int) static_cast<PathConstraint *>(updatable)->getData().getOrder());
+	}
+	for (size_t i = 0; i < skeleton.getBones().size(); i++)
+		description.add(skeleton.getBones()[i]->isActive());
+	for (size_t i = 0; i < skeleton.getIkConstraints().size(); i++)
+		description.add(skeleton.getIkConstraints()[i]->isActive());
+	for (size_t i = 0; i < skeleton.getTransformConstraints().size(); i++)
+		description.add(skeleton.getTransformConstraints()[i]->isActive());
+	for (size_t i = 0; i < skeleton.getPathConstraints().size(); i++)
+		description.add(skeleton.getPathConstraints()[i]->isActive());
+}
+
+void testSharedUpdateOrders() {
+	printf("Testing shared update orders\n");
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+	Skeleton *computed = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	Skeleton *first = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	Skeleton *second = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+	const char *outfits[][5] = {{"full-skins/girl", NULL},
+								{"full-skins/boy", NULL},
+								{"skin-base", "clothes/dress-blue", "accessories/cape-blue", "hair/long-blue-with-scarf", NULL},
+								{"skin-base", "clothes/hoodie-orange", "legs/pants-jeans", "accessories/bag", NULL},
+								{"skin-base", "clothes/dress-green", "accessories/hat-red-yellow", "legs/boots-red", NULL}};
+	Vector<Skin *> skins;
+	Vector<int> expected, actual;
+	for (int i = 0; i < 5; i++) {
+		// The same outfit is a new skin for each skeleton, like equipment composed at runtime.
+		Skin *outfits3[3];
+		for (int ii = 0; ii < 3; ii++) {
+			outfits3[ii] = new (__FILE__, __LINE__) Skin("outfit");
+			for (int iii = 0; outfits[i][iii]; iii++)
+				outfits3[ii]->addSkin(skeletonData->findSkin(outfits[i][iii]));
+			skins.add(outfits3[ii]);
+		}
+
+		skeletonData->setShareUpdateOrders(false);
+		computed->setSkin(outfits3[0]);
+		describeUpdateCache(*computed, expected);
+		skeletonData->setShareUpdateOrders(true);
+
+		size_t updateOrders = skeletonData->getUpdateOrderCount();
+		first->setSkin(outfits3[1]);
+		assert(skeletonData->getUpdateOrderCount() == updateOrders + 1);
+		describeUpdateCache(*first, actual);
+		assert(actual == expected);
+		second->setSkin(outfits3[2]);
+		assert(skeletonData->getUpdateOrderCount() == updateOrders + 1);
+		describeUpdateCache(*second, actual);
+		assert(actual == expected);
+		SP_UNUSED(updateOrders);
+	}
+	// One more update order is shared by the skeletons without a skin.
+	assert(skeletonData->getUpdateOrderCount() == 6);
+
+	// Changing the attachments of a skin of the skeleton data discards the update orders.
+	Skin *skin = skeletonData->findSkin("skin-base");
+	Vector<Attachment *> attachments;
+	size_t slotIndex = 0;
+	while (attachments.size() == 0)
+		skin->findAttachmentsForSlot(slotIndex++, attachments);
+	Vector<String> names;
+	skin->findNamesForSlot(--slotIndex, names);
+	assert(names.size() == attachments.size());
+	skin->setAttachment(slotIndex, names[0], attachments[0]);
+	assert(skeletonData->getUpdateOrderCount() == 0);
+
+	delete second;
+	delete first;
+	delete computed;
+	for (size_t i = 0; i < skins.size(); i++)
+		delete skins[i];
+	delete skeletonData;
+	delete atlas;
+
+	// The bones of a path attachment added to a skin of the skeleton data are sorted before its path constraint, even
+	// if the skeleton's skin doesn't have it.
+	atlas = new (__FILE__, __LINE__) Atlas("testdata/tank/tank.atlas", NULL);
+	SkeletonBinary tankBinary(atlas);
+	skeletonData = tankBinary.readSkeletonDataFile("testdata/tank/tank-pro.skel");
+	assert(skeletonData && skeletonData->getPathConstraints().size() > 0);
+	Skin *dataSkin = new (__FILE__, __LINE__) Skin("data skin");
+	skeletonData->getSkins().add(dataSkin);
+	Skeleton skeleton(skeletonData);
+	PathConstraint *constraint = skeleton.getPathConstraints()[0];
+	Vector<Updatable *> &updateCache = skeleton.getUpdateCacheList();
+	size_t constraintIndex = updateCache.indexOf(constraint);
+	// A bone after the constraint which isn't constrained by it, nor a descendant of a constrained bone.
+	Bone *unconstrained = NULL;
+	for (size_t i = constraintIndex + 1; i < updateCache.size() && !unconstrained; i++) {
+		if (!updateCache[i]->getRTTI().isExactly(Bone::rtti)) continue;
+		Bone *bone = static_cast<Bone *>(updateCache[i]);
+		Bone *ancestor = bone;
+		while (ancestor && !constraint->getBones().contains(ancestor))
+			ancestor = ancestor->getParent();
+		if (!ancestor) unconstrained = bone;
+	}
+	assert(unconstrained);
+	PathAttachment *path = new (__FILE__, __LINE__) PathAttachment("added path");
+	path->getBones().add(1);
+	path->getBones().add(unconstrained->getData().getIndex());
+	path->getVertices().add(0);
+	path->getVertices().add(0);
+	path->getVertices().add(1);
+	dataSkin->setAttachment(constraint->getTarget()->getData().getIndex(), "added path", path);
+	Skin *empty = new (__FILE__, __LINE__) Skin("empty");
+	skeleton.setSkin(empty);
+	assert(updateCache.indexOf(unconstrained) < updateCache.indexOf(constraint));
+	skeleton.setSkin((Skin *) NULL);
+	delete empty;
+	delete skeletonData;
+	delete atlas;
+}
+
 int main(int argc, char **argv) {
 	SP_UNUSED(argc);
 	SP_UNUSED(argv);
-	DebugExtension debug(SpineExtension::getInstance());
+	SpineExtension *extension = SpineExtension::getInstance();
+	DebugExtension debug(extension);
 	SpineExtension::setInstance(&debug);
 
 	testLoading();
+	testTimelineSearch();
+	testBatchUpdate();
+	testWeightedVertices();
+	testSkeletonUpdateBatch();
+	testNameLookup();
+	testHashMap();
+	testBinaryLoading();
+	testArena();
+	testTrig();
+	testSkeletonRenderer();
+	testAnimationBaker();
+	testLazyAnimations();
+	testParallelLoading();
+	testDeformTimeline();
+	testDeformGolden();
+	testJsonParsing();
+	testProfiler();
+	testZeroAllocationAnimationState(debug);
+	testTimelinePlan();
+	testClipping();
+	testSkeletonPose();
+	testSkeletonLod();
+	testPathConstraintCache();
+	testAttachmentKeys();
+	testSharedUpdateOrders();
 
 	debug.reportLeaks();
+	SpineExtension::setInstance(extension);
 }
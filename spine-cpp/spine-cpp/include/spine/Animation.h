@@ -56,6 +56,8 @@ namespace spine {
 
 		friend class AttachmentTimeline;
 
+		friend class CurveTimeline1;
+
 		friend class RGBATimeline;
 
 		friend class RGBTimeline;
@@ -102,6 +104,10 @@ namespace spine {
 
 		friend class RootMotionYTimeline;
 
+		friend class SkeletonBinary;
+
+		friend class SkeletonData;
+
 	public:
 		Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
@@ -116,7 +122,7 @@ namespace spine {
 
 		Vector<Timeline *> &getTimelines();
 
-		bool hasTimeline(Vector<PropertyId> ids);
+		bool hasTimeline(Vector<PropertyId> &ids);
 
 		float getDuration();
 
@@ -128,9 +134,14 @@ namespace spine {
 		float _duration;
 		String _name;
 
+		/// Deletes the current timelines and replaces them, used to decode and evict lazily loaded animations.
+		void setTimelines(Vector<Timeline *> &timelines);
+
+		/// Binary search for the frame before target, so lookups are O(log n) in the number of keys.
 		/// @param target After the first and before the last entry.
 		static int search(Vector<float> &values, float target);
 
+		/// Like search(Vector<float>&, float), but only considers every step-th value (the frame times).
 		static int search(Vector<float> &values, float target, int step);
 	};
 }
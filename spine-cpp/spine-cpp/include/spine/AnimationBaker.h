@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AnimationBaker_h
+#define Spine_AnimationBaker_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class Skeleton;
+
+	class Skin;
+
+	class Animation;
+
+	class BakedAnimation;
+
+	/// Samples animations at a fixed rate into BakedAnimations. Each sample is taken by applying the animation over the
+	/// setup pose and updating the world transform of a skeleton owned by the baker, so constraints are solved while
+	/// baking rather than during playback.
+	class SP_API AnimationBaker : public SpineObject {
+	public:
+		explicit AnimationBaker(SkeletonData *skeletonData);
+
+		~AnimationBaker();
+
+		/// Sets the skin used to look up attachments while baking. Baked animations must be played on skeletons using
+		/// the same skin.
+		/// @param skin May be NULL.
+		void setSkin(Skin *skin);
+
+		/// Sets the scale of the skeleton while baking, 1 by default. Bones with transform modes that don't inherit
+		/// rotation or scale depend non-linearly on the skeleton's scale, so skeletons with such bones should be played
+		/// back with the scale they were baked with, e.g. mirrored skeletons with a separate bake using a scale of -1.
+		void setScale(float scaleX, float scaleY);
+
+		/// Bakes the animation from time 0 to its duration, inclusive.
+		/// @param sampleRate The number of samples per second.
+		/// @return The baked animation, owned by the caller.
+		BakedAnimation *bake(Animation &animation, float sampleRate = 30);
+
+	private:
+		SkeletonData *_skeletonData;
+		Skeleton *_skeleton;
+	};
+}
+
+#endif /* Spine_AnimationBaker_h */
@@ -69,6 +69,8 @@ namespace spine {
 
 	class AttachmentTimeline;
 
+	class Timeline;
+
 #ifdef SPINE_USE_STD_FUNCTION
 	typedef std::function<void (AnimationState* state, EventType type, TrackEntry* entry, Event* event)> AnimationStateListener;
 #else
@@ -292,11 +294,24 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry *> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+
+		/// The animation's timelines grouped into runs of attachment, rotate, other, draw order and deform timelines, so
+		/// they are applied in homogeneous loops. See AnimationState::computePlan().
+		Vector<Timeline *> _timelinePlan;
+		/// The index in the animation of each timeline in the plan.
+		Vector<int> _timelinePlanIndex;
+		/// The mode of each timeline in the plan.
+		Vector<int> _timelinePlanMode;
+		/// The start of each run in the plan, followed by the size of the plan.
+		size_t _timelinePlanRuns[6];
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
 		int _rootMotionID;
 
 		void reset();
+
+		/// Ensures the buffers for the timelines can hold the specified number of timelines without allocating.
+		void reserveTimelines(size_t timelineCount);
 	};
 
 	class SP_API EventQueueEntry : public SpineObject {
@@ -314,7 +329,9 @@ namespace spine {
 		friend class AnimationState;
 
 	private:
+		/// A ring buffer of the queued entries starting at _head, which only grows when it is full.
 		Vector<EventQueueEntry> _eventQueueEntries;
+		size_t _head, _count;
 		AnimationState &_state;
 		Pool<TrackEntry> &_trackEntryPool;
 		bool _drainDisabled;
@@ -327,6 +344,8 @@ namespace spine {
 
 		~EventQueue();
 
+		void add(const EventQueueEntry &entry);
+
 		void start(TrackEntry *entry);
 
 		void interrupt(TrackEntry *entry);
@@ -375,6 +394,10 @@ namespace spine {
 		TrackEntry *setAnimation(size_t trackIndex, const String &animationName, bool loop);
 
 		/// Sets the current animation for a track, discarding any queued animations.
+		///
+		/// A lazily loaded animation is decoded if it wasn't yet, see SkeletonData::prefetchAnimation(). Decoding holds a
+		/// lock of the skeleton data, so animation states of skeletons sharing the data may set animations on different
+		/// threads.
 		/// @param loop If true, the animation will repeat.
 		/// If false, it will not, instead its last frame is applied if played beyond its duration.
 		/// In either case TrackEntry.TrackEnd determines when the track is cleared.
@@ -388,7 +411,8 @@ namespace spine {
 		TrackEntry *addAnimation(size_t trackIndex, const String &animationName, bool loop, float delay);
 
 		/// Adds an animation to be played delay seconds after the current or last queued animation
-		/// for a track. If the track is empty, it is equivalent to calling setAnimation.
+		/// for a track. If the track is empty, it is equivalent to calling setAnimation. Like setAnimation, decodes a lazily
+		/// loaded animation if it wasn't yet.
 		/// @param delay
 		/// Seconds to begin this animation after the start of the previous animation. May be &lt;= 0 to use the animation
 		/// duration of the previous track minus any mix duration plus the negative delay.
@@ -426,6 +450,12 @@ namespace spine {
 
 		void setTimeScale(float inValue);
 
+		/// If true, deform timelines are not applied, so slots keep their current deform. Lowers the cost of applying
+		/// animations for skeletons too small on screen for mesh deformation to be visible. Default is false.
+		bool getFreezeDeform();
+
+		void setFreezeDeform(bool inValue);
+
 		void setListener(AnimationStateListener listener);
 
 		void setListener(AnimationStateListenerObject *listener);
@@ -444,6 +474,13 @@ namespace spine {
 		static const int Setup = 1;
 		static const int Current = 2;
 
+		static const int PlanAttachment = 0;
+		static const int PlanRotate = 1;
+		static const int PlanOther = 2;
+		static const int PlanDrawOrder = 3;
+		static const int PlanDeform = 4;
+		static const int PlanRunCount = 5;
+
 		AnimationStateData *_data;
 
 		Pool<TrackEntry> _trackEntryPool;
@@ -453,6 +490,8 @@ namespace spine {
 
 		HashMap<PropertyId, bool> _propertyIDs;
 		bool _animationsChanged;
+		/// The most timelines of the animations set so far, which the buffers of new track entries are sized for.
+		size_t _timelineCapacity;
 
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
@@ -461,6 +500,8 @@ namespace spine {
 
 		float _timeScale;
 
+		bool _freezeDeform;
+
 		static Animation *getEmptyAnimation();
 
 		static void
@@ -493,7 +534,17 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
-		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
+		/// Groups the entry's timelines by kind, keeping their order within each kind, and stores the timeline modes from
+		/// computeHold() in plan order.
+		void computePlan(TrackEntry *entry);
+
+		/// Returns the alpha of the timeline at the given plan index of an entry being mixed out and sets the blend it is
+		/// applied with.
+		static float getMixingFromAlpha(TrackEntry *from, size_t i, MixBlend blend, float alphaMix, float alphaHold,
+										MixBlend &timelineBlend);
+
+		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, int attachmentKey,
+						   bool attachments);
 	};
 }
 
@@ -76,6 +76,8 @@ namespace spine {
 			explicit AnimationPair(Animation *a1 = NULL, Animation *a2 = NULL);
 
 			bool operator==(const AnimationPair &other) const;
+
+			size_t hash() const;
 		};
 
 		SkeletonData *_skeletonData;
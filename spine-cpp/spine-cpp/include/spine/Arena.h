@@ -0,0 +1,172 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_Arena_h
+#define Spine_Arena_h
+
+#include <spine/Extension.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	/// Hands out memory from a few large blocks, so objects allocated together are laid out contiguously, and releases
+	/// all of it at once when the arena is deleted. Freeing memory of an arena does nothing, except for the most recent
+	/// allocation, which is given back to the arena.
+	///
+	/// An arena only backs allocations made in an ArenaScope while an ArenaExtension is installed. Memory allocated from
+	/// an arena must not be used after the arena is deleted. An arena must only be used by one thread at a time.
+	class SP_API Arena : public SpineObject {
+		friend class ArenaExtension;
+
+		friend class ArenaScope;
+
+	public:
+		/// @param blockSize The size of the first block. Each further block is twice as large as the one before, up to
+		/// 1 MB.
+		explicit Arena(size_t blockSize = 16 * 1024);
+
+		~Arena();
+
+		/// Deletes the arena. If it is the arena of an ArenaScope, it is deleted when that scope ends instead, so an object
+		/// can release its arena while memory of the arena is still used in the scope.
+		static void dispose(Arena *arena);
+
+		/// The arena allocations on the calling thread come from, or NULL.
+		static Arena *getCurrent();
+
+		/// The bytes handed out by the arena.
+		size_t getUsedMemory() { return _usedMemory; }
+
+		/// The bytes of all blocks of the arena.
+		size_t getReservedMemory() { return _reservedMemory; }
+
+		size_t getBlockCount() { return _blockCount; }
+
+	private:
+		struct Block {
+			Block *next;
+			size_t size;
+			size_t used;
+		};
+
+		SpineExtension *_extension;
+		Block *_blocks;
+		size_t _blockSize;
+		size_t _blockCount;
+		size_t _usedMemory;
+		size_t _reservedMemory;
+		int _scopes;
+		bool _disposed;
+
+		void *alloc(size_t size, SpineExtension *extension);
+
+		/// Resizes the most recent allocation in place. Returns false if mem isn't the most recent allocation or the block
+		/// has no room left.
+		bool resize(void *mem, size_t size, size_t newSize);
+
+		void free(void *mem, size_t size);
+
+		Arena(const Arena &);
+
+		Arena &operator=(const Arena &);
+	};
+
+	/// Makes allocations on the calling thread come from an arena until the scope ends. Scopes can be nested, the
+	/// innermost scope decides. A scope with a NULL arena allocates from the wrapped extension of the ArenaExtension,
+	/// for example for memory that has to outlive the arena of an enclosing scope.
+	class SP_API ArenaScope {
+	public:
+		explicit ArenaScope(Arena *arena);
+
+		~ArenaScope();
+
+	private:
+		Arena *_arena;
+		Arena *_previous;
+
+		ArenaScope(const ArenaScope &);
+
+		ArenaScope &operator=(const ArenaScope &);
+	};
+
+	/// Owns the arena the members of an object are allocated from. Declared as the first member of the object, the arena
+	/// is released after all other members are destroyed.
+	class SP_API ArenaOwner {
+	public:
+		ArenaOwner() : _arena(NULL) {
+		}
+
+		~ArenaOwner() {
+			Arena::dispose(_arena);
+		}
+
+		/// Creates the arena, if it doesn't exist yet.
+		Arena *create(size_t blockSize = 16 * 1024);
+
+		Arena *get() { return _arena; }
+
+	private:
+		Arena *_arena;
+
+		ArenaOwner(const ArenaOwner &);
+
+		ArenaOwner &operator=(const ArenaOwner &);
+	};
+
+	/// Wraps another extension so allocations can come from the arena of the current ArenaScope. Every allocation is
+	/// prefixed with a small header telling where its memory came from, so memory of arenas and of the wrapped extension
+	/// can be freed and reallocated alike.
+	///
+	/// The extension must be installed before anything it frees is allocated, usually at startup. Allocations outside
+	/// of any ArenaScope are forwarded to the wrapped extension and can be made from any thread.
+	class SP_API ArenaExtension : public SpineExtension {
+	public:
+		explicit ArenaExtension(SpineExtension *extension);
+
+		virtual ~ArenaExtension();
+
+		virtual void *_alloc(size_t size, const char *file, int line) override;
+
+		virtual void *_calloc(size_t size, const char *file, int line) override;
+
+		virtual void *_realloc(void *ptr, size_t size, const char *file, int line) override;
+
+		virtual void _free(void *mem, const char *file, int line) override;
+
+		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual const char *_mapFile(const String &path, int *length) override;
+
+		virtual void _unmapFile(const char *data, int length) override;
+
+	private:
+		SpineExtension *_extension;
+	};
+}
+
+#endif /* Spine_Arena_h */
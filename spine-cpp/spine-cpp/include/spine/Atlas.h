@@ -32,6 +32,7 @@
 
 #include <spine/Vector.h>
 #include <spine/Extension.h>
+#include <spine/NameIndex.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/HasRendererObject.h>
@@ -111,8 +112,7 @@ namespace spine {
 
 		void flipV();
 
-		/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-		/// should be cached rather than calling this method multiple times.
+		/// Returns the first region found with the specified name, using a hash index of the region names.
 		/// @return The region, or NULL.
 		AtlasRegion *findRegion(const String &name);
 
@@ -120,9 +120,20 @@ namespace spine {
 
 		Vector<AtlasRegion *> &getRegions();
 
+		/// Indexes the region names again. findRegion() only finds indexed regions, so this must be called after regions
+		/// are added to, replaced in or removed from getRegions().
+		void rebuildRegionIndex();
+
 	private:
+		struct RegionName {
+			static const String &get(AtlasRegion *region) {
+				return region->name;
+			}
+		};
+
 		Vector<AtlasPage *> _pages;
 		Vector<AtlasRegion *> _regions;
+		NameIndex<AtlasRegion, RegionName> _regionIndex;
 		TextureLoader *_textureLoader;
 
 		void load(const char *begin, int length, const char *dir, bool createTexture);
@@ -50,6 +50,8 @@ namespace spine {
 
 		friend class SkeletonJson;
 
+		friend class SkeletonData;
+
 	RTTI_DECL
 
 	public:
@@ -66,16 +68,22 @@ namespace spine {
 
 		Vector<String> &getAttachmentNames();
 
+		/// The attachment key of each frame's attachment name, see SkeletonData::findAttachmentKey(), or -1 if the name is
+		/// empty or has no key. Frames without a key find their attachment by name.
+		Vector<int> &getAttachmentKeys();
+
 		int getSlotIndex() { return _slotIndex; }
 
-		void setSlotIndex(int inValue) { _slotIndex = inValue; }
+		void setSlotIndex(int inValue);
 
 	protected:
 		int _slotIndex;
 
 		Vector<String> _attachmentNames;
 
-		void setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName);
+		Vector<int> _attachmentKeys;
+
+		void setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, int attachmentKey);
 	};
 }
 
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BakedAnimation_h
+#define Spine_BakedAnimation_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class Attachment;
+
+	/// An animation sampled at a fixed rate into world transforms, see AnimationBaker. Applying a baked animation poses a
+	/// skeleton without applying timelines, updating bones or solving constraints, which makes it cheap to play the same
+	/// animation on many skeletons.
+	///
+	/// For each sample the world transform of every bone, the color, dark color and attachment of every slot, the draw
+	/// order and the deform of slots keyed by the animation are stored. Colors are stored with 8 bits per channel.
+	/// Events are not baked.
+	class SP_API BakedAnimation : public SpineObject {
+		friend class AnimationBaker;
+
+	public:
+		~BakedAnimation();
+
+		/// Sets the world transform of the skeleton's bones and the color, attachment, deform and draw order of its slots
+		/// to the baked pose at the given time. The skeleton's position is applied to the baked world transforms, so one
+		/// baked animation can be played on skeletons placed anywhere. The skeleton's scale is applied relative to the
+		/// scale it was baked with. This is exact for bones which inherit rotation and scale, but bones with other
+		/// transform modes are only exact if the skeleton has the scale the animation was baked with, see
+		/// AnimationBaker::setScale().
+		///
+		/// The skeleton must be created from the skeleton data the animation was baked from and use the same skin.
+		/// Skeleton::updateWorldTransform() must not be called afterward, it would replace the baked pose.
+		/// @param loop If true, the time wraps around the duration of the animation.
+		/// @param interpolate If true, bone world transforms, colors and deform are interpolated linearly between the two
+		/// samples around the time. Otherwise the previous sample is used. Attachments and draw order are never
+		/// interpolated.
+		void apply(Skeleton &skeleton, float time, bool loop, bool interpolate);
+
+		const String &getName();
+
+		float getDuration();
+
+		/// The number of samples per second.
+		float getSampleRate();
+
+		size_t getFrameCount();
+
+		/// The number of bytes used by the baked animation.
+		size_t getMemoryUsage();
+
+	private:
+		BakedAnimation(const String &name, float duration, float sampleRate, size_t frameCount, size_t boneCount,
+					   size_t slotCount);
+
+		/// Sizes the frame arrays once the deform slots are known.
+		void allocate(bool darkColors, bool drawOrder);
+
+		/// Stores the current pose of the skeleton as the given frame.
+		void record(Skeleton &skeleton, size_t frame);
+
+		String _name;
+		float _duration;
+		float _sampleRate;
+		size_t _frameCount;
+		size_t _boneCount;
+		size_t _slotCount;
+
+		/// The skeleton's scale while baking, as returned by Skeleton::getScaleX() and Skeleton::getScaleY(). The y scale
+		/// already includes the negation Skeleton::getScaleY() applies when Bone::isYDown() is true.
+		float _scaleX, _scaleY;
+
+		/// Per frame and bone: a, b, c, d, worldX and worldY, relative to the skeleton's position and scale.
+		Vector<float> _bones;
+
+		/// Per frame and slot, packed as 0xAARRGGBB.
+		Vector<unsigned int> _colors;
+
+		/// Per frame and slot, empty if no slot has a dark color.
+		Vector<unsigned int> _darkColors;
+
+		/// Per frame and slot.
+		Vector<Attachment *> _attachments;
+
+		/// Per frame, the slot index of each draw order entry. Empty if the animation doesn't key the draw order.
+		Vector<int> _drawOrder;
+
+		/// The indices of slots keyed by deform timelines.
+		Vector<int> _deformSlots;
+
+		/// Per frame and deform slot, the start of its deform in _deform, followed by the total size of _deform. The
+		/// size of a deform is the difference to the next start.
+		Vector<size_t> _deformStarts;
+
+		Vector<float> _deform;
+	};
+}
+
+#endif /* Spine_BakedAnimation_h */
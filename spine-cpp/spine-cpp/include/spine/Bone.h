@@ -31,6 +31,7 @@
 #define Spine_Bone_h
 
 #include <spine/Updatable.h>
+#include <spine/BonePose.h>
 #include <spine/SpineObject.h>
 #include <spine/Vector.h>
 
@@ -51,6 +52,8 @@ namespace spine {
 
 		friend class IkConstraint;
 
+		friend class SkeletonPose;
+
 		friend class TransformConstraint;
 
 		friend class VertexAttachment;
@@ -267,6 +270,12 @@ namespace spine {
 		bool _sorted;
 		bool _active;
 
+		/// Stores the BonePose_Count values of the pose in BonePose order.
+		void getPose(float *pose);
+
+		/// Sets the pose from BonePose_Count values in BonePose order.
+		void setPose(const float *pose);
+
 		/// Computes the individual applied transform values from the world transform. This can be useful to perform processing using
 		/// the applied transform after the world transform has been modified directly (eg, by a constraint)..
 		///
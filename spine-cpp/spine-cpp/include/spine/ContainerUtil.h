@@ -33,6 +33,7 @@
 #include <spine/Extension.h>
 #include <spine/Vector.h>
 #include <spine/HashMap.h>
+#include <spine/NameIndex.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 
@@ -58,6 +59,16 @@ namespace spine {
 			return NULL;
 		}
 
+		/// Finds an item by name with an index, see NameIndex. Finding doesn't modify the index.
+		/// @return May be NULL.
+		template<typename T>
+		static T *findWithName(Vector<T *> &items, NameIndex<T> &index, const String &name) {
+			assert(name.length() > 0);
+
+			int i = index.find(items, name);
+			return i == -1 ? NULL : items[i];
+		}
+
 		/// @return -1 if the item was not found.
 		template<typename T>
 		static int findIndexWithName(Vector<T *> &items, const String &name) {
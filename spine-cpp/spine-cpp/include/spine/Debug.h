@@ -34,9 +34,11 @@
 #include <spine/Vector.h>
 
 #include <map>
+#include <mutex>
 
 namespace spine {
 
+	/// Tracks allocations to report leaks. Can be used while skeletons are updated on several threads.
 	class SP_API DebugExtension : public SpineExtension {
 		struct Allocation {
 			void *address;
@@ -57,6 +59,7 @@ namespace spine {
 		}
 
 		void reportLeaks() {
+			std::lock_guard<std::mutex> lock(_mutex);
 			for (std::map<void *, Allocation>::iterator it = _allocated.begin(); it != _allocated.end(); it++) {
 				printf("\"%s:%i (%zu bytes at %p)\n", it->second.fileName, it->second.line, it->second.size,
 					   it->second.address);
@@ -66,11 +69,13 @@ namespace spine {
 		}
 
 		void clearAllocations() {
+			std::lock_guard<std::mutex> lock(_mutex);
 			_allocated.clear();
 			_usedMemory = 0;
 		}
 
 		virtual void *_alloc(size_t size, const char *file, int line) {
+			std::lock_guard<std::mutex> lock(_mutex);
 			void *result = _extension->_alloc(size, file, line);
 			_allocated[result] = Allocation(result, size, file, line);
 			_allocations++;
@@ -79,6 +84,7 @@ namespace spine {
 		}
 
 		virtual void *_calloc(size_t size, const char *file, int line) {
+			std::lock_guard<std::mutex> lock(_mutex);
 			void *result = _extension->_calloc(size, file, line);
 			_allocated[result] = Allocation(result, size, file, line);
 			_allocations++;
@@ -87,6 +93,7 @@ namespace spine {
 		}
 
 		virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
+			std::lock_guard<std::mutex> lock(_mutex);
 			if (_allocated.count(ptr)) _usedMemory -= _allocated[ptr].size;
 			_allocated.erase(ptr);
 			void *result = _extension->_realloc(ptr, size, file, line);
@@ -97,6 +104,7 @@ namespace spine {
 		}
 
 		virtual void _free(void *mem, const char *file, int line) {
+			std::lock_guard<std::mutex> lock(_mutex);
 			if (_allocated.count(mem)) {
 				_extension->_free(mem, file, line);
 				_frees++;
@@ -113,10 +121,29 @@ namespace spine {
 			return _extension->_readFile(path, length);
 		}
 
+		virtual const char *_mapFile(const String &path, int *length) {
+			return _extension->_mapFile(path, length);
+		}
+
+		virtual void _unmapFile(const char *data, int length) {
+			_extension->_unmapFile(data, length);
+		}
+
 		size_t getUsedMemory() {
+			std::lock_guard<std::mutex> lock(_mutex);
 			return _usedMemory;
 		}
 
+		size_t getAllocations() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _allocations;
+		}
+
+		size_t getReallocations() {
+			std::lock_guard<std::mutex> lock(_mutex);
+			return _reallocations;
+		}
+
 	private:
 		SpineExtension *_extension;
 		std::map<void *, Allocation> _allocated;
@@ -124,6 +151,7 @@ namespace spine {
 		size_t _reallocations;
 		size_t _frees;
 		size_t _usedMemory;
+		std::mutex _mutex;
 	};
 }
 
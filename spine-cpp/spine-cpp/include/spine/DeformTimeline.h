@@ -35,6 +35,9 @@
 namespace spine {
 	class VertexAttachment;
 
+	/// Changes the vertices of a slot's attachment. Each frame keeps only the range of vertices it moves, as offsets from
+	/// the setup pose vertices of the attachment, or from zero for weighted attachments. The offsets are stored as floats,
+	/// or as 16 bit integers after quantize().
 	class SP_API DeformTimeline : public CurveTimeline {
 		friend class SkeletonBinary;
 
@@ -49,13 +52,33 @@ namespace spine {
 		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 			  MixDirection direction);
 
-		/// Sets the time and value of the specified keyframe.
+		/// Sets the time and vertices of the specified keyframe. Only the range of vertices that differ from the setup
+		/// pose is kept. Each frame must be set once, before quantize() is called.
+		/// @param vertices Vertex positions for an unweighted attachment, or deform offsets for a weighted attachment.
 		void setFrame(int frameIndex, float time, Vector<float> &vertices);
 
-		Vector <Vector<float>> &getVertices();
+		/// Computes the vertices of the specified keyframe: vertex positions for an unweighted attachment, or deform
+		/// offsets for a weighted attachment.
+		void getFrameVertices(size_t frameIndex, Vector<float> &vertices);
+
+		/// The vertices of each keyframe, computed the first time they are needed after the frames or the attachment
+		/// change. Changing the returned vertices doesn't change the timeline, use setFrame().
+		Vector<Vector<float> > &getVertices();
+
+		/// The number of vertex values of each frame, 2 per vertex for weighted attachments.
+		size_t getVertexCount() { return _vertexCount; }
+
+		/// Stores the offsets as 16 bit integers, scaled per frame. Each offset changes by at most half the largest offset
+		/// of its frame divided by 32767.
+		void quantize();
+
+		bool isQuantized() { return _scales.size() > 0; }
 
 		VertexAttachment *getAttachment();
 
+		/// Sets the attachment whose setup vertices the frames are stored relative to. The frames keep their vertices,
+		/// they are stored again relative to the new attachment's setup vertices. If the new attachment has a different
+		/// number of vertices, the vertices of each frame are cut or extended with the new setup vertices.
 		void setAttachment(VertexAttachment *inValue);
 
 		virtual void
@@ -71,9 +94,28 @@ namespace spine {
 	protected:
 		int _slotIndex;
 
-		Vector <Vector<float>> _vertices;
-
 		VertexAttachment *_attachment;
+
+		size_t _vertexCount;
+
+		/// For each frame, the first and end vertex of its offsets, and the index of its first offset.
+		Vector<unsigned int> _ranges;
+
+		Vector<float> _offsets;
+
+		/// Replace _offsets once quantized, each frame's offsets are multiplied by the frame's scale.
+		Vector<short> _quantizedOffsets;
+
+		Vector<float> _scales;
+
+		/// The vertices of each frame returned by getVertices(), or empty.
+		Vector<Vector<float> > _vertices;
+
+		/// Sets the range of a frame's offsets and returns where to store them.
+		float *setFrameRange(int frame, size_t start, size_t end);
+
+		/// Stores the range of a frame's vertices that differ from the setup vertices of the attachment.
+		void setFrameOffsets(int frame, Vector<float> &vertices);
 	};
 }
 
@@ -34,6 +34,8 @@
 #include <stdlib.h>
 #include <spine/dll.h>
 
+#include <atomic>
+
 #define SP_UNUSED(x) (void)(x)
 
 namespace spine {
@@ -70,6 +72,15 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		/// Maps a file into memory for reading. The returned data must be released with unmapFile().
+		static const char *mapFile(const String &path, int *length) {
+			return getInstance()->_mapFile(path, length);
+		}
+
+		static void unmapFile(const char *data, int length) {
+			getInstance()->_unmapFile(data, length);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -88,13 +99,18 @@ namespace spine {
 
 		virtual char *_readFile(const String &path, int *length) = 0;
 
+		/// Override to map files without copying them. The default implementation reads the file with _readFile().
+		virtual const char *_mapFile(const String &path, int *length);
+
+		virtual void _unmapFile(const char *data, int length);
+
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
 	protected:
 		SpineExtension();
 
 	private:
-		static SpineExtension *_instance;
+		static std::atomic<SpineExtension *> _instance;
 	};
 
 	class SP_API DefaultSpineExtension : public SpineExtension {
@@ -113,6 +129,11 @@ namespace spine {
 		virtual void _free(void *mem, const char *file, int line) override;
 
 		virtual char *_readFile(const String &path, int *length) override;
+
+		/// Maps the file with mmap where available, so loading doesn't copy it into an allocation.
+		virtual const char *_mapFile(const String &path, int *length) override;
+
+		virtual void _unmapFile(const char *data, int length) override;
 	};
 
 // This function is to be implemented by engine specific runtimes to provide
@@ -33,6 +33,7 @@
 #include <spine/Extension.h>
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
+#include <spine/SpineString.h>
 
 // Required for new with line number and file name in MSVC
 #ifdef _MSC_VER
@@ -40,6 +41,34 @@
 #endif
 
 namespace spine {
+	/// Hashes integer keys such as PropertyId. All bits are mixed, so keys that only differ in their high bits, like
+	/// property IDs of different properties of the same bone, don't collide.
+	inline size_t hashKey(long long key) {
+		unsigned long long hash = (unsigned long long) key;
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+		hash *= 0xc4ceb9fe1a85ec53ULL;
+		hash ^= hash >> 33;
+		return (size_t) hash;
+	}
+
+	inline size_t hashKey(int key) {
+		return hashKey((long long) key);
+	}
+
+	inline size_t hashKey(const String &key) {
+		return key.hash();
+	}
+
+	/// Other keys provide a hash() method consistent with their operator==.
+	template<typename K>
+	inline size_t hashKey(const K &key) {
+		return key.hash();
+	}
+
+	/// An open addressing hash table with linear probing. Storage is kept when the map is cleared, so maps that are
+	/// refilled often don't allocate.
 	template<typename K, typename V>
 	class SP_API HashMap : public SpineObject {
 	private:
@@ -58,47 +87,57 @@ namespace spine {
 		public:
 			friend class HashMap;
 
-			explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-				_start.next = entry;
-				_entry = &_start;
-			}
-
 			Pair next() {
-				assert(_entry);
 				assert(_hasChecked);
-				_entry = _entry->next;
-				Pair pair(_entry->_key, _entry->_value);
+				assert(_index < _capacity);
+				Entry &entry = _entries[_index++];
+				Pair pair(entry._key, entry._value);
 				_hasChecked = false;
 				return pair;
 			}
 
 			bool hasNext() {
 				_hasChecked = true;
-				return _entry->next;
+				while (_index < _capacity && _hashes[_index] == 0)
+					_index++;
+				return _index < _capacity;
 			}
 
 		private:
+			explicit Entries(size_t *hashes, Entry *entries, size_t capacity) : _hashes(hashes), _entries(entries),
+																				_capacity(capacity), _index(0),
+																				_hasChecked(false) {
+			}
+
+			size_t *_hashes;
+			Entry *_entries;
+			size_t _capacity;
+			size_t _index;
 			bool _hasChecked;
-			Entry _start;
-			Entry *_entry;
 		};
 
 		HashMap() :
-				_head(NULL),
+				_hashes(NULL),
+				_entries(NULL),
+				_capacity(0),
 				_size(0) {
 		}
 
 		~HashMap() {
 			clear();
+			if (_hashes) {
+				SpineExtension::free(_hashes, __FILE__, __LINE__);
+				SpineExtension::free(_entries, __FILE__, __LINE__);
+			}
 		}
 
 		void clear() {
-			for (Entry *entry = _head; entry != NULL;) {
-				Entry *next = entry->next;
-				delete entry;
-				entry = next;
+			if (_size == 0) return;
+			for (size_t i = 0; i < _capacity; i++) {
+				if (_hashes[i] == 0) continue;
+				_entries[i].~Entry();
+				_hashes[i] = 0;
 			}
-			_head = NULL;
 			_size = 0;
 		}
 
@@ -107,26 +146,23 @@ namespace spine {
 		}
 
 		void put(const K &key, const V &value) {
-			Entry *entry = find(key);
-			if (entry) {
-				entry->_key = key;
-				entry->_value = value;
-			} else {
-				entry = new(__FILE__, __LINE__) Entry();
-				entry->_key = key;
-				entry->_value = value;
-
-				Entry *oldHead = _head;
-
-				if (oldHead) {
-					_head = entry;
-					oldHead->prev = entry;
-					entry->next = oldHead;
-				} else {
-					_head = entry;
-				}
-				_size++;
+			size_t hash = hashOf(key);
+			size_t index = find(key, hash);
+			if (index != _capacity) {
+				_entries[index]._key = key;
+				_entries[index]._value = value;
+				return;
 			}
+
+			// Grow at half capacity, which keeps probe sequences short.
+			if ((_size + 1) * 2 > _capacity) grow();
+			size_t mask = _capacity - 1;
+			index = hash & mask;
+			while (_hashes[index] != 0)
+				index = (index + 1) & mask;
+			new (_entries + index) Entry(key, value);
+			_hashes[index] = hash;
+			_size++;
 		}
 
 		bool addAll(Vector <K> &keys, const V &value) {
@@ -138,29 +174,33 @@ namespace spine {
 		}
 
 		bool containsKey(const K &key) {
-			return find(key) != NULL;
+			return find(key, hashOf(key)) != _capacity;
 		}
 
 		bool remove(const K &key) {
-			Entry *entry = find(key);
-			if (!entry) return false;
-
-			Entry *prev = entry->prev;
-			Entry *next = entry->next;
-
-			if (prev) prev->next = next;
-			else _head = next;
-			if (next) next->prev = entry->prev;
-
-			delete entry;
+			size_t hole = find(key, hashOf(key));
+			if (hole == _capacity) return false;
+
+			// Move later entries of the probe sequence into the hole, so lookups never stop early at an empty slot.
+			_entries[hole].~Entry();
+			size_t mask = _capacity - 1;
+			for (size_t i = (hole + 1) & mask; _hashes[i] != 0; i = (i + 1) & mask) {
+				size_t home = _hashes[i] & mask;
+				if (((i - home) & mask) < ((i - hole) & mask)) continue;
+				new (_entries + hole) Entry(_entries[i]);
+				_hashes[hole] = _hashes[i];
+				_entries[i].~Entry();
+				hole = i;
+			}
+			_hashes[hole] = 0;
 			_size--;
 
 			return true;
 		}
 
 		V operator[](const K &key) {
-			Entry *entry = find(key);
-			if (entry) return entry->_value;
+			size_t index = find(key, hashOf(key));
+			if (index != _capacity) return _entries[index]._value;
 			else {
 				assert(false);
 				return 0;
@@ -168,29 +208,61 @@ namespace spine {
 		}
 
 		Entries getEntries() const {
-			return Entries(_head);
+			return Entries(_hashes, _entries, _capacity);
 		}
 
 	private:
-		Entry *find(const K &key) {
-			for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-				if (entry->_key == key)
-					return entry;
+		/// Hashes are never 0, which marks empty slots.
+		static size_t hashOf(const K &key) {
+			size_t hash = hashKey(key);
+			return hash != 0 ? hash : 1;
+		}
+
+		/// @return The index of the key, or _capacity if the key isn't in the map.
+		size_t find(const K &key, size_t hash) {
+			if (_size == 0) return _capacity;
+			size_t mask = _capacity - 1;
+			for (size_t i = hash & mask; _hashes[i] != 0; i = (i + 1) & mask) {
+				if (_hashes[i] == hash && _entries[i]._key == key) return i;
+			}
+			return _capacity;
+		}
+
+		void grow() {
+			size_t *oldHashes = _hashes;
+			Entry *oldEntries = _entries;
+			size_t oldCapacity = _capacity;
+
+			_capacity = _capacity == 0 ? 8 : _capacity << 1;
+			_hashes = SpineExtension::calloc<size_t>(_capacity, __FILE__, __LINE__);
+			_entries = SpineExtension::alloc<Entry>(_capacity, __FILE__, __LINE__);
+			size_t mask = _capacity - 1;
+			for (size_t i = 0; i < oldCapacity; i++) {
+				if (oldHashes[i] == 0) continue;
+				size_t index = oldHashes[i] & mask;
+				while (_hashes[index] != 0)
+					index = (index + 1) & mask;
+				new (_entries + index) Entry(oldEntries[i]);
+				_hashes[index] = oldHashes[i];
+				oldEntries[i].~Entry();
+			}
+			if (oldHashes) {
+				SpineExtension::free(oldHashes, __FILE__, __LINE__);
+				SpineExtension::free(oldEntries, __FILE__, __LINE__);
 			}
-			return NULL;
 		}
 
-		class SP_API Entry : public SpineObject {
+		class Entry {
 		public:
 			K _key;
 			V _value;
-			Entry *next;
-			Entry *prev;
 
-			Entry() : next(NULL), prev(NULL) {}
+			Entry(const K &key, const V &value) : _key(key), _value(value) {}
 		};
 
-		Entry *_head;
+		size_t *_hashes;
+		Entry *_entries;
+		size_t _capacity;
 		size_t _size;
 	};
 }
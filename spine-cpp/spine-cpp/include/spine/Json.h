@@ -51,7 +51,9 @@ namespace spine {
 		static const int JSON_ARRAY;
 		static const int JSON_OBJECT;
 
-		/* Get item "string" from object. Case insensitive. */
+		/* Get item "string" from object. Case insensitive. Objects with more than a few items are looked up through a hash
+		 * table built when they are parsed, smaller ones by comparing the hash of each item's name. If several items have
+		 * the name, the first is returned. */
 		static Json *getItem(Json *object, const char *string);
 
 		static Json *getItem(Json *object, int childIndex);
@@ -64,17 +66,21 @@ namespace spine {
 
 		static bool getBoolean(Json *object, const char *name, bool defaultValue);
 
-		/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
-		static const char *getError();
+		/* For analysing failed parses. This returns a pointer into the parsed text where parsing failed. You'll probably need to look a few chars back to make sense of it. NULL when the parse succeeded. Each parsed document has its own error, so documents can be parsed on several threads. */
+		const char *getError() { return _error; }
 
-		/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
+		/* Supply a block of JSON, and this returns a Json object you can interrogate. Delete it when finished. All items of the document are allocated in a few blocks owned by this object. */
 		explicit Json(const char *value);
 
 		~Json();
 
 
 	private:
-		static const char *_error;
+		struct Block {
+			Block *next;
+			size_t size;
+			size_t used;
+		};
 
 		Json *_next;
 #if SPINE_JSON_HAVE_PREV
@@ -90,24 +96,45 @@ namespace spine {
 		float _valueFloat; /* The item's number, if type==JSON_NUMBER */
 
 		const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+		unsigned int _hash; /* The case insensitive hash of the name, compared before the names when looking up an item. */
+		Json **_index; /* The children of an object with more than MinIndexedSize items by hash, open addressed, or NULL. */
+
+		Block *_blocks; /* The memory of the items and strings of the document, only set for the root. */
+		const char *_error; /* Where parsing failed, only set for the root. */
 
 		/* Utility to jump whitespace and cr/lf */
 		static const char *skip(const char *inValue);
 
-		/* Parser core - when encountering text, process appropriately. */
-		static const char *parseValue(Json *item, const char *value);
+		/* Allocates memory from the blocks of the document. Called on the root. */
+		void *alloc(size_t size);
+
+		Json *createItem();
+
+		/* Builds the hash table of an object's children. Called on the root. */
+		void indexObject(Json *item);
+
+		/* The number of entries in the hash table of an object with the given number of children, a power of two. */
+		static size_t indexCapacity(int size);
+
+		/* Parser core - when encountering text, process appropriately. The parse functions are called on the root. */
+		const char *parseValue(Json *item, const char *value);
 
 		/* Parse the input text into an unescaped cstring, and populate item. */
-		static const char *parseString(Json *item, const char *str);
+		const char *parseString(Json *item, const char *str);
 
 		/* Parse the input text to generate a number, and populate the result into item. */
-		static const char *parseNumber(Json *item, const char *num);
+		const char *parseNumber(Json *item, const char *num);
 
 		/* Build an array from input text. */
-		static const char *parseArray(Json *item, const char *value);
+		const char *parseArray(Json *item, const char *value);
 
 		/* Build an object from the text. */
-		static const char *parseObject(Json *item, const char *value);
+		const char *parseObject(Json *item, const char *value);
+
+		/* Parse the name of an object's item, and hash it. */
+		const char *parseName(Json *item, const char *value);
+
+		static unsigned int hash(const char *string);
 
 		static int json_strcasecmp(const char *s1, const char *s2);
 	};
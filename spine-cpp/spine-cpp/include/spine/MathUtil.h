@@ -36,6 +36,10 @@
 
 namespace spine {
 
+	/// The trigonometric functions use the C library in double precision by default. Define SPINE_FAST_TRIG (or set the
+	/// SPINE_FAST_TRIG CMake option) to use float polynomial approximations instead. Their sine and cosine have an
+	/// absolute error below 1e-7, atan2 below 3e-7 radians. Angles beyond +-8192 radians or +-1e8 degrees, infinity and
+	/// NaN fall back to the C library.
 	class SP_API MathUtil : public SpineObject {
 	private:
 		MathUtil();
@@ -58,20 +62,21 @@ namespace spine {
 
 		static float abs(float v);
 
-		/// Returns the sine in radians from a lookup table.
 		static float sin(float radians);
 
-		/// Returns the cosine in radians from a lookup table.
 		static float cos(float radians);
 
-		/// Returns the sine in radians from a lookup table.
+		/// Computes the sine and cosine of an angle in radians at once, for about the cost of one of them.
+		static void sincos(float radians, float &sine, float &cosine);
+
 		static float sinDeg(float degrees);
 
-		/// Returns the cosine in radians from a lookup table.
 		static float cosDeg(float degrees);
 
-		/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-		/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+		/// Computes the sine and cosine of an angle in degrees at once, for about the cost of one of them.
+		static void sincosDeg(float degrees, float &sine, float &cosine);
+
+		/// Returns atan2 in radians.
 		static float atan2(float y, float x);
 
 		static float acos(float v);
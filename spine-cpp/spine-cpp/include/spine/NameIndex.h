@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_NameIndex_h
+#define Spine_NameIndex_h
+
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	template<typename T>
+	struct ItemName {
+		static const String &get(T *item) {
+			return item->getName();
+		}
+	};
+
+	/// Finds items in a vector by name with an open addressing hash table of item indices. The index is built explicitly:
+	/// update() indexes items appended since the last update, rebuild() indexes the items again after items were removed
+	/// or replaced. Finding never modifies the index and only finds indexed items, a name missing from the index is not
+	/// searched for. A hit is verified against the item's name, so a stale entry is never returned. Debug builds assert
+	/// that a name not found isn't in the vector, which catches vectors changed without updating the index.
+	template<typename T, typename Name = ItemName<T> >
+	class SP_API NameIndex : public SpineObject {
+	public:
+		NameIndex() : _size(0), _count(0) {
+		}
+
+		/// Returns the index of the first item with the name, or -1.
+		int find(Vector<T *> &items, const String &name) {
+			if (_size > 0) {
+				Entry *entries = _entries.buffer();
+				size_t hash = name.hash(), mask = _entries.size() - 1;
+				for (size_t i = hash & mask;; i = (i + 1) & mask) {
+					Entry &entry = entries[i];
+					if (entry.index == -1) break;
+					if (entry.hash != hash || (size_t) entry.index >= items.size()) continue;
+					T *item = items[entry.index];
+					if (item && Name::get(item) == name) return entry.index;
+				}
+			}
+			assert(findLinear(items, name) == -1);
+			return -1;
+		}
+
+		/// Indexes the items appended since the last update. Items are indexed up to the first NULL item, so vectors
+		/// that are sized first and then filled in order can be indexed while they are being filled.
+		void update(Vector<T *> &items) {
+			for (size_t n = items.size(); _count < n && items[_count]; _count++)
+				add(items, _count);
+		}
+
+		/// Discards the index and indexes all items.
+		void rebuild(Vector<T *> &items) {
+			clear();
+			update(items);
+		}
+
+		void clear() {
+			Entry *entries = _entries.buffer();
+			for (size_t i = 0, n = _entries.size(); i < n; i++)
+				entries[i].index = -1;
+			_size = 0;
+			_count = 0;
+		}
+
+	private:
+		struct Entry {
+			size_t hash;
+			int index;
+		};
+
+		Vector<Entry> _entries;
+		size_t _size;
+		size_t _count;
+
+		static int findLinear(Vector<T *> &items, const String &name) {
+			for (size_t i = 0, n = items.size(); i < n; i++)
+				if (items[i] && Name::get(items[i]) == name) return (int) i;
+			return -1;
+		}
+
+		void add(Vector<T *> &items, size_t index) {
+			if ((_size + 1) * 2 > _entries.size()) grow();
+			const String &name = Name::get(items[index]);
+			Entry *entries = _entries.buffer();
+			size_t hash = name.hash(), mask = _entries.size() - 1;
+			for (size_t i = hash & mask;; i = (i + 1) & mask) {
+				Entry &entry = entries[i];
+				if (entry.index == -1) {
+					entry.hash = hash;
+					entry.index = (int) index;
+					_size++;
+					return;
+				}
+				// Keep the first item with the name, like a linear search would find.
+				if (entry.hash == hash && Name::get(items[entry.index]) == name) return;
+			}
+		}
+
+		void grow() {
+			Vector<Entry> old;
+			old.addAll(_entries);
+			Entry empty = {0, -1};
+			_entries.setSize(_entries.size() < 16 ? 16 : _entries.size() << 1, empty);
+			Entry *entries = _entries.buffer();
+			size_t mask = _entries.size() - 1;
+			for (size_t i = 0, n = _entries.size(); i < n; i++)
+				entries[i] = empty;
+			for (size_t i = 0, n = old.size(); i < n; i++) {
+				if (old[i].index == -1) continue;
+				size_t ii = old[i].hash & mask;
+				while (entries[ii].index != -1)
+					ii = (ii + 1) & mask;
+				entries[ii] = old[i];
+			}
+		}
+	};
+}
+
+#endif /* Spine_NameIndex_h */
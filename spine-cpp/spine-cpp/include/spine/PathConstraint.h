@@ -48,6 +48,8 @@ namespace spine {
 	class SP_API PathConstraint : public Updatable {
 		friend class Skeleton;
 
+		friend class SkeletonPose;
+
 		friend class PathConstraintMixTimeline;
 
 		friend class PathConstraintPositionTimeline;
@@ -115,10 +117,30 @@ namespace spine {
 		Vector<float> _world;
 		Vector<float> _curves;
 		Vector<float> _lengths;
+		/// The arc-length tables of the curves of a constant speed path, 10 lengths per curve. A curve's table is computed
+		/// the first time a bone is positioned on the curve, before which its first length is negative.
 		Vector<float> _segments;
 
 		bool _active;
 
+		/// The path attachment the cached world path was computed for, the bones it depends on, and their world transforms
+		/// followed by the target slot's deform at the time. While they are unchanged, the world path, its curve lengths
+		/// and arc-length tables are reused.
+		PathAttachment *_cachedPath;
+		Vector<Bone *> _cachedPathBones;
+		Vector<float> _cachedPathInputs;
+		/// True if _world and _curves hold the world path of a constant speed path.
+		bool _worldCached;
+		/// True if _positions were computed from the cached path with the cached position, spaces and tangents.
+		bool _positionsCached;
+		float _cachedPosition;
+		bool _cachedTangents;
+		Vector<float> _cachedSpaces;
+
+		/// Compares the world transforms of the bones the path depends on and the target slot's deform with those of the
+		/// last call, then stores them. Returns true if the world path may have changed since the last call.
+		bool updateCachedPath(PathAttachment &path);
+
 		Vector<float> &computeWorldPositions(PathAttachment &path, int spacesCount, bool tangents);
 
 		static void addBeforePosition(float p, Vector<float> &temp, int i, Vector<float> &output, int o);
@@ -60,10 +60,16 @@ namespace spine {
 			}
 		}
 
+		/// Returns the object to the pool in constant time. The free objects are kept in a vector that keeps its capacity,
+		/// so once the pool has grown to the most objects in use at once, obtaining and freeing don't allocate.
+		///
+		/// The object must not be freed again before it is obtained: the pool would then hand it out twice. Searching the
+		/// free objects for it would make freeing linear, so this is only asserted. Release builds ignore an object freed
+		/// twice in a row, which is the common case and costs a single comparison.
 		void free(T *object) {
-			if (!_objects.contains(object)) {
-				_objects.add(object);
-			}
+			assert(!_objects.contains(object));
+			if (_objects.size() > 0 && _objects[_objects.size() - 1] == object) return;
+			_objects.add(object);
 		}
 
 	private:
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ProfileStats_h
+#define Spine_ProfileStats_h
+
+#include <spine/HashMap.h>
+#include <spine/Profiler.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+#include <mutex>
+
+namespace spine {
+	class SkeletonData;
+
+	/// The time and counts recorded for a phase of a skeleton data under one name.
+	class SP_API ProfileStat {
+	public:
+		ProfilePhase phase;
+		/// The skeleton data of the skeletons the phase ran for, or NULL if the skeleton wasn't known.
+		SkeletonData *skeletonData;
+		/// The name of the bone, constraint or attachment, or empty.
+		String name;
+		double nanoseconds;
+		/// The number of times the phase ran.
+		size_t calls;
+		/// The number of items processed, summed over all calls.
+		size_t count;
+	};
+
+	/// A profiler summing up the recorded time per phase, skeleton data and name, so the assets, bones and constraints
+	/// that are expensive to update can be found. The skeletons of a skeleton data add up. Records from several threads
+	/// are serialized.
+	///
+	/// Names are told apart by the memory they are stored in, so the stats must be cleared before deleting a skeleton
+	/// data they were recorded for.
+	class SP_API ProfileStats : public Profiler, public SpineObject {
+	public:
+		ProfileStats();
+
+		~ProfileStats();
+
+		virtual void record(ProfilePhase phase, Skeleton *skeleton, const String *name, double nanoseconds,
+							size_t count) override;
+
+		/// The stats in the order they were first recorded. Must not be called while phases are recorded.
+		Vector<ProfileStat> &getStats();
+
+		/// The time of all calls of the phase, summed over all skeleton data and names.
+		double getNanoseconds(ProfilePhase phase);
+
+		void clear();
+
+	private:
+		class Key : public SpineObject {
+		public:
+			int _phase;
+			SkeletonData *_skeletonData;
+			const String *_name;
+
+			Key(int phase, SkeletonData *skeletonData, const String *name);
+
+			bool operator==(const Key &other) const;
+
+			size_t hash() const;
+		};
+
+		std::mutex _mutex;
+		Vector<ProfileStat> _stats;
+		HashMap<Key, size_t> _indices;
+	};
+}
+
+#endif /* Spine_ProfileStats_h */
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_Profiler_h
+#define Spine_Profiler_h
+
+#include <spine/dll.h>
+
+#include <stddef.h>
+#include <atomic>
+
+namespace spine {
+	class Skeleton;
+
+	class String;
+
+	class Updatable;
+
+	/// The phases of the update pipeline measured by the profiling hooks.
+	enum ProfilePhase {
+		/// AnimationState::apply(). The count is the number of tracks.
+		ProfilePhase_Apply = 0,
+		/// Bone::update() in Skeleton::updateWorldTransform(). With batch updates, runs of bones updated together are
+		/// recorded without a name, the count is the number of bones.
+		ProfilePhase_Bone,
+		/// IkConstraint::update() in Skeleton::updateWorldTransform().
+		ProfilePhase_IkConstraint,
+		/// TransformConstraint::update() in Skeleton::updateWorldTransform().
+		ProfilePhase_TransformConstraint,
+		/// PathConstraint::update() in Skeleton::updateWorldTransform().
+		ProfilePhase_PathConstraint,
+		/// SkeletonClipping::clipTriangles(), named after the clipping attachment. The count is the number of triangles.
+		ProfilePhase_Clipping,
+		/// VertexAttachment::computeWorldVertices(), named after the attachment. The count is the number of vertices.
+		ProfilePhase_WorldVertices,
+		ProfilePhase_Count
+	};
+
+	/// Receives the time spent in each phase of the update pipeline. The profiling hooks are only compiled into the
+	/// runtime if SPINE_PROFILING is defined, otherwise they cost nothing. Install a profiler with setInstance(), like a
+	/// SpineExtension. If skeletons are updated on several threads, e.g. by a SkeletonUpdateBatch, record() is called
+	/// concurrently.
+	class SP_API Profiler {
+	public:
+		static void setInstance(Profiler *profiler);
+
+		/// The installed profiler, or NULL.
+		static Profiler *getInstance();
+
+		virtual ~Profiler();
+
+		/// Called when a measured phase ends.
+		/// @param skeleton The skeleton the phase ran for, or NULL if it isn't known.
+		/// @param name The name of the bone, constraint or attachment, or NULL. It stays valid as long as the skeleton
+		/// data it belongs to.
+		/// @param count The number of items the phase processed.
+		virtual void record(ProfilePhase phase, Skeleton *skeleton, const String *name, double nanoseconds,
+							size_t count) = 0;
+
+	protected:
+		Profiler();
+
+	private:
+		static std::atomic<Profiler *> _instance;
+	};
+
+	/// Measures the time from construction to destruction and records it with the installed profiler. Does nothing if
+	/// no profiler is installed.
+	class SP_API ProfileScope {
+	public:
+		ProfileScope(ProfilePhase phase, Skeleton *skeleton, const String *name, size_t count);
+
+		/// Records an entry of the update cache as the phase of its type, named after its bone or constraint.
+		ProfileScope(Skeleton *skeleton, Updatable *updatable);
+
+		~ProfileScope();
+
+	private:
+		Profiler *_profiler;
+		ProfilePhase _phase;
+		Skeleton *_skeleton;
+		const String *_name;
+		size_t _count;
+		double _start;
+
+		ProfileScope(const ProfileScope &);
+
+		ProfileScope &operator=(const ProfileScope &);
+	};
+}
+
+#ifdef SPINE_PROFILING
+#define SP_PROFILE(...) spine::ProfileScope profileScope(__VA_ARGS__)
+#else
+#define SP_PROFILE(...)
+#endif
+
+#endif /* Spine_Profiler_h */
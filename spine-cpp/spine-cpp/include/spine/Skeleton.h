@@ -31,6 +31,7 @@
 #define Spine_Skeleton_h
 
 #include <unordered_map>
+#include <spine/Arena.h>
 #include <spine/Vector.h>
 #include <spine/MathUtil.h>
 #include <spine/SpineObject.h>
@@ -63,6 +64,8 @@ namespace spine {
 
 		friend class SkeletonClipping;
 
+		friend class SkeletonPose;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -119,13 +122,28 @@ namespace spine {
 
 		friend class RootMotionYTimeline;
 
+		friend class Slot;
+
+		friend class VertexAttachment;
+
 	public:
-		explicit Skeleton(SkeletonData *skeletonData);
+		/// @param batchUpdate If true, runs of TransformMode_Normal bones in the update cache are updated together in a tight
+		/// loop, without a virtual call and transform mode switch per bone.
+		///
+		/// If the skeleton data was loaded into an arena, the bones, slots and constraints of the skeleton are allocated
+		/// from an arena of the skeleton's own, which is released at once when the skeleton is deleted.
+		explicit Skeleton(SkeletonData *skeletonData, bool batchUpdate = false);
 
 		~Skeleton();
 
+		/// Creates a skeleton for the same skeleton data in the same state as this one, with the same skin, batch updates and
+		/// update cache. The bones, slots and constraints are created by index and the update cache is copied, so unlike the
+		/// constructor no attachments or constraint targets are looked up by name and updateCache() is not called.
+		Skeleton *copy();
+
 		/// Caches information about bones and constraints. Must be called if bones, constraints or weighted path attachments are added
-		/// or removed.
+		/// or removed. The bones and constraints are sorted in linear time, the resulting order is shared with other
+		/// skeletons of the same data using the same skins, see SkeletonData::setShareUpdateOrders().
 		void updateCache();
 
 		void printUpdateCache();
@@ -133,6 +151,12 @@ namespace spine {
 		/// Updates the world transform for each bone and applies constraints.
 		void updateWorldTransform();
 
+		/// Updates the world transform for each bone and applies the constraints, except those of the specified types. Bones
+		/// constrained only by skipped constraints keep the pose computed from their local transform, as if the constraints
+		/// had a mix of 0. Used to lower the cost of skeletons too small on screen for their constraints to be visible.
+		/// @param constraintTypes A combination of ConstraintType flags.
+		void updateWorldTransformSkipping(int constraintTypes);
+
 		void updateWorldTransform(Bone *parent);
 
 		/// Sets the bones, constraints, and slots to their setup pose values.
@@ -167,6 +191,12 @@ namespace spine {
 		/// @return May be NULL.
 		Attachment *getAttachment(int slotIndex, const String &attachmentName);
 
+		/// Returns the attachment for an attachment key of the skeleton data, see SkeletonData::findAttachmentKey(). The
+		/// attachments of all keys are found by name the first time a key is used after the skin changes or attachments
+		/// are set or removed in the skin or the default skin, afterward finding an attachment by key is an index.
+		/// @return May be NULL.
+		Attachment *getAttachment(int attachmentKey);
+
 		/// @param attachmentName May be empty.
 		void setAttachment(const String &slotName, const String &attachmentName);
 
@@ -197,6 +227,9 @@ namespace spine {
 
 		Vector<Updatable *> &getUpdateCacheList();
 
+		/// True if the skeleton was created to update runs of bones together, see Skeleton(SkeletonData *, bool).
+		bool getBatchUpdate();
+
 		Vector<Slot *> &getSlots();
 
 		Vector<Slot *> &getDrawOrder();
@@ -240,6 +273,7 @@ namespace spine {
 		void clearRootMotionDelta();
 
 	private:
+		ArenaOwner _arena;
 		SkeletonData *_data;
 		Vector<Bone *> _bones;
 		Vector<Slot *> _slots;
@@ -248,7 +282,25 @@ namespace spine {
 		Vector<TransformConstraint *> _transformConstraints;
 		Vector<PathConstraint *> _pathConstraints;
 		Vector<Updatable *> _updateCache;
+		bool _batchUpdate;
+		// With batch updates, the number of TransformMode_Normal bones with a parent starting at each update cache index.
+		Vector<int> _updateCacheRuns;
+		// Used by updateCache(): the constraints by order, the key and update order shared through the skeleton data, and
+		// the attachments of a slot.
+		Vector<Updatable *> _constraintsByOrder;
+		Vector<size_t> _updateOrderKey;
+		Vector<int> _updateOrder;
+		Vector<Attachment *> _updateOrderAttachments;
+		// Used by VertexAttachment::computeWorldVertices() to gather the bone matrices of a weighted attachment.
+		Vector<float> _skinningMatrices;
 		Skin *_skin;
+		// The attachment of each attachment key, found for the skin and default skin when the sum of their changes was
+		// _keyedAttachmentsChanges.
+		Vector<Attachment *> _keyedAttachments;
+		Skin *_keyedAttachmentsSkin;
+		Skin *_keyedAttachmentsDefaultSkin;
+		size_t _keyedAttachmentsChanges;
+		bool _keyedAttachmentsValid;
 		Color _color;
 		float _time;
 		float _scaleX, _scaleY;
@@ -258,6 +310,12 @@ namespace spine {
 		std::unordered_map<int, float> _rootMotionDeltaX;
 		std::unordered_map<int, float> _rootMotionDeltaY;
 
+		explicit Skeleton(Skeleton &prototype);
+
+		/// Finds an attachment by key if it has one, else by name.
+		/// @return May be NULL.
+		Attachment *getAttachment(int slotIndex, const String &attachmentName, int attachmentKey);
+
 		void sortIkConstraint(IkConstraint *constraint);
 
 		void sortPathConstraint(PathConstraint *constraint);
@@ -270,6 +328,11 @@ namespace spine {
 
 		void sortBone(Bone *bone);
 
+		void updateCacheRuns();
+
+		/// Updates the world transform of the TransformMode_Normal bones in the update cache from start to end.
+		void updateWorldTransformRun(size_t start, size_t end);
+
 		static void sortReset(Vector<Bone *> &bones);
 	};
 }
@@ -101,20 +101,54 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, the skeleton data and everything it owns are allocated from an arena owned by the skeleton data, so they
+		/// are laid out contiguously and released at once. Takes effect only while an ArenaExtension is installed. The
+		/// attachment loader must not keep memory it allocates while loading beyond the lifetime of the skeleton data.
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		/// If true, animations are not decoded while loading. Only their names and durations are read, and each animation
+		/// is decoded the first time it is found by name or set on an AnimationState, see
+		/// SkeletonData::prefetchAnimation(). The skeleton data keeps the mapped skeleton file, or a copy of the
+		/// animations if it was read from memory, until it is deleted.
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
+		/// If true, the offsets of deform timelines are stored as 16 bit integers, see DeformTimeline::quantize().
+		void setQuantizeDeform(bool quantizeDeform) { _quantizeDeform = quantizeDeform; }
+
+		/// The number of threads decoding animations, including the thread loading the skeleton data. If 0, one thread per
+		/// hardware thread is used. With more than one thread, the animations are first scanned for their boundaries,
+		/// then decoded concurrently. The loaded data doesn't depend on the number of threads. Skins and attachments are
+		/// always read on the loading thread, so the attachment loader doesn't need to be thread safe. Ignored if
+		/// animations are decoded lazily. Default is 1.
+		void setThreadCount(size_t threadCount) { _threadCount = threadCount; }
+
 		String &getError() { return _error; }
 
 	private:
+		friend class SkeletonData;
+
 		struct DataInput : public SpineObject {
 			const unsigned char *cursor;
 			const unsigned char *end;
 		};
 
+		struct DecodeJob;
+
 		AttachmentLoader *_attachmentLoader;
 		Vector<LinkedMesh *> _linkedMeshes;
 		String _error;
 		float _scale;
+		bool _useArena;
+		bool _lazyAnimations;
+		bool _quantizeDeform;
+		size_t _threadCount;
+		/// The file mapped by readSkeletonDataFile() while it is read.
+		const char *_mappedFile;
 		const bool _ownsLoader;
 
+		/// Creates a binary without an attachment loader, which only decodes lazily loaded animations.
+		explicit SkeletonBinary(float scale);
+
 		void setError(const char *value1, const char *value2);
 
 		char *readString(DataInput *input);
@@ -148,6 +182,24 @@ namespace spine {
 
 		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData);
 
+		/// Reads past an animation without decoding it. The animation is validated, so decoding it later can't fail.
+		bool skipAnimation(DataInput *input, SkeletonData *skeletonData, float &duration);
+
+		/// Reads past the frames of a curve timeline. Each frame has frameSize bytes starting with its time, then after
+		/// the first frame a curve type and bezierCount beziers, then extraSize bytes.
+		void skipCurveFrames(DataInput *input, int frameCount, int frameSize, int extraSize, int bezierCount,
+							 float &duration);
+
+		/// Decodes the timelines of an animation that was skipped while loading, from the data starting at the animation.
+		void decodeAnimation(SkeletonData *skeletonData, Animation *animation, const unsigned char *data,
+							 const unsigned char *end);
+
+		/// Decodes all skipped animations of the skeleton data on several threads.
+		void decodeAnimations(SkeletonData *skeletonData, const unsigned char *binary, int length,
+							  Vector<size_t> &offsets, size_t threadCount);
+
+		void runDecodeJob(DecodeJob *job);
+
 		void
 		setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1, float time2,
 				  float value1, float value2, float scale);
@@ -36,12 +36,18 @@
 namespace spine {
 	class Slot;
 
+	class Skeleton;
+
 	class ClippingAttachment;
 
 	class SP_API SkeletonClipping : public SpineObject {
 	public:
 		SkeletonClipping();
 
+		~SkeletonClipping();
+
+		/// Starts clipping to the convex polygons the clipping attachment decomposes into. The decompositions of the last
+		/// clipping attachments are kept and reused while their shapes are unchanged, see ClipCache.
 		size_t clipStart(Slot &slot, ClippingAttachment *clip);
 
 		void clipEnd(Slot &slot);
@@ -71,14 +77,42 @@ namespace spine {
 		Vector<float> _clippedUVs;
 		Vector<float> _scratch;
 		ClippingAttachment *_clipAttachment;
+		/// The skeleton of the slot clipping started at, for profiling.
+		Skeleton *_clipSkeleton;
 		Vector<Vector<float> *> *_clippingPolygons;
 
+		/// The convex polygons a clipping attachment was decomposed into. An attachment without bones or deform is
+		/// transformed by a single bone, which doesn't change which world vertices make up each polygon, so they are kept
+		/// while the bone moves. Otherwise they are kept while the world vertices are unchanged.
+		struct ClipCache : public SpineObject {
+			ClippingAttachment *attachment;
+			/// The attachment's vertices if they are transformed by a single bone, else the world vertices.
+			Vector<float> shape;
+			bool local;
+			/// True if the world vertices were in counter clockwise order.
+			bool reversed;
+			/// The offset in the world vertices of each point of the polygons.
+			Vector<int> indices;
+			Vector<Vector<float> *> polygons;
+
+			ClipCache() : attachment(NULL), local(false), reversed(false) {
+			}
+
+			~ClipCache();
+		};
+
+		static const size_t ClipCacheSize = 8;
+
+		Vector<ClipCache *> _clipCaches;
+		size_t _nextClipCache;
+
 		/** Clips the input triangle against the convex, clockwise clipping area. If the triangle lies entirely within the clipping
 		  * area, false is returned. The clipping area must duplicate the first vertex at the end of the vertices list. */
 		bool clip(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *clippingArea,
 				  Vector<float> *output);
 
-		static void makeClockwise(Vector<float> &polygon);
+		/// Reverses the polygon if it is counter clockwise. Returns true if it was reversed.
+		static bool makeClockwise(Vector<float> &polygon);
 	};
 }
 
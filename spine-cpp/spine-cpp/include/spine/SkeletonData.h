@@ -30,9 +30,13 @@
 #ifndef Spine_SkeletonData_h
 #define Spine_SkeletonData_h
 
+#include <spine/Arena.h>
+#include <spine/NameIndex.h>
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
 
+#include <mutex>
+
 namespace spine {
 	class BoneData;
 
@@ -50,6 +54,10 @@ namespace spine {
 
 	class PathConstraintData;
 
+	class SkeletonBinary;
+
+	class Attachment;
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 	class SP_API SkeletonData : public SpineObject {
 		friend class SkeletonBinary;
@@ -63,8 +71,7 @@ namespace spine {
 
 		~SkeletonData();
 
-		/// Finds a bone by comparing each bone's name.
-		/// It is more efficient to cache the results of this method than to call it multiple times.
+		/// Finds a bone by name using a hash index of the bone names.
 		/// @return May be NULL.
 		BoneData *findBone(const String &boneName);
 
@@ -77,6 +84,10 @@ namespace spine {
 		/// @return May be NULL.
 		spine::EventData *findEvent(const String &eventDataName);
 
+		/// If the animations are decoded lazily, see SkeletonBinary::setLazyAnimations(), the animation is decoded if it
+		/// wasn't yet. Decoding holds a lock of the skeleton data, so threads sharing the data may find animations at the
+		/// same time. An animation taken from getAnimations() instead must be passed to prefetchAnimation() or
+		/// AnimationState::setAnimation() before it is applied.
 		/// @return May be NULL.
 		Animation *findAnimation(const String &animationName);
 
@@ -89,6 +100,14 @@ namespace spine {
 		/// @return May be NULL.
 		PathConstraintData *findPathConstraint(const String &constraintName);
 
+		/// Returns the key of an attachment name for a slot, or -1. Each attachment name of a slot's setup pose or of an
+		/// attachment timeline has a key, which Skeleton::getAttachment(int) uses to find the attachment without comparing
+		/// names.
+		int findAttachmentKey(size_t slotIndex, const String &attachmentName);
+
+		/// The number of attachment keys. Grows when lazily loaded animations are decoded.
+		size_t getAttachmentKeyCount();
+
 		const String &getName();
 
 		void setName(const String &inValue);
@@ -156,7 +175,39 @@ namespace spine {
 
 		void setFps(float inValue);
 
+		/// The arena the skeleton data was loaded into, or NULL. See SkeletonBinary::setUseArena().
+		Arena *getArena();
+
+		/// Decodes a lazily loaded animation if it wasn't yet. Does nothing if the animations were not loaded lazily.
+		/// Like findAnimation(), decoding holds a lock of the skeleton data and may happen while other threads use it.
+		void prefetchAnimation(Animation *animation);
+
+		/// Releases the timelines of a lazily loaded animation, which is decoded again the next time it is needed. The
+		/// animation must not be in use by an AnimationState on any thread.
+		void evictAnimation(Animation *animation);
+
+		/// Returns false if the animation was loaded lazily and is not decoded.
+		bool isAnimationDecoded(Animation *animation);
+
+		/// If true, skeletons of this data share the update orders computed by Skeleton::updateCache(), one for each set of
+		/// active bones, active constraints and path attachments of path constraint targets. Changing the skin of a
+		/// skeleton to a combination of skins any skeleton used before doesn't sort the bones and constraints again. Up to
+		/// 64 update orders are kept, they are discarded when attachments are set or removed in a skin of this data.
+		/// Default is true.
+		void setShareUpdateOrders(bool inValue);
+
+		bool getShareUpdateOrders();
+
+		/// The number of update orders shared by the skeletons of this data.
+		size_t getUpdateOrderCount();
+
+		/// Indexes the names of the bones, slots, skins, events, animations and constraints again. The find methods only
+		/// find indexed items, so this must be called after items are added to, replaced in or removed from the vectors of
+		/// this data. Must not be called while other threads find items.
+		void rebuildNameIndexes();
+
 	private:
+		ArenaOwner _arena;
 		String _name;
 		Vector<BoneData *> _bones; // Ordered parents first
 		Vector<SlotData *> _slots; // Setup pose draw order.
@@ -176,6 +227,76 @@ namespace spine {
 		float _fps;
 		String _imagesPath;
 		String _audioPath;
+
+		NameIndex<BoneData> _boneIndex;
+		NameIndex<SlotData> _slotIndex;
+		NameIndex<Skin> _skinIndex;
+		NameIndex<EventData> _eventIndex;
+		NameIndex<Animation> _animationIndex;
+		NameIndex<IkConstraintData> _ikConstraintIndex;
+		NameIndex<TransformConstraintData> _transformConstraintIndex;
+		NameIndex<PathConstraintData> _pathConstraintIndex;
+		// The slot index and attachment name of each attachment key, and the keys of each slot.
+		Vector<size_t> _attachmentKeySlots;
+		Vector<String> _attachmentKeyNames;
+		Vector<Vector<int> > _slotAttachmentKeys;
+
+		/// The update cache of skeletons with the same key, see Skeleton::updateCache(). Bones are stored by index,
+		/// constraints by -1 - order.
+		struct UpdateOrder : public SpineObject {
+			size_t hash;
+			Vector<size_t> key;
+			Vector<int> order;
+		};
+
+		bool _shareUpdateOrders;
+		Vector<UpdateOrder *> _updateOrders;
+		// The sum of the changes of the skins and the number of skins when the update orders were computed.
+		size_t _updateOrdersSkinChanges;
+		size_t _updateOrdersSkinCount;
+		std::mutex _updateOrdersMutex;
+		// The path attachments of each slot in the skins, indexed when first needed after a skin changes.
+		Vector<Vector<Attachment *> > _slotPathAttachments;
+		bool _slotPathAttachmentsValid;
+
+		// Lazily decoded animations.
+		SkeletonBinary *_animationReader;
+		const unsigned char *_animationData;
+		int _animationDataLength;
+		bool _animationDataMapped;
+		Vector<size_t> _animationOffsets;
+		Vector<bool> _animationsDecoded;
+		// Held while lazily loaded animations are decoded or evicted and while the attachment keys are read, as decoding
+		// adds attachment keys. Not taken when the animations were decoded at load time.
+		std::mutex _animationsMutex;
+
+		/// Indexes all names and assigns the attachment keys once loading is done. Afterward finding by name only modifies
+		/// the SkeletonData to decode a lazily loaded animation, under _animationsMutex.
+		void updateNameIndexes();
+
+		/// findAttachmentKey() without taking _animationsMutex.
+		int lookUpAttachmentKey(size_t slotIndex, const String &attachmentName);
+
+		/// Returns the key of an attachment name for a slot, adding a key if the name has none.
+		int addAttachmentKey(size_t slotIndex, const String &attachmentName);
+
+		/// Sets the attachment keys of the attachment timelines of the animation.
+		void addAttachmentKeys(Animation *animation);
+
+		void decodeAnimation(size_t index);
+
+		/// Copies the update order for the key to order and returns true if it was computed before.
+		bool findUpdateOrder(Vector<size_t> &key, size_t hash, Vector<int> &order);
+
+		/// Stores the update order for the key, discarding the oldest update order if there are too many.
+		void addUpdateOrder(Vector<size_t> &key, size_t hash, Vector<int> &order);
+
+		/// Copies the path attachments of a slot in all skins to attachments, in the order of the skins.
+		void findPathAttachments(size_t slotIndex, Vector<Attachment *> &attachments);
+
+		/// Discards the update orders and the path attachment index if attachments were set or removed in a skin since they were computed, as the path
+		/// attachments of all skins are sorted.
+		void validateUpdateOrders();
 	};
 }
 
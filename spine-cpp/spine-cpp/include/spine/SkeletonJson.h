@@ -73,12 +73,22 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, the skeleton data and everything it owns are allocated from an arena owned by the skeleton data, so they
+		/// are laid out contiguously and released at once. Takes effect only while an ArenaExtension is installed. The
+		/// attachment loader must not keep memory it allocates while loading beyond the lifetime of the skeleton data.
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		/// If true, the offsets of deform timelines are stored as 16 bit integers, see DeformTimeline::quantize().
+		void setQuantizeDeform(bool quantizeDeform) { _quantizeDeform = quantizeDeform; }
+
 		String &getError() { return _error; }
 
 	private:
 		AttachmentLoader *_attachmentLoader;
 		Vector<LinkedMesh *> _linkedMeshes;
 		float _scale;
+		bool _useArena;
+		bool _quantizeDeform;
 		const bool _ownsLoader;
 		String _error;
 
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonLod_h
+#define Spine_SkeletonLod_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class AnimationState;
+
+	/// The settings of a level of detail of a SkeletonLod. The default settings are full detail.
+	struct SP_API LodTier {
+		/// The smallest metric the tier is chosen for.
+		float minMetric;
+		/// The number of frames between updates of the animation state and world transform, 1 to update every frame.
+		int updateInterval;
+		/// If true, the world transforms are interpolated between the last two updates on the frames in between. Motion
+		/// stays smooth, but lags one update interval behind.
+		bool interpolate;
+		/// The ConstraintType flags of the constraints that are not applied, see Skeleton::updateWorldTransformSkipping().
+		int skippedConstraints;
+		/// If true, deform timelines are not applied, see AnimationState::setFreezeDeform().
+		bool freezeDeform;
+		/// The size below which attachments are not rendered, see SkeletonRenderer::setMinSlotSize().
+		float minSlotSize;
+
+		LodTier();
+	};
+
+	/// Updates a Skeleton and AnimationState pair with a level of detail chosen each frame from a metric supplied by the
+	/// caller, such as the distance to the camera. Distant or offscreen skeletons can be updated at a reduced rate, skip
+	/// constraints and deform timelines, and leave small attachments out of rendering.
+	///
+	/// The renderer isn't owned by the level of detail, so the minimum slot size of the current tier must be passed to it,
+	/// see getTier().
+	class SP_API SkeletonLod : public SpineObject {
+	public:
+		SkeletonLod(Skeleton &skeleton, AnimationState &state);
+
+		~SkeletonLod();
+
+		/// Adds a tier. Tiers must be added in increasing order of their minimum metric.
+		void addTier(const LodTier &tier);
+
+		Vector<LodTier> &getTiers();
+
+		/// Chooses the tier for the metric, then updates and applies the animation state and updates the world transform if
+		/// an update is due. Otherwise the time is accumulated for the next update and, if the tier interpolates, the world
+		/// transforms are interpolated. When the tier changes, the skeleton is updated at once.
+		///
+		/// The world transforms shown between updates follow the skeleton's position, see Skeleton::setPosition(), so a
+		/// moving skeleton doesn't lag behind it. Changes to the skeleton's scale are shown at the next update.
+		/// @param metric The tier with the largest minimum metric not greater than the metric is chosen, or full detail if the
+		/// metric is less than the minimum metric of every tier.
+		/// @return True if the skeleton was updated.
+		bool update(float delta, float metric);
+
+		/// The tier chosen by the last update, or a full detail tier if none was chosen.
+		LodTier &getTier();
+
+		/// The index of the tier chosen by the last update, or -1 for full detail.
+		int getTierIndex();
+
+		Skeleton &getSkeleton();
+
+		AnimationState &getState();
+
+	private:
+		Skeleton &_skeleton;
+		AnimationState &_state;
+		Vector<LodTier> _tiers;
+		LodTier _fullDetail;
+		int _tierIndex;
+		/// The frames left until the next update.
+		int _wait;
+		/// The time since the last update.
+		float _elapsed;
+		/// The skeleton position the world transforms were last computed for.
+		float _x, _y;
+		/// The world transforms of the bones after the last two updates relative to the skeleton position, WorldValueCount
+		/// values per bone, which of them is the last, and how many were stored since the tier changed.
+		Vector<float> _poses[2];
+		int _lastPose;
+		int _poseCount;
+
+		void storePose(Vector<float> &pose);
+
+		/// Interpolates the stored world transforms and adds the current skeleton position.
+		void interpolate(float alpha);
+
+		/// Moves the world transforms of all bones.
+		void translate(float x, float y);
+	};
+}
+
+#endif /* Spine_SkeletonLod_h */
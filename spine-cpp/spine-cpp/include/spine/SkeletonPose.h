@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonPose_h
+#define Spine_SkeletonPose_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+#include <spine/Color.h>
+
+namespace spine {
+	class Skeleton;
+
+	class SkeletonData;
+
+	class Skin;
+
+	class Attachment;
+
+	/// A snapshot of the runtime state of a skeleton: the local, applied and world transforms of the bones, the slot colors,
+	/// attachments and deform, the draw order, the constraint mixes, the skin and the skeleton's color, position, scale and
+	/// time. A snapshot can be restored to the skeleton it was captured from or to any other skeleton with the same skeleton
+	/// data, for example to roll back a simulation.
+	///
+	/// The state is kept in a few flat arrays, so capture() and restore() are mostly block copies. Neither allocates once the
+	/// snapshot and the skeleton's deform arrays have grown to the largest state seen. Root motion deltas are not part of the
+	/// snapshot.
+	class SP_API SkeletonPose : public SpineObject {
+	public:
+		SkeletonPose();
+
+		~SkeletonPose();
+
+		/// Stores the state of the skeleton, replacing any state captured before.
+		void capture(Skeleton &skeleton);
+
+		/// Sets the skeleton to the captured state. The skeleton must have the same skeleton data as the captured skeleton,
+		/// but may differ in whether it batches updates. The update cache is only recomputed if the skin differs.
+		void restore(Skeleton &skeleton);
+
+		/// The skeleton data of the captured skeleton, or NULL if nothing was captured.
+		SkeletonData *getData();
+
+	private:
+		SkeletonData *_data;
+		/// The BonePose_Count values of each bone, in BonePose order.
+		Vector<float> _bones;
+		/// Per slot, the color, dark color and attachment time.
+		Vector<float> _slots;
+		Vector<int> _attachmentStates;
+		Vector<Attachment *> _attachments;
+		/// The deform of all slots, where slot i's deform starts at _deformOffsets[i] and ends at _deformOffsets[i + 1].
+		Vector<float> _deform;
+		Vector<int> _deformOffsets;
+		/// Slot indices in draw order.
+		Vector<int> _drawOrder;
+		/// The mixes of the IK, transform and path constraints, in that order.
+		Vector<float> _constraints;
+		Skin *_skin;
+		Color _color;
+		float _x, _y, _scaleX, _scaleY, _time;
+	};
+}
+
+#endif /* Spine_SkeletonPose_h */
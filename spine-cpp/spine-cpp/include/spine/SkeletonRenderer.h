@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonRenderer_h
+#define Spine_SkeletonRenderer_h
+
+#include <spine/BlendMode.h>
+#include <spine/SkeletonClipping.h>
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	class Skeleton;
+
+	class VertexEffect;
+
+	/// A vertex of the triangles output by SkeletonRenderer. Vertices are interleaved, so they can be copied to a GPU
+	/// vertex buffer as is.
+	struct SP_API RenderVertex {
+		float x, y;
+		float u, v;
+		/// The tint color, packed as 0xAARRGGBB.
+		unsigned int color;
+		/// The dark color for two color tinting, packed as 0xAARRGGBB. The alpha is 0 if the slot has no dark color.
+		unsigned int darkColor;
+	};
+
+	/// A range of triangles drawn with the same texture and blend mode.
+	struct SP_API RenderCommand {
+		/// The renderer object of the atlas page.
+		void *texture;
+		BlendMode blendMode;
+		/// The first vertex of the command in SkeletonRenderer::getVertices().
+		size_t vertexStart;
+		size_t vertexCount;
+		/// The first index of the command in SkeletonRenderer::getIndices(). Indices are relative to vertexStart.
+		size_t indexStart;
+		size_t indexCount;
+	};
+
+	/// Turns the visible region and mesh attachments of a skeleton into indexed triangles, grouped into render commands
+	/// by texture and blend mode, with clipping and vertex effects applied. Consecutive attachments with the same texture
+	/// and blend mode share a command. Engine backends draw the commands instead of walking the draw order themselves.
+	///
+	/// The buffers are kept between calls to render(), so once they have grown to fit a skeleton, rendering it doesn't
+	/// allocate.
+	class SP_API SkeletonRenderer : public SpineObject {
+	public:
+		SkeletonRenderer();
+
+		~SkeletonRenderer();
+
+		/// Replaces the commands, vertices and indices with those of the skeleton in its current pose.
+		/// @param vertexEffect If not NULL, applied to every vertex after clipping.
+		void render(Skeleton &skeleton, VertexEffect *vertexEffect = NULL);
+
+		Vector<RenderCommand> &getCommands() { return _commands; }
+
+		Vector<RenderVertex> &getVertices() { return _vertices; }
+
+		Vector<unsigned short> &getIndices() { return _indices; }
+
+		/// Region and mesh attachments smaller than this in world units are not rendered. An attachment's size is its larger
+		/// side scaled by the larger world scale of its slot's bone, so it is known before its vertices are computed. Meshes
+		/// loaded without nonessential data have no size and are measured by the bounds of their world vertices instead.
+		/// Default is 0.
+		float getMinSlotSize() { return _minSlotSize; }
+
+		void setMinSlotSize(float minSlotSize) { _minSlotSize = minSlotSize; }
+
+	private:
+		Vector<RenderCommand> _commands;
+		Vector<RenderVertex> _vertices;
+		Vector<unsigned short> _indices;
+		Vector<float> _worldVertices;
+		Vector<unsigned short> _quadIndices;
+		SkeletonClipping _clipper;
+		float _minSlotSize;
+
+		/// Returns the command the vertices are added to, merging them into the last command if possible.
+		RenderCommand &getCommand(void *texture, BlendMode blendMode, size_t vertexCount);
+	};
+}
+
+#endif /* Spine_SkeletonRenderer_h */
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonUpdateBatch_h
+#define Spine_SkeletonUpdateBatch_h
+
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace spine {
+	class Skeleton;
+
+	class AnimationState;
+
+	/// Updates many independent Skeleton and AnimationState pairs on several threads. Each pair is updated by a single
+	/// thread, pairs must not share a Skeleton or AnimationState. Listeners of the AnimationStates are called on the
+	/// thread updating the pair.
+	///
+	/// The work is split into one range of pairs per thread. A thread that finishes its range takes the remaining pairs
+	/// of the other ranges, so threads stay busy when pairs take different amounts of time to update.
+	class SP_API SkeletonUpdateBatch : public SpineObject {
+	public:
+		/// @param threadCount The number of threads updating the batch, including the thread calling update(). If 0, one
+		/// thread per hardware thread is used.
+		explicit SkeletonUpdateBatch(size_t threadCount = 0);
+
+		~SkeletonUpdateBatch();
+
+		void add(Skeleton &skeleton, AnimationState &state);
+
+		void clear();
+
+		size_t size();
+
+		size_t getThreadCount();
+
+		/// Calls AnimationState::update(), AnimationState::apply() and Skeleton::updateWorldTransform() for every pair,
+		/// then returns once all pairs are updated.
+		void update(float delta);
+
+	private:
+		/// Pairs not yet taken from a thread's range. Padded and aligned to 64 bytes so ranges of different threads don't
+		/// share a cache line.
+		struct Range {
+			std::atomic<size_t> next;
+			size_t end;
+			char padding[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+		};
+
+		class Worker : public SpineObject {
+		public:
+			std::thread _thread;
+		};
+
+		Vector<Skeleton *> _skeletons;
+		Vector<AnimationState *> _states;
+		Range *_ranges;
+		/// The memory the ranges are constructed in, which has room to align them.
+		char *_rangeMemory;
+		size_t _threadCount;
+		Vector<Worker *> _workers;
+		float _delta;
+
+		std::mutex _mutex;
+		std::condition_variable _startCondition;
+		std::condition_variable _doneCondition;
+		size_t _generation;
+		size_t _running;
+		bool _stopping;
+
+		void runWorker(size_t index);
+
+		void updateRanges(size_t index);
+	};
+}
+
+#endif /* Spine_SkeletonUpdateBatch_h */
@@ -48,6 +48,8 @@ namespace spine {
 	class SP_API Skin : public SpineObject {
 		friend class Skeleton;
 
+		friend class SkeletonData;
+
 	public:
 		class SP_API AttachmentMap : public SpineObject {
 			friend class Skin;
@@ -158,6 +160,8 @@ namespace spine {
 		AttachmentMap _attachments;
 		Vector<BoneData *> _bones;
 		Vector<ConstraintData *> _constraints;
+		/// Counts the attachments set or removed, so skeletons know when the attachments they found by key are stale.
+		size_t _changes;
 
 		/// Attach all attachments from this skin if the corresponding attachment from the old skin is currently attached.
 		void attachAll(Skeleton &skeleton, Skin &oldSkin);
@@ -48,6 +48,8 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class SkeletonPose;
+
 		friend class SkeletonBounds;
 
 		friend class SkeletonClipping;
@@ -131,6 +133,10 @@ namespace spine {
 		int _attachmentState;
 		float _attachmentTime;
 		Vector<float> _deform;
+
+		/// Creates a slot in the same state as a slot of a skeleton with the same data, without looking up the setup pose
+		/// attachment by name.
+		Slot(Slot &prototype, Bone &bone);
 	};
 }
 
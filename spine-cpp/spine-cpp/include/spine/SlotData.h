@@ -43,6 +43,8 @@ namespace spine {
 
 		friend class SkeletonJson;
 
+		friend class SkeletonData;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -101,6 +103,10 @@ namespace spine {
 
 		void setAttachmentName(const String &inValue);
 
+		/// The attachment key of the setup pose attachment name, see SkeletonData::findAttachmentKey(), or -1 if the name is
+		/// empty or has no key.
+		int getAttachmentKey();
+
 		BlendMode getBlendMode();
 
 		void setBlendMode(BlendMode inValue);
@@ -114,6 +120,7 @@ namespace spine {
 
 		bool _hasDarkColor;
 		String _attachmentName;
+		int _attachmentKey;
 		BlendMode _blendMode;
 	};
 }
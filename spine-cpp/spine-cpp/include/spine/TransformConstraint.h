@@ -44,6 +44,8 @@ namespace spine {
 	class SP_API TransformConstraint : public Updatable {
 		friend class Skeleton;
 
+		friend class SkeletonPose;
+
 		friend class TransformConstraintTimeline;
 
 	RTTI_DECL
@@ -38,6 +38,8 @@ namespace spine {
 	public:
 		~Triangulator();
 
+		/// Triangulates the polygon by ear clipping. The remaining vertices are kept in a linked list and only the concave
+		/// vertices are tested against each ear, so cutting an ear doesn't move the other vertices.
 		Vector<int> &triangulate(Vector<float> &vertices);
 
 		Vector<Vector < float>* > &
@@ -46,20 +48,32 @@ namespace spine {
 		Vector<int> &triangles
 		);
 
+		/// The offsets in the vertices of the points of each polygon returned by the last call to decompose().
+		Vector<Vector<int> *> &getConvexPolygonsIndices() { return _convexPolygonsIndices; }
+
 	private:
 		Vector<Vector < float>* >
 		_convexPolygons;
 		Vector<Vector < int>* >
 		_convexPolygonsIndices;
 
-		Vector<int> _indices;
+		/// The previous and next remaining vertex of each vertex.
+		Vector<int> _previous;
+		Vector<int> _next;
 		Vector<bool> _isConcaveArray;
+		/// The remaining concave vertices, in no particular order, and the index of each vertex in it.
+		Vector<int> _concave;
+		Vector<int> _concaveIndex;
 		Vector<int> _triangles;
 
 		Pool <Vector<float>> _polygonPool;
 		Pool <Vector<int>> _polygonIndicesPool;
 
-		static bool isConcave(int index, int vertexCount, Vector<float> &vertices, Vector<int> &indices);
+		void setConcave(int index, bool concave);
+
+		bool isEar(int previous, int index, int next, Vector<float> &vertices);
+
+		static bool isConcave(int previous, int index, int next, Vector<float> &vertices);
 
 		static bool positiveArea(float p1x, float p1y, float p2x, float p2y, float p3x, float p3y);
 
@@ -94,6 +94,17 @@ namespace spine {
 			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
 		}
 
+		/// Releases the memory beyond the size of the vector.
+		inline void shrink() {
+			if (_capacity == _size) return;
+			_capacity = _size;
+			if (_size == 0) {
+				deallocate(_buffer);
+				_buffer = NULL;
+			} else
+				_buffer = SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+		}
+
 		inline void add(const T &inValue) {
 			if (_size == _capacity) {
 				// inValue might reference an element in this buffer
@@ -85,6 +85,11 @@ namespace spine {
 
 		void copyTo(VertexAttachment *other);
 
+		/// Regroups the bones and weights of a weighted attachment into blocks of 4 vertices, which lets
+		/// computeWorldVertices skin 4 vertices at a time with SIMD instructions. Must be called after the bones or vertices
+		/// of a weighted attachment are changed, otherwise computeWorldVertices uses the scalar path.
+		void updateWeightBlocks();
+
 	protected:
 		Vector <size_t> _bones;
 		Vector<float> _vertices;
@@ -94,7 +99,22 @@ namespace spine {
 	private:
 		const int _id;
 
+		/// Skeleton bone indices used by the weighted vertices, the bone matrices are gathered in this order.
+		Vector<int> _weightBoneTable;
+		/// Per block of 4 vertices, the largest number of bones influencing one of the vertices.
+		Vector<int> _weightBlockCounts;
+		/// Per block and bone influence, for each of the 4 vertices: the index of the gathered matrix and the deform index.
+		/// Matrix 0 is zero and used by padding, matrix i + 1 is the bone at index i of _weightBoneTable.
+		Vector<int> _weightBlockBones;
+		Vector<int> _weightBlockDeform;
+		/// Per block and bone influence: 4 x values, 4 y values and 4 weights.
+		Vector<float> _weightBlockVertices;
+		size_t _weightBlockWeights;
+
 		static int getNextID();
+
+		void computeWeightedWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
+										  size_t stride);
 	};
 }
 
@@ -31,22 +31,27 @@
 #define SPINE_SPINE_H_
 
 #include <spine/Animation.h>
+#include <spine/AnimationBaker.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
+#include <spine/Arena.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/AttachmentType.h>
+#include <spine/BakedAnimation.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/BonePose.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Color.h>
 #include <spine/ColorTimeline.h>
 #include <spine/ConstraintData.h>
+#include <spine/ConstraintType.h>
 #include <spine/ContainerUtil.h>
 #include <spine/CurveTimeline.h>
 #include <spine/DeformTimeline.h>
@@ -66,6 +71,7 @@
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
+#include <spine/NameIndex.h>
 #include <spine/PathAttachment.h>
 #include <spine/PathConstraint.h>
 #include <spine/PathConstraintData.h>
@@ -87,6 +93,10 @@
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonLod.h>
+#include <spine/SkeletonPose.h>
+#include <spine/SkeletonRenderer.h>
+#include <spine/SkeletonUpdateBatch.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -96,6 +106,8 @@
 #include <spine/TextureLoader.h>
 #include <spine/Timeline.h>
 #include <spine/Property.h>
+#include <spine/ProfileStats.h>
+#include <spine/Profiler.h>
 #include <spine/TransformConstraint.h>
 #include <spine/TransformConstraintData.h>
 #include <spine/TransformConstraintTimeline.h>
@@ -42,11 +42,18 @@
 
 using namespace spine;
 
-Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(timelines),
+Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(),
 																						  _timelineIds(),
 																						  _duration(duration),
 																						  _name(name) {
 	assert(_name.length() > 0);
+	setTimelines(timelines);
+}
+
+void Animation::setTimelines(Vector<Timeline *> &timelines) {
+	ContainerUtil::cleanUpVectorOfPointers(_timelines);
+	_timelineIds.clear();
+	_timelines.addAll(timelines);
 	for (size_t i = 0; i < timelines.size(); i++) {
 		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
 		for (size_t ii = 0; ii < propertyIds.size(); ii++)
@@ -54,7 +61,7 @@ Animation::Animation(const String &name, Vector<Timeline *> &timelines, float du
 	}
 }
 
-bool Animation::hasTimeline(Vector<PropertyId> ids) {
+bool Animation::hasTimeline(Vector<PropertyId> &ids) {
 	for (size_t i = 0; i < ids.size(); i++) {
 		if (_timelineIds.containsKey(ids[i])) return true;
 	}
@@ -96,16 +103,23 @@ void Animation::setDuration(float inValue) {
 }
 
 int Animation::search(Vector<float> &frames, float target) {
-	size_t n = (int) frames.size();
-	for (size_t i = 1; i < n; i++) {
-		if (frames[i] > target) return i - 1;
+	float *values = frames.buffer();
+	size_t index = 0;
+	for (size_t count = frames.size(); count > 1;) {
+		size_t half = count >> 1;
+		index = values[index + half] <= target ? index + half : index;
+		count -= half;
 	}
-	return n - 1;
+	return (int) index;
 }
 
 int Animation::search(Vector<float> &frames, float target, int step) {
-	size_t n = frames.size();
-	for (size_t i = step; i < n; i += step)
-		if (frames[i] > target) return i - step;
-	return n - step;
+	float *values = frames.buffer();
+	size_t index = 0;
+	for (size_t count = frames.size() / step; count > 1;) {
+		size_t half = count >> 1;
+		index = values[(index + half) * step] <= target ? index + half : index;
+		count -= half;
+	}
+	return (int) index * step;
 }
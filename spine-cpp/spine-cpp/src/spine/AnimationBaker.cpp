@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/AnimationBaker.h>
+
+#include <spine/Animation.h>
+#include <spine/BakedAnimation.h>
+#include <spine/DeformTimeline.h>
+#include <spine/DrawOrderTimeline.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/SlotData.h>
+
+using namespace spine;
+
+AnimationBaker::AnimationBaker(SkeletonData *skeletonData) : _skeletonData(skeletonData),
+															 _skeleton(new (__FILE__, __LINE__) Skeleton(skeletonData)) {
+}
+
+AnimationBaker::~AnimationBaker() {
+	delete _skeleton;
+}
+
+void AnimationBaker::setSkin(Skin *skin) {
+	_skeleton->setSkin(skin);
+}
+
+void AnimationBaker::setScale(float scaleX, float scaleY) {
+	assert(scaleX != 0 && scaleY != 0);
+	_skeleton->setScaleX(scaleX);
+	_skeleton->setScaleY(scaleY);
+}
+
+BakedAnimation *AnimationBaker::bake(Animation &animation, float sampleRate) {
+	assert(sampleRate > 0);
+
+	float duration = animation.getDuration();
+	size_t frameCount = (size_t) (duration * sampleRate);
+	if (frameCount / sampleRate < duration) frameCount++;
+	frameCount++;
+
+	size_t boneCount = _skeleton->getBones().size(), slotCount = _skeleton->getSlots().size();
+	BakedAnimation *baked = new (__FILE__, __LINE__) BakedAnimation(animation.getName(), duration, sampleRate, frameCount,
+																	boneCount, slotCount);
+	baked->_scaleX = _skeleton->getScaleX();
+	baked->_scaleY = _skeleton->getScaleY();
+
+	bool hasDrawOrder = false;
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		Timeline *timeline = timelines[i];
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			int slotIndex = static_cast<DeformTimeline *>(timeline)->getSlotIndex();
+			if (!baked->_deformSlots.contains(slotIndex)) baked->_deformSlots.add(slotIndex);
+		} else if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))
+			hasDrawOrder = true;
+	}
+
+	bool hasDarkColor = false;
+	Vector<SlotData *> &slots = _skeletonData->getSlots();
+	for (size_t i = 0; i < slotCount; i++)
+		hasDarkColor |= slots[i]->hasDarkColor();
+
+	baked->allocate(hasDarkColor, hasDrawOrder);
+
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float time = MathUtil::min(frame / sampleRate, duration);
+		_skeleton->setToSetupPose();
+		animation.apply(*_skeleton, time, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+		_skeleton->updateWorldTransform();
+		baked->record(*_skeleton, frame);
+	}
+	return baked;
+}
@@ -37,9 +37,11 @@
 #include <spine/AttachmentTimeline.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
 #include <spine/EventTimeline.h>
+#include <spine/Profiler.h>
 #include <spine/RotateTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonData.h>
@@ -64,6 +66,8 @@ TrackEntry::TrackEntry() : _animation(NULL), _previous(NULL), _next(NULL), _mixi
 						   _trackLast(0), _nextTrackLast(0), _trackEnd(0), _timeScale(1.0f), _alpha(0), _mixTime(0),
 						   _mixDuration(0), _interruptAlpha(0), _totalAlpha(0), _mixBlend(MixBlend_Replace),
 						   _listener(dummyOnAnimationEventFunc), _listenerObject(NULL), _rootMotionID(InvalidRootMotionID) {
+	for (int run = 0; run <= AnimationState::PlanRunCount; run++)
+		_timelinePlanRuns[run] = 0;
 }
 
 TrackEntry::~TrackEntry() {}
@@ -197,11 +201,25 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_timelinePlan.clear();
+	_timelinePlanIndex.clear();
+	_timelinePlanMode.clear();
+	for (int run = 0; run <= AnimationState::PlanRunCount; run++)
+		_timelinePlanRuns[run] = 0;
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
 }
 
+void TrackEntry::reserveTimelines(size_t timelineCount) {
+	_timelineMode.ensureCapacity(timelineCount);
+	_timelineHoldMix.ensureCapacity(timelineCount);
+	_timelinesRotation.ensureCapacity(timelineCount << 1);
+	_timelinePlan.ensureCapacity(timelineCount);
+	_timelinePlanIndex.ensureCapacity(timelineCount);
+	_timelinePlanMode.ensureCapacity(timelineCount);
+}
+
 float TrackEntry::getTrackComplete() {
 	float duration = _animationEnd - _animationStart;
 	if (duration != 0) {
@@ -224,38 +242,57 @@ EventQueueEntry EventQueue::newEventQueueEntry(EventType eventType, TrackEntry *
 	return EventQueueEntry(eventType, entry, event);
 }
 
-EventQueue::EventQueue(AnimationState &state, Pool<TrackEntry> &trackEntryPool) : _state(state),
+EventQueue::EventQueue(AnimationState &state, Pool<TrackEntry> &trackEntryPool) : _head(0),
+																				  _count(0),
+																				  _state(state),
 																				  _trackEntryPool(trackEntryPool),
 																				  _drainDisabled(false) {
+	_eventQueueEntries.setSize(16, EventQueueEntry(EventType_Start, NULL));
 }
 
 EventQueue::~EventQueue() {
 }
 
+void EventQueue::add(const EventQueueEntry &entry) {
+	size_t capacity = _eventQueueEntries.size();
+	if (_count == capacity) {
+		// Double the capacity and move the entries before the head past the old end, so the queue stays contiguous.
+		_eventQueueEntries.setSize(capacity << 1, entry);
+		EventQueueEntry *entries = _eventQueueEntries.buffer();
+		for (size_t i = 0; i < _head; i++)
+			entries[capacity + i] = entries[i];
+		capacity <<= 1;
+	}
+	size_t index = _head + _count;
+	if (index >= capacity) index -= capacity;
+	_eventQueueEntries[index] = entry;
+	_count++;
+}
+
 void EventQueue::start(TrackEntry *entry) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_Start, entry));
+	add(newEventQueueEntry(EventType_Start, entry));
 	_state._animationsChanged = true;
 }
 
 void EventQueue::interrupt(TrackEntry *entry) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_Interrupt, entry));
+	add(newEventQueueEntry(EventType_Interrupt, entry));
 }
 
 void EventQueue::end(TrackEntry *entry) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_End, entry));
+	add(newEventQueueEntry(EventType_End, entry));
 	_state._animationsChanged = true;
 }
 
 void EventQueue::dispose(TrackEntry *entry) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_Dispose, entry));
+	add(newEventQueueEntry(EventType_Dispose, entry));
 }
 
 void EventQueue::complete(TrackEntry *entry) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_Complete, entry));
+	add(newEventQueueEntry(EventType_Complete, entry));
 }
 
 void EventQueue::event(TrackEntry *entry, Event *event) {
-	_eventQueueEntries.add(newEventQueueEntry(EventType_Event, entry, event));
+	add(newEventQueueEntry(EventType_Event, entry, event));
 }
 
 /// Raises all events in the queue and drains the queue.
@@ -268,9 +305,11 @@ void EventQueue::drain() {
 
 	AnimationState &state = _state;
 
-	// Don't cache _eventQueueEntries.size() so callbacks can queue their own events (eg, call setAnimation in AnimationState_Complete).
-	for (size_t i = 0; i < _eventQueueEntries.size(); ++i) {
-		EventQueueEntry queueEntry = _eventQueueEntries[i];
+	// Callbacks can queue their own events (eg, call setAnimation in AnimationState_Complete), which are drained too.
+	while (_count > 0) {
+		EventQueueEntry queueEntry = _eventQueueEntries[_head];
+		if (++_head == _eventQueueEntries.size()) _head = 0;
+		_count--;
 		TrackEntry *trackEntry = queueEntry._entry;
 
 		switch (queueEntry._type) {
@@ -314,7 +353,7 @@ void EventQueue::drain() {
 				break;
 		}
 	}
-	_eventQueueEntries.clear();
+	_head = 0;
 
 	_drainDisabled = false;
 }
@@ -322,10 +361,12 @@ void EventQueue::drain() {
 AnimationState::AnimationState(AnimationStateData *data) : _data(data),
 														   _queue(EventQueue::newEventQueue(*this, _trackEntryPool)),
 														   _animationsChanged(false),
+														   _timelineCapacity(0),
 														   _listener(dummyOnAnimationEventFunc),
 														   _listenerObject(NULL),
 														   _unkeyedState(0),
-														   _timeScale(1) {
+														   _timeScale(1),
+														   _freezeDeform(false) {
 }
 
 AnimationState::~AnimationState() {
@@ -417,6 +458,7 @@ void AnimationState::update(float delta) {
 }
 
 bool AnimationState::apply(Skeleton &skeleton) {
+	SP_PROFILE(ProfilePhase_Apply, &skeleton, NULL, _tracks.size());
 
 	skeleton.clearRootMotionDelta();
 	
@@ -455,40 +497,34 @@ bool AnimationState::apply(Skeleton &skeleton) {
 			applyTime = current._animation->getDuration() - applyTime;
 			applyEvents = NULL;
 		}
-		size_t timelineCount = current._animation->_timelines.size();
-		Vector<Timeline *> &timelines = current._animation->_timelines;
+		size_t timelineCount = current._timelinePlan.size();
+		Timeline **plan = current._timelinePlan.buffer();
+		size_t *runs = current._timelinePlanRuns;
+		// The deform timelines are last, so freezing deform ends the plan early.
+		size_t applyCount = _freezeDeform ? runs[PlanDeform] : timelineCount;
 		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-				Timeline *timeline = timelines[ii];
-				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, blend,
-											true);
-				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, mix, blend, MixDirection_In);
-			}
+			for (size_t ii = runs[PlanAttachment]; ii < runs[PlanRotate]; ++ii)
+				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(plan[ii]), skeleton, applyTime, blend, true);
+			for (size_t ii = runs[PlanRotate]; ii < applyCount; ++ii)
+				plan[ii]->apply(skeleton, animationLast, applyTime, applyEvents, mix, blend, MixDirection_In);
 		} else {
-			Vector<int> &timelineMode = current._timelineMode;
+			int *timelineMode = current._timelinePlanMode.buffer();
+			int *timelineIndex = current._timelinePlanIndex.buffer();
 
-			bool firstFrame = current._timelinesRotation.size() != timelines.size() << 1;
-			if (firstFrame) current._timelinesRotation.setSize(timelines.size() << 1, 0);
+			bool firstFrame = current._timelinesRotation.size() != timelineCount << 1;
+			if (firstFrame) current._timelinesRotation.setSize(timelineCount << 1, 0);
 			Vector<float> &timelinesRotation = current._timelinesRotation;
 
-			for (size_t ii = 0; ii < timelineCount; ++ii) {
-				Timeline *timeline = timelines[ii];
-				assert(timeline);
-
-				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
-
-				if (timeline->getRTTI().isExactly(RotateTimeline::rtti))
-					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, applyTime, mix,
-										timelineBlend, timelinesRotation, ii << 1, firstFrame);
-				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
-					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime,
-											timelineBlend, true);
-				else
-					timeline->apply(skeleton, animationLast, applyTime, applyEvents, mix, timelineBlend,
-									MixDirection_In);
-			}
+			for (size_t ii = runs[PlanAttachment]; ii < runs[PlanRotate]; ++ii)
+				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(plan[ii]), skeleton, applyTime,
+										timelineMode[ii] == Subsequent ? blend : MixBlend_Setup, true);
+			for (size_t ii = runs[PlanRotate]; ii < runs[PlanOther]; ++ii)
+				applyRotateTimeline(static_cast<RotateTimeline *>(plan[ii]), skeleton, applyTime, mix,
+									timelineMode[ii] == Subsequent ? blend : MixBlend_Setup, timelinesRotation,
+									timelineIndex[ii] << 1, firstFrame);
+			for (size_t ii = runs[PlanOther]; ii < applyCount; ++ii)
+				plan[ii]->apply(skeleton, animationLast, applyTime, applyEvents, mix,
+								timelineMode[ii] == Subsequent ? blend : MixBlend_Setup, MixDirection_In);
 		}
 
 		queueEvents(currentP, animationTime);
@@ -505,8 +541,8 @@ bool AnimationState::apply(Skeleton &skeleton) {
 	for (int i = 0, n = slots.size(); i < n; i++) {
 		Slot *slot = slots[i];
 		if (slot->getAttachmentState() == setupState) {
-			const String &attachmentName = slot->getData().getAttachmentName();
-			slot->setAttachment(attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot->getData().getIndex(), attachmentName));
+			SlotData &data = slot->getData();
+			slot->setAttachment(skeleton.getAttachment(data.getIndex(), data.getAttachmentName(), data.getAttachmentKey()));
 		}
 	}
 	_unkeyedState += 2;
@@ -559,6 +595,7 @@ TrackEntry *AnimationState::setAnimation(size_t trackIndex, const String &animat
 
 TrackEntry *AnimationState::setAnimation(size_t trackIndex, Animation *animation, bool loop) {
 	assert(animation != NULL);
+	_data->_skeletonData->prefetchAnimation(animation);
 
 	bool interrupt = true;
 	TrackEntry *current = expandToIndex(trackIndex);
@@ -591,6 +628,7 @@ TrackEntry *AnimationState::addAnimation(size_t trackIndex, const String &animat
 
 TrackEntry *AnimationState::addAnimation(size_t trackIndex, Animation *animation, bool loop, float delay) {
 	assert(animation != NULL);
+	_data->_skeletonData->prefetchAnimation(animation);
 
 	TrackEntry *last = expandToIndex(trackIndex);
 	if (last != NULL) {
@@ -661,6 +699,14 @@ void AnimationState::setTimeScale(float inValue) {
 	_timeScale = inValue;
 }
 
+bool AnimationState::getFreezeDeform() {
+	return _freezeDeform;
+}
+
+void AnimationState::setFreezeDeform(bool inValue) {
+	_freezeDeform = inValue;
+}
+
 void AnimationState::setListener(AnimationStateListener inValue) {
 	_listener = inValue;
 	_listenerObject = NULL;
@@ -680,6 +726,7 @@ void AnimationState::enableQueue() {
 }
 
 Animation *AnimationState::getEmptyAnimation() {
+	// Initialized once even when AnimationStates on several threads get here at the same time, afterward it is only read.
 	static Vector<Timeline *> timelines;
 	static Animation ret(String("<empty>"), timelines, 0);
 	return &ret;
@@ -693,10 +740,12 @@ void AnimationState::applyAttachmentTimeline(AttachmentTimeline *attachmentTimel
 	Vector<float> &frames = attachmentTimeline->getFrames();
 	if (time < frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), attachments);
+			setAttachment(skeleton, *slot, slot->getData().getAttachmentName(), slot->getData().getAttachmentKey(),
+						  attachments);
 	} else {
-		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[Animation::search(frames, time)],
-					  attachments);
+		int frame = Animation::search(frames, time);
+		setAttachment(skeleton, *slot, attachmentTimeline->getAttachmentNames()[frame],
+					  attachmentTimeline->getAttachmentKeys()[frame], attachments);
 	}
 
 	/* If an attachment wasn't set (ie before the first frame or attachments is false), set the setup attachment later.*/
@@ -812,8 +861,9 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	}
 
 	bool attachments = mix < from->_attachmentThreshold, drawOrder = mix < from->_drawOrderThreshold;
-	Vector<Timeline *> &timelines = from->_animation->_timelines;
-	size_t timelineCount = timelines.size();
+	size_t timelineCount = from->_timelinePlan.size();
+	Timeline **plan = from->_timelinePlan.buffer();
+	size_t *runs = from->_timelinePlanRuns;
 	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
 	float animationLast = from->_animationLast, animationTime = from->getAnimationTime();
 	float applyTime = animationTime;
@@ -825,60 +875,49 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	}
 
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
-			timelines[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
+		for (size_t i = 0, n = _freezeDeform ? runs[PlanDeform] : timelineCount; i < n; i++)
+			plan[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
 	} else {
-		Vector<int> &timelineMode = from->_timelineMode;
-		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
+		int *timelineMode = from->_timelinePlanMode.buffer();
+		int *timelineIndex = from->_timelinePlanIndex.buffer();
 
-		bool firstFrame = from->_timelinesRotation.size() != timelines.size() << 1;
-		if (firstFrame) from->_timelinesRotation.setSize(timelines.size() << 1, 0);
+		bool firstFrame = from->_timelinesRotation.size() != timelineCount << 1;
+		if (firstFrame) from->_timelinesRotation.setSize(timelineCount << 1, 0);
 
 		Vector<float> &timelinesRotation = from->_timelinesRotation;
 
 		from->_totalAlpha = 0;
-		for (size_t i = 0; i < timelineCount; i++) {
-			Timeline *timeline = timelines[i];
-			MixDirection direction = MixDirection_Out;
-			MixBlend timelineBlend;
-			float alpha;
-			switch (timelineMode[i]) {
-				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
-					timelineBlend = blend;
-					alpha = alphaMix;
-					break;
-				case First:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaMix;
-					break;
-				case HoldSubsequent:
-					timelineBlend = blend;
-					alpha = alphaHold;
-					break;
-				case HoldFirst:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaHold;
-					break;
-				default:
-					timelineBlend = MixBlend_Setup;
-					TrackEntry *holdMix = timelineHoldMix[i];
-					alpha = alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
-					break;
-			}
+		MixBlend timelineBlend;
+		float alpha;
+		for (size_t i = runs[PlanAttachment]; i < runs[PlanRotate]; i++) {
+			alpha = getMixingFromAlpha(from, i, blend, alphaMix, alphaHold, timelineBlend);
 			from->_totalAlpha += alpha;
-			if ((timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
-				applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
-									timelinesRotation, i << 1, firstFrame);
-			} else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
-				applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, timelineBlend,
-										attachments);
-			} else {
-				if (drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti) &&
-					timelineBlend == MixBlend_Setup)
-					direction = MixDirection_In;
-				timeline->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend, direction);
-			}
+			applyAttachmentTimeline(static_cast<AttachmentTimeline *>(plan[i]), skeleton, applyTime, timelineBlend,
+									attachments);
+		}
+		for (size_t i = runs[PlanRotate]; i < runs[PlanOther]; i++) {
+			alpha = getMixingFromAlpha(from, i, blend, alphaMix, alphaHold, timelineBlend);
+			from->_totalAlpha += alpha;
+			applyRotateTimeline(static_cast<RotateTimeline *>(plan[i]), skeleton, applyTime, alpha, timelineBlend,
+								timelinesRotation, timelineIndex[i] << 1, firstFrame);
+		}
+		for (size_t i = runs[PlanOther]; i < runs[PlanDrawOrder]; i++) {
+			alpha = getMixingFromAlpha(from, i, blend, alphaMix, alphaHold, timelineBlend);
+			from->_totalAlpha += alpha;
+			plan[i]->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend, MixDirection_Out);
+		}
+		for (size_t i = runs[PlanDrawOrder]; i < runs[PlanDeform]; i++) {
+			if (!drawOrder && timelineMode[i] == Subsequent) continue;
+			alpha = getMixingFromAlpha(from, i, blend, alphaMix, alphaHold, timelineBlend);
+			from->_totalAlpha += alpha;
+			plan[i]->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend,
+						   drawOrder && timelineBlend == MixBlend_Setup ? MixDirection_In : MixDirection_Out);
+		}
+		for (size_t i = runs[PlanDeform]; i < timelineCount; i++) {
+			alpha = getMixingFromAlpha(from, i, blend, alphaMix, alphaHold, timelineBlend);
+			from->_totalAlpha += alpha;
+			if (!_freezeDeform)
+				plan[i]->apply(skeleton, animationLast, applyTime, events, alpha, timelineBlend, MixDirection_Out);
 		}
 	}
 
@@ -893,9 +932,31 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	return mix;
 }
 
-void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, bool attachments) {
-	slot.setAttachment(
-			attachmentName.isEmpty() ? NULL : skeleton.getAttachment(slot.getData().getIndex(), attachmentName));
+float AnimationState::getMixingFromAlpha(TrackEntry *from, size_t i, MixBlend blend, float alphaMix, float alphaHold,
+										 MixBlend &timelineBlend) {
+	switch (from->_timelinePlanMode[i]) {
+		case Subsequent:
+			timelineBlend = blend;
+			return alphaMix;
+		case First:
+			timelineBlend = MixBlend_Setup;
+			return alphaMix;
+		case HoldSubsequent:
+			timelineBlend = blend;
+			return alphaHold;
+		case HoldFirst:
+			timelineBlend = MixBlend_Setup;
+			return alphaHold;
+		default:
+			timelineBlend = MixBlend_Setup;
+			TrackEntry *holdMix = from->_timelineHoldMix[from->_timelinePlanIndex[i]];
+			return alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
+	}
+}
+
+void AnimationState::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, int attachmentKey,
+								   bool attachments) {
+	slot.setAttachment(skeleton.getAttachment(slot.getData().getIndex(), attachmentName, attachmentKey));
 	if (attachments) slot.setAttachmentState(_unkeyedState + Current);
 }
 
@@ -963,6 +1024,10 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry *entryP = _trackEntryPool.obtain();// Pooling
 	TrackEntry &entry = *entryP;
 
+	// Size the buffers for the most timelines seen so far, so reusing the entry for another animation doesn't allocate.
+	if (animation->_timelines.size() > _timelineCapacity) _timelineCapacity = animation->_timelines.size();
+	entry.reserveTimelines(_timelineCapacity);
+
 	entry._trackIndex = trackIndex;
 	entry._animation = animation;
 	entry._loop = loop;
@@ -1017,6 +1082,7 @@ void AnimationState::animationsChanged() {
 
 		do {
 			if (entry->_mixingTo == NULL || entry->_mixBlend != MixBlend_Add) computeHold(entry);
+			computePlan(entry);
 			entry = entry->_mixingTo;
 		} while (entry != NULL);
 	}
@@ -1067,3 +1133,45 @@ continue_outer:
 		}
 	}
 }
+
+void AnimationState::computePlan(TrackEntry *entry) {
+	Vector<Timeline *> &timelines = entry->_animation->_timelines;
+	size_t timelinesCount = timelines.size();
+	Vector<Timeline *> &plan = entry->_timelinePlan;
+	Vector<int> &planIndex = entry->_timelinePlanIndex;
+
+	// The grouping only depends on the animation, so it is kept while the entry is in use. Without timelines the runs
+	// are always recomputed, since an empty plan can't tell whether they were.
+	if (plan.size() != timelinesCount || timelinesCount == 0) {
+		plan.clear();
+		planIndex.clear();
+		plan.ensureCapacity(timelinesCount);
+		planIndex.ensureCapacity(timelinesCount);
+		size_t *runs = entry->_timelinePlanRuns;
+		for (int run = PlanAttachment; run < PlanRunCount; run++) {
+			runs[run] = plan.size();
+			for (size_t i = 0; i < timelinesCount; i++) {
+				Timeline *timeline = timelines[i];
+				int kind = PlanOther;
+				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
+					kind = PlanAttachment;
+				else if (timeline->getRTTI().isExactly(RotateTimeline::rtti))
+					kind = PlanRotate;
+				else if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))
+					kind = PlanDrawOrder;
+				else if (timeline->getRTTI().isExactly(DeformTimeline::rtti))
+					kind = PlanDeform;
+				if (kind != run) continue;
+				plan.add(timeline);
+				planIndex.add((int) i);
+			}
+		}
+		runs[PlanRunCount] = plan.size();
+	}
+
+	Vector<int> &timelineMode = entry->_timelineMode;
+	Vector<int> &planMode = entry->_timelinePlanMode;
+	planMode.setSize(timelinesCount, 0);
+	for (size_t i = 0; i < timelinesCount; i++)
+		planMode[i] = (size_t) planIndex[i] < timelineMode.size() ? timelineMode[planIndex[i]] : Subsequent;
+}
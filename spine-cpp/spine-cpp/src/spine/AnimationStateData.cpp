@@ -35,14 +35,17 @@
 #include <spine/AnimationStateData.h>
 #include <spine/SkeletonData.h>
 
+#include <spine/ContainerUtil.h>
+
 using namespace spine;
 
 AnimationStateData::AnimationStateData(SkeletonData *skeletonData) : _skeletonData(skeletonData), _defaultMix(0) {
 }
 
 void AnimationStateData::setMix(const String &fromName, const String &toName, float duration) {
-	Animation *from = _skeletonData->findAnimation(fromName);
-	Animation *to = _skeletonData->findAnimation(toName);
+	// Searched without findAnimation(), so setting mixes doesn't decode lazily loaded animations.
+	Animation *from = ContainerUtil::findWithName(_skeletonData->getAnimations(), fromName);
+	Animation *to = ContainerUtil::findWithName(_skeletonData->getAnimations(), toName);
 
 	setMix(from, to, duration);
 }
@@ -81,5 +84,9 @@ AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) :
 }
 
 bool AnimationStateData::AnimationPair::operator==(const AnimationPair &other) const {
-	return _a1->_name == other._a1->_name && _a2->_name == other._a2->_name;
+	return _a1 == other._a1 && _a2 == other._a2;
+}
+
+size_t AnimationStateData::AnimationPair::hash() const {
+	return hashKey((long long) (size_t) _a1) ^ (hashKey((long long) (size_t) _a2) * 31);
 }
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/Arena.h>
+
+#include <assert.h>
+#include <string.h>
+
+using namespace spine;
+
+namespace {
+	/// Precedes every allocation of the ArenaExtension.
+	struct Header {
+		Arena *arena;
+		size_t size;
+	};
+
+	/// Keeps memory after headers aligned like memory returned by malloc.
+	const size_t Alignment = 16;
+
+	const size_t HeaderSize = 16;
+
+	const size_t BlockHeaderSize = 32;
+
+	const size_t MaxBlockSize = 1024 * 1024;
+
+	thread_local Arena *currentArena = NULL;
+
+	inline size_t align(size_t size) {
+		return (size + Alignment - 1) & ~(Alignment - 1);
+	}
+
+	inline Header *getHeader(void *mem) {
+		return (Header *) ((char *) mem - HeaderSize);
+	}
+}
+
+Arena::Arena(size_t blockSize) : _extension(NULL),
+								 _blocks(NULL),
+								 _blockSize(align(blockSize)),
+								 _blockCount(0),
+								 _usedMemory(0),
+								 _reservedMemory(0),
+								 _scopes(0),
+								 _disposed(false) {
+	static_assert(sizeof(Block) <= BlockHeaderSize, "Block doesn't fit its header.");
+	static_assert(sizeof(Header) <= HeaderSize, "Header doesn't fit.");
+}
+
+Arena::~Arena() {
+	assert(_scopes == 0);
+	Block *block = _blocks;
+	while (block) {
+		Block *next = block->next;
+		_extension->_free(block, __FILE__, __LINE__);
+		block = next;
+	}
+}
+
+void Arena::dispose(Arena *arena) {
+	if (!arena) return;
+	if (arena->_scopes > 0)
+		arena->_disposed = true;
+	else
+		delete arena;
+}
+
+Arena *Arena::getCurrent() {
+	return currentArena;
+}
+
+void *Arena::alloc(size_t size, SpineExtension *extension) {
+	size = align(size);
+	Block *block = _blocks;
+	if (!block || block->size - block->used < size) {
+		if (!_extension) _extension = extension;
+		size_t blockSize = size > _blockSize ? size : _blockSize;
+		Block *newBlock = (Block *) _extension->_alloc(BlockHeaderSize + blockSize, __FILE__, __LINE__);
+		if (!newBlock) return NULL;
+		newBlock->size = blockSize;
+		newBlock->used = 0;
+		if (block && size > _blockSize) {
+			// Oversized allocations get a block of their own, allocation continues in the current block.
+			newBlock->next = block->next;
+			block->next = newBlock;
+		} else {
+			newBlock->next = block;
+			_blocks = newBlock;
+			if (_blockSize < MaxBlockSize) _blockSize *= 2;
+		}
+		_blockCount++;
+		_reservedMemory += blockSize;
+		block = newBlock;
+	}
+	void *mem = (char *) block + BlockHeaderSize + block->used;
+	block->used += size;
+	_usedMemory += size;
+	return mem;
+}
+
+bool Arena::resize(void *mem, size_t size, size_t newSize) {
+	Block *block = _blocks;
+	size = align(size);
+	newSize = align(newSize);
+	if (!block || (char *) mem + size != (char *) block + BlockHeaderSize + block->used) return false;
+	if (newSize > size && block->size - block->used < newSize - size) return false;
+	block->used = block->used - size + newSize;
+	_usedMemory = _usedMemory - size + newSize;
+	return true;
+}
+
+void Arena::free(void *mem, size_t size) {
+	resize(mem, size, 0);
+}
+
+ArenaScope::ArenaScope(Arena *arena) : _arena(arena), _previous(currentArena) {
+	currentArena = arena;
+	if (arena) arena->_scopes++;
+}
+
+ArenaScope::~ArenaScope() {
+	currentArena = _previous;
+	if (_arena && --_arena->_scopes == 0 && _arena->_disposed) delete _arena;
+}
+
+Arena *ArenaOwner::create(size_t blockSize) {
+	if (!_arena) {
+		// The arena itself must not come from the arena of an enclosing scope.
+		ArenaScope scope(NULL);
+		_arena = new (__FILE__, __LINE__) Arena(blockSize);
+	}
+	return _arena;
+}
+
+ArenaExtension::ArenaExtension(SpineExtension *extension) : _extension(extension) {
+}
+
+ArenaExtension::~ArenaExtension() {
+}
+
+void *ArenaExtension::_alloc(size_t size, const char *file, int line) {
+	if (size == 0) return NULL;
+	Arena *arena = currentArena;
+	Header *header = (Header *) (arena ? arena->alloc(HeaderSize + size, _extension)
+									   : _extension->_alloc(HeaderSize + size, file, line));
+	if (!header) return NULL;
+	header->arena = arena;
+	header->size = size;
+	return (char *) header + HeaderSize;
+}
+
+void *ArenaExtension::_calloc(size_t size, const char *file, int line) {
+	void *mem = _alloc(size, file, line);
+	if (mem) memset(mem, 0, size);
+	return mem;
+}
+
+void *ArenaExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+	if (!ptr) return _alloc(size, file, line);
+	if (size == 0) {
+		_free(ptr, file, line);
+		return NULL;
+	}
+
+	Header *header = getHeader(ptr);
+	Arena *arena = header->arena;
+	if (!arena) {
+		// Memory of the wrapped extension stays there, even in an ArenaScope.
+		header = (Header *) _extension->_realloc(header, HeaderSize + size, file, line);
+		if (!header) return NULL;
+		header->size = size;
+		return (char *) header + HeaderSize;
+	}
+	if (arena == currentArena && arena->resize(header, HeaderSize + header->size, HeaderSize + size)) {
+		header->size = size;
+		return ptr;
+	}
+
+	void *mem = _alloc(size, file, line);
+	if (!mem) return NULL;
+	memcpy(mem, ptr, header->size < size ? header->size : size);
+	_free(ptr, file, line);
+	return mem;
+}
+
+void ArenaExtension::_free(void *mem, const char *file, int line) {
+	if (!mem) return;
+	Header *header = getHeader(mem);
+	if (!header->arena)
+		_extension->_free(header, file, line);
+	else if (header->arena == currentArena)
+		header->arena->free(header, HeaderSize + header->size);
+}
+
+char *ArenaExtension::_readFile(const String &path, int *length) {
+	return _extension->_readFile(path, length);
+}
+
+const char *ArenaExtension::_mapFile(const String &path, int *length) {
+	return _extension->_mapFile(path, length);
+}
+
+void ArenaExtension::_unmapFile(const char *data, int length) {
+	_extension->_unmapFile(data, length);
+}
@@ -90,9 +90,12 @@ void Atlas::flipV() {
 }
 
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
-	return NULL;
+	int index = _regionIndex.find(_regions, name);
+	return index == -1 ? NULL : _regions[index];
+}
+
+void Atlas::rebuildRegionIndex() {
+	_regionIndex.rebuild(_regions);
 }
 
 Vector<AtlasPage *> &Atlas::getPages() {
@@ -353,4 +356,5 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			_regions.add(region);
 		}
 	}
+	rebuildRegionIndex();
 }
@@ -55,12 +55,13 @@ AttachmentTimeline::AttachmentTimeline(size_t frameCount, int slotIndex) : Timel
 	for (size_t i = 0; i < frameCount; ++i) {
 		_attachmentNames.add(String());
 	}
+	_attachmentKeys.setSize(frameCount, -1);
 }
 
 AttachmentTimeline::~AttachmentTimeline() {}
 
-void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, String *attachmentName) {
-	slot.setAttachment(attachmentName == NULL || attachmentName->isEmpty() ? NULL : skeleton.getAttachment(_slotIndex, *attachmentName));
+void AttachmentTimeline::setAttachment(Skeleton &skeleton, Slot &slot, const String &attachmentName, int attachmentKey) {
+	slot.setAttachment(skeleton.getAttachment(_slotIndex, attachmentName, attachmentKey));
 }
 
 void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
@@ -73,32 +74,45 @@ void AttachmentTimeline::apply(Skeleton &skeleton, float lastTime, float time, V
 	if (!slot->_bone._active) return;
 
 	if (direction == MixDirection_Out) {
-		if (blend == MixBlend_Setup) setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+		if (blend == MixBlend_Setup)
+			setAttachment(skeleton, *slot, slot->_data._attachmentName, slot->_data._attachmentKey);
 		return;
 	}
 
 	if (time < _frames[0]) {
 		// Time is before first frame.
 		if (blend == MixBlend_Setup || blend == MixBlend_First) {
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, slot->_data._attachmentName, slot->_data._attachmentKey);
 		}
 		return;
 	}
 
 	if (time < _frames[0]) {
 		if (blend == MixBlend_Setup || blend == MixBlend_First)
-			setAttachment(skeleton, *slot, &slot->_data._attachmentName);
+			setAttachment(skeleton, *slot, slot->_data._attachmentName, slot->_data._attachmentKey);
 		return;
 	}
 
-	setAttachment(skeleton, *slot, &_attachmentNames[Animation::search(_frames, time)]);
+	int frame = Animation::search(_frames, time);
+	setAttachment(skeleton, *slot, _attachmentNames[frame], _attachmentKeys[frame]);
 }
 
 void AttachmentTimeline::setFrame(int frame, float time, const String &attachmentName) {
 	_frames[frame] = time;
 	_attachmentNames[frame] = attachmentName;
+	_attachmentKeys[frame] = -1;
 }
 
 Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
+
+Vector<int> &AttachmentTimeline::getAttachmentKeys() {
+	return _attachmentKeys;
+}
+
+void AttachmentTimeline::setSlotIndex(int inValue) {
+	_slotIndex = inValue;
+	for (size_t i = 0, n = _attachmentKeys.size(); i < n; i++)
+		_attachmentKeys[i] = -1;
+}
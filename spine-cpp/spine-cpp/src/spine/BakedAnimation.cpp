@@ -0,0 +1,237 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/BakedAnimation.h>
+
+#include <spine/Bone.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+
+#include <string.h>
+
+using namespace spine;
+
+enum BakedBone {
+	BakedBone_A = 0,
+	BakedBone_B,
+	BakedBone_C,
+	BakedBone_D,
+	BakedBone_WorldX,
+	BakedBone_WorldY,
+	BakedBone_Count
+};
+
+/// Slot colors may be outside of 0 to 1 when color curves overshoot, so each channel is clamped to fit its 8 bits.
+static inline unsigned int packChannel(float channel, int shift) {
+	return (unsigned int) (MathUtil::clamp(channel, 0, 1) * 255 + 0.5f) << shift;
+}
+
+static inline unsigned int packColor(Color &color) {
+	return packChannel(color.a, 24) | packChannel(color.r, 16) | packChannel(color.g, 8) | packChannel(color.b, 0);
+}
+
+static inline float unpackChannel(unsigned int from, unsigned int to, int shift, float alpha) {
+	float start = (float) ((from >> shift) & 0xff);
+	return (start + ((float) ((to >> shift) & 0xff) - start) * alpha) / 255;
+}
+
+static inline void unpackColor(unsigned int from, unsigned int to, float alpha, Color &color) {
+	color.set(unpackChannel(from, to, 16, alpha), unpackChannel(from, to, 8, alpha), unpackChannel(from, to, 0, alpha),
+			  unpackChannel(from, to, 24, alpha));
+}
+
+BakedAnimation::BakedAnimation(const String &name, float duration, float sampleRate, size_t frameCount, size_t boneCount,
+							   size_t slotCount) : _name(name),
+												   _duration(duration),
+												   _sampleRate(sampleRate),
+												   _frameCount(frameCount),
+												   _boneCount(boneCount),
+												   _slotCount(slotCount),
+												   _scaleX(1),
+												   _scaleY(1) {
+}
+
+BakedAnimation::~BakedAnimation() {
+}
+
+template<typename T>
+static inline void allocateFrames(Vector<T> &values, size_t size) {
+	values.ensureCapacity(size);
+	values.setSize(size, T());
+}
+
+void BakedAnimation::allocate(bool darkColors, bool drawOrder) {
+	allocateFrames(_bones, _frameCount * _boneCount * BakedBone_Count);
+	allocateFrames(_colors, _frameCount * _slotCount);
+	if (darkColors) allocateFrames(_darkColors, _frameCount * _slotCount);
+	allocateFrames(_attachments, _frameCount * _slotCount);
+	if (drawOrder) allocateFrames(_drawOrder, _frameCount * _slotCount);
+	allocateFrames(_deformStarts, _frameCount * _deformSlots.size() + 1);
+}
+
+void BakedAnimation::record(Skeleton &skeleton, size_t frame) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	float *baked = _bones.buffer() + frame * _boneCount * BakedBone_Count;
+	for (size_t i = 0; i < _boneCount; i++, baked += BakedBone_Count) {
+		Bone &bone = *bones[i];
+		baked[BakedBone_A] = bone.getA();
+		baked[BakedBone_B] = bone.getB();
+		baked[BakedBone_C] = bone.getC();
+		baked[BakedBone_D] = bone.getD();
+		baked[BakedBone_WorldX] = bone.getWorldX();
+		baked[BakedBone_WorldY] = bone.getWorldY();
+	}
+
+	Vector<Slot *> &slots = skeleton.getSlots();
+	size_t offset = frame * _slotCount;
+	for (size_t i = 0; i < _slotCount; i++) {
+		Slot &slot = *slots[i];
+		_colors[offset + i] = packColor(slot.getColor());
+		if (_darkColors.size() > 0) _darkColors[offset + i] = packColor(slot.getDarkColor());
+		_attachments[offset + i] = slot.getAttachment();
+	}
+
+	if (_drawOrder.size() > 0) {
+		Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+		for (size_t i = 0; i < _slotCount; i++)
+			_drawOrder[offset + i] = drawOrder[i]->getData().getIndex();
+	}
+
+	for (size_t i = 0, n = _deformSlots.size(); i < n; i++) {
+		Vector<float> &deform = slots[_deformSlots[i]]->getDeform();
+		size_t start = _deform.size();
+		_deformStarts[frame * n + i] = start;
+		_deform.setSize(start + deform.size(), 0);
+		if (deform.size() > 0) memcpy(_deform.buffer() + start, deform.buffer(), deform.size() * sizeof(float));
+	}
+	_deformStarts[(frame + 1) * _deformSlots.size()] = _deform.size();
+}
+
+void BakedAnimation::apply(Skeleton &skeleton, float time, bool loop, bool interpolate) {
+	assert(skeleton.getBones().size() == _boneCount && skeleton.getSlots().size() == _slotCount);
+
+	if (loop && _duration != 0) time = MathUtil::fmod(time, _duration);
+	time = MathUtil::clamp(time, 0, _duration);
+
+	size_t frame = (size_t) (time * _sampleRate), next = frame;
+	float alpha = 0;
+	if (frame >= _frameCount - 1)
+		frame = next = _frameCount - 1;
+	else if (interpolate) {
+		float start = frame / _sampleRate, end = MathUtil::min((frame + 1) / _sampleRate, _duration);
+		if (end > start) {
+			alpha = (time - start) / (end - start);
+			next = frame + 1;
+		}
+	}
+
+	// The skeleton's position and scale change every row of the world transforms as they do for the root bone.
+	float scaleX = skeleton.getScaleX() / _scaleX, scaleY = skeleton.getScaleY() / _scaleY;
+	float x = skeleton.getX(), y = skeleton.getY();
+	Vector<Bone *> &bones = skeleton.getBones();
+	const float *from = _bones.buffer() + frame * _boneCount * BakedBone_Count;
+	const float *to = _bones.buffer() + next * _boneCount * BakedBone_Count;
+	float pose[BakedBone_Count];
+	for (size_t i = 0; i < _boneCount; i++, from += BakedBone_Count, to += BakedBone_Count) {
+		for (int ii = 0; ii < BakedBone_Count; ii++)
+			pose[ii] = from[ii] + (to[ii] - from[ii]) * alpha;
+		Bone &bone = *bones[i];
+		bone.setA(pose[BakedBone_A] * scaleX);
+		bone.setB(pose[BakedBone_B] * scaleX);
+		bone.setC(pose[BakedBone_C] * scaleY);
+		bone.setD(pose[BakedBone_D] * scaleY);
+		bone.setWorldX(pose[BakedBone_WorldX] * scaleX + x);
+		bone.setWorldY(pose[BakedBone_WorldY] * scaleY + y);
+	}
+
+	Vector<Slot *> &slots = skeleton.getSlots();
+	size_t fromOffset = frame * _slotCount, toOffset = next * _slotCount;
+	for (size_t i = 0; i < _slotCount; i++) {
+		Slot &slot = *slots[i];
+		unpackColor(_colors[fromOffset + i], _colors[toOffset + i], alpha, slot.getColor());
+		if (_darkColors.size() > 0 && slot.hasDarkColor())
+			unpackColor(_darkColors[fromOffset + i], _darkColors[toOffset + i], alpha, slot.getDarkColor());
+		slot.setAttachment(_attachments[fromOffset + i]);
+		slot.getDeform().clear();
+	}
+
+	for (size_t i = 0, n = _deformSlots.size(); i < n; i++) {
+		size_t start = _deformStarts[frame * n + i], count = _deformStarts[frame * n + i + 1] - start;
+		size_t nextStart = _deformStarts[next * n + i], nextCount = _deformStarts[next * n + i + 1] - nextStart;
+		Vector<float> &deform = slots[_deformSlots[i]]->getDeform();
+		deform.setSize(count, 0);
+		const float *fromDeform = _deform.buffer() + start, *toDeform = _deform.buffer() + nextStart;
+		if (nextCount == count) {
+			for (size_t ii = 0; ii < count; ii++)
+				deform[ii] = fromDeform[ii] + (toDeform[ii] - fromDeform[ii]) * alpha;
+		} else {
+			for (size_t ii = 0; ii < count; ii++)
+				deform[ii] = fromDeform[ii];
+		}
+	}
+
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	if (_drawOrder.size() > 0) {
+		for (size_t i = 0; i < _slotCount; i++)
+			drawOrder[i] = slots[_drawOrder[fromOffset + i]];
+	} else {
+		for (size_t i = 0; i < _slotCount; i++)
+			drawOrder[i] = slots[i];
+	}
+}
+
+const String &BakedAnimation::getName() {
+	return _name;
+}
+
+float BakedAnimation::getDuration() {
+	return _duration;
+}
+
+float BakedAnimation::getSampleRate() {
+	return _sampleRate;
+}
+
+size_t BakedAnimation::getFrameCount() {
+	return _frameCount;
+}
+
+size_t BakedAnimation::getMemoryUsage() {
+	return sizeof(BakedAnimation) + _name.length() + _bones.getCapacity() * sizeof(float) +
+		   _colors.getCapacity() * sizeof(unsigned int) + _darkColors.getCapacity() * sizeof(unsigned int) +
+		   _attachments.getCapacity() * sizeof(Attachment *) + _drawOrder.getCapacity() * sizeof(int) +
+		   _deformSlots.getCapacity() * sizeof(int) + _deformStarts.getCapacity() * sizeof(size_t) +
+		   _deform.getCapacity() * sizeof(float);
+}
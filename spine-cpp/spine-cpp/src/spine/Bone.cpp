@@ -104,10 +104,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 		float rotationY = rotation + 90 + shearY;
 		float sx = _skeleton.getScaleX();
 		float sy = _skeleton.getScaleY();
-		_a = MathUtil::cosDeg(rotation + shearX) * scaleX * sx;
-		_b = MathUtil::cosDeg(rotationY) * scaleY * sx;
-		_c = MathUtil::sinDeg(rotation + shearX) * scaleX * sy;
-		_d = MathUtil::sinDeg(rotationY) * scaleY * sy;
+		float cosX, sinX, cosY, sinY;
+		MathUtil::sincosDeg(rotation + shearX, sinX, cosX);
+		MathUtil::sincosDeg(rotationY, sinY, cosY);
+		_a = cosX * scaleX * sx;
+		_b = cosY * scaleY * sx;
+		_c = sinX * scaleX * sy;
+		_d = sinY * scaleY * sy;
 		_worldX = x * sx + _skeleton.getX();
 		_worldY = y * sy + _skeleton.getY();
 		return;
@@ -124,10 +127,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	switch (_data.getTransformMode()) {
 		case TransformMode_Normal: {
 			float rotationY = rotation + 90 + shearY;
-			float la = MathUtil::cosDeg(rotation + shearX) * scaleX;
-			float lb = MathUtil::cosDeg(rotationY) * scaleY;
-			float lc = MathUtil::sinDeg(rotation + shearX) * scaleX;
-			float ld = MathUtil::sinDeg(rotationY) * scaleY;
+			float cosX, sinX, cosY, sinY;
+			MathUtil::sincosDeg(rotation + shearX, sinX, cosX);
+			MathUtil::sincosDeg(rotationY, sinY, cosY);
+			float la = cosX * scaleX;
+			float lb = cosY * scaleY;
+			float lc = sinX * scaleX;
+			float ld = sinY * scaleY;
 			_a = pa * la + pb * lc;
 			_b = pa * lb + pb * ld;
 			_c = pc * la + pd * lc;
@@ -136,10 +142,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 		}
 		case TransformMode_OnlyTranslation: {
 			float rotationY = rotation + 90 + shearY;
-			_a = MathUtil::cosDeg(rotation + shearX) * scaleX;
-			_b = MathUtil::cosDeg(rotationY) * scaleY;
-			_c = MathUtil::sinDeg(rotation + shearX) * scaleX;
-			_d = MathUtil::sinDeg(rotationY) * scaleY;
+			float cosX, sinX, cosY, sinY;
+			MathUtil::sincosDeg(rotation + shearX, sinX, cosX);
+			MathUtil::sincosDeg(rotationY, sinY, cosY);
+			_a = cosX * scaleX;
+			_b = cosY * scaleY;
+			_c = sinX * scaleX;
+			_d = sinY * scaleY;
 			break;
 		}
 		case TransformMode_NoRotationOrReflection: {
@@ -159,10 +168,13 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 			}
 			rx = rotation + shearX - prx;
 			ry = rotation + shearY - prx + 90;
-			la = MathUtil::cosDeg(rx) * scaleX;
-			lb = MathUtil::cosDeg(ry) * scaleY;
-			lc = MathUtil::sinDeg(rx) * scaleX;
-			ld = MathUtil::sinDeg(ry) * scaleY;
+			float cosX, sinX, cosY, sinY;
+			MathUtil::sincosDeg(rx, sinX, cosX);
+			MathUtil::sincosDeg(ry, sinY, cosY);
+			la = cosX * scaleX;
+			lb = cosY * scaleY;
+			lc = sinX * scaleX;
+			ld = sinY * scaleY;
 			_a = pa * la - pb * lc;
 			_b = pa * lb - pb * ld;
 			_c = pc * la + pd * lc;
@@ -173,8 +185,7 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 		case TransformMode_NoScaleOrReflection: {
 			float za, zc, s;
 			float r, zb, zd, la, lb, lc, ld;
-			cosine = MathUtil::cosDeg(rotation);
-			sine = MathUtil::sinDeg(rotation);
+			MathUtil::sincosDeg(rotation, sine, cosine);
 			za = (pa * cosine + pb * sine) / _skeleton.getScaleX();
 			zc = (pc * cosine + pd * sine) / _skeleton.getScaleY();
 			s = MathUtil::sqrt(za * za + zc * zc);
@@ -186,12 +197,16 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 				(pa * pd - pb * pc < 0) != (_skeleton.getScaleX() < 0 != _skeleton.getScaleY() < 0))
 				s = -s;
 			r = MathUtil::Pi / 2 + MathUtil::atan2(zc, za);
-			zb = MathUtil::cos(r) * s;
-			zd = MathUtil::sin(r) * s;
-			la = MathUtil::cosDeg(shearX) * scaleX;
-			lb = MathUtil::cosDeg(90 + shearY) * scaleY;
-			lc = MathUtil::sinDeg(shearX) * scaleX;
-			ld = MathUtil::sinDeg(90 + shearY) * scaleY;
+			MathUtil::sincos(r, zd, zb);
+			zb *= s;
+			zd *= s;
+			float cosX, sinX, cosY, sinY;
+			MathUtil::sincosDeg(shearX, sinX, cosX);
+			MathUtil::sincosDeg(90 + shearY, sinY, cosY);
+			la = cosX * scaleX;
+			lb = cosY * scaleY;
+			lc = sinX * scaleX;
+			ld = sinY * scaleY;
 			_a = za * la + zb * lc;
 			_b = za * lb + zb * ld;
 			_c = zc * la + zd * lc;
@@ -236,8 +251,8 @@ void Bone::localToWorld(float localX, float localY, float &outWorldX, float &out
 }
 
 float Bone::worldToLocalRotation(float worldRotation) {
-	float sin = MathUtil::sinDeg(worldRotation);
-	float cos = MathUtil::cosDeg(worldRotation);
+	float sin, cos;
+	MathUtil::sincosDeg(worldRotation, sin, cos);
 
 	return MathUtil::atan2(_a * sin - _c * cos, _d * cos - _b * sin) * MathUtil::Rad_Deg + this->_rotation -
 		   this->_shearX;
@@ -245,8 +260,8 @@ float Bone::worldToLocalRotation(float worldRotation) {
 
 float Bone::localToWorldRotation(float localRotation) {
 	localRotation -= this->_rotation - this->_shearX;
-	float sin = MathUtil::sinDeg(localRotation);
-	float cos = MathUtil::cosDeg(localRotation);
+	float sin, cos;
+	MathUtil::sincosDeg(localRotation, sin, cos);
 
 	return MathUtil::atan2(cos * _c + sin * _d, cos * _a + sin * _b) * MathUtil::Rad_Deg;
 }
@@ -257,8 +272,8 @@ void Bone::rotateWorld(float degrees) {
 	float c = _c;
 	float d = _d;
 
-	float cos = MathUtil::cosDeg(degrees);
-	float sin = MathUtil::sinDeg(degrees);
+	float sin, cos;
+	MathUtil::sincosDeg(degrees, sin, cos);
 
 	_a = cos * a - sin * c;
 	_b = cos * b - sin * d;
@@ -537,3 +552,49 @@ bool Bone::isActive() {
 void Bone::setActive(bool inValue) {
 	_active = inValue;
 }
+
+void Bone::getPose(float *pose) {
+	pose[BonePose_X] = _x;
+	pose[BonePose_Y] = _y;
+	pose[BonePose_Rotation] = _rotation;
+	pose[BonePose_ScaleX] = _scaleX;
+	pose[BonePose_ScaleY] = _scaleY;
+	pose[BonePose_ShearX] = _shearX;
+	pose[BonePose_ShearY] = _shearY;
+	pose[BonePose_AX] = _ax;
+	pose[BonePose_AY] = _ay;
+	pose[BonePose_ARotation] = _arotation;
+	pose[BonePose_AScaleX] = _ascaleX;
+	pose[BonePose_AScaleY] = _ascaleY;
+	pose[BonePose_AShearX] = _ashearX;
+	pose[BonePose_AShearY] = _ashearY;
+	pose[BonePose_A] = _a;
+	pose[BonePose_B] = _b;
+	pose[BonePose_C] = _c;
+	pose[BonePose_D] = _d;
+	pose[BonePose_WorldX] = _worldX;
+	pose[BonePose_WorldY] = _worldY;
+}
+
+void Bone::setPose(const float *pose) {
+	_x = pose[BonePose_X];
+	_y = pose[BonePose_Y];
+	_rotation = pose[BonePose_Rotation];
+	_scaleX = pose[BonePose_ScaleX];
+	_scaleY = pose[BonePose_ScaleY];
+	_shearX = pose[BonePose_ShearX];
+	_shearY = pose[BonePose_ShearY];
+	_ax = pose[BonePose_AX];
+	_ay = pose[BonePose_AY];
+	_arotation = pose[BonePose_ARotation];
+	_ascaleX = pose[BonePose_AScaleX];
+	_ascaleY = pose[BonePose_AScaleY];
+	_ashearX = pose[BonePose_AShearX];
+	_ashearY = pose[BonePose_AShearY];
+	_a = pose[BonePose_A];
+	_b = pose[BonePose_B];
+	_c = pose[BonePose_C];
+	_d = pose[BonePose_D];
+	_worldX = pose[BonePose_WorldX];
+	_worldY = pose[BonePose_WorldY];
+}
@@ -33,6 +33,7 @@
 
 #include <spine/CurveTimeline.h>
 
+#include <spine/Animation.h>
 #include <spine/MathUtil.h>
 
 using namespace spine;
@@ -41,6 +42,7 @@ RTTI_IMPL(CurveTimeline, Timeline)
 
 CurveTimeline::CurveTimeline(size_t frameCount, size_t frameEntries, size_t bezierCount) : Timeline(frameCount,
 																									frameEntries) {
+	_curves.ensureCapacity(frameCount + bezierCount * BEZIER_SIZE);
 	_curves.setSize(frameCount + bezierCount * BEZIER_SIZE, 0);
 	_curves[frameCount - 1] = STEPPED;
 }
@@ -115,13 +117,7 @@ void CurveTimeline1::setFrame(size_t frame, float time, float value) {
 }
 
 float CurveTimeline1::getCurveValue(float time) {
-	int i = _frames.size() - 2;
-	for (int ii = 2; ii <= i; ii += 2) {
-		if (_frames[ii] > time) {
-			i = ii - 2;
-			break;
-		}
-	}
+	int i = Animation::search(_frames, time, CurveTimeline1::ENTRIES);
 
 	int curveType = (int) _curves[i >> 1];
 	switch (curveType) {
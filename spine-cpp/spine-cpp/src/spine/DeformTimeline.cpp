@@ -48,16 +48,186 @@ using namespace spine;
 
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
+namespace {
+	inline float getOffset(const float *offsets, size_t i, float scale) {
+		SP_UNUSED(scale);
+		return offsets[i];
+	}
+
+	inline float getOffset(const short *offsets, size_t i, float scale) {
+		return offsets[i] * scale;
+	}
+
+	/// Vertices are computed and mixed in chunks, so the loops over them stay simple.
+	const size_t ChunkSize = 256;
+
+	const float zeros[ChunkSize] = {0};
+
+	/// The vertices of a frame, computed from its offsets and the setup vertices, or NULL for weighted attachments.
+	template<typename T>
+	struct FrameVertices {
+		const float *setup;
+		const T *offsets;
+		float scale;
+		size_t start, end;
+
+		/// Computes count vertices starting at vertex first into values. Returns the vertices, which are the setup
+		/// vertices or zeros if none of them is moved by the frame.
+		const float *compute(float *values, size_t first, size_t count) const {
+			size_t rangeStart = MathUtil::max(first, start), rangeEnd = MathUtil::min(first + count, end);
+			if (rangeStart >= rangeEnd) return setup ? setup + first : zeros;
+			if (setup)
+				memcpy(values, setup + first, count * sizeof(float));
+			else
+				memset(values, 0, count * sizeof(float));
+			for (size_t i = rangeStart; i < rangeEnd; i++) {
+				float offset = getOffset(offsets, i - start, scale);
+				values[i - first] = setup ? setup[i] + offset : offset;
+			}
+			return values;
+		}
+	};
+
+	template<typename T>
+	struct InterpolatedVertices {
+		FrameVertices<T> prev, next;
+		float percent;
+
+		/// Only the vertices moved by either frame are interpolated, the others are the same in both frames.
+		const float *compute(float *values, size_t first, size_t count) const {
+			size_t start = next.start, end = next.end;
+			if (start == end) {
+				start = prev.start;
+				end = prev.end;
+			} else if (prev.start != prev.end) {
+				start = MathUtil::min(start, prev.start);
+				end = MathUtil::max(end, prev.end);
+			}
+			start = MathUtil::max(start, first);
+			end = MathUtil::min(end, first + count);
+			const float *prevValues = prev.compute(values, first, count);
+			if (start >= end) return prevValues;
+			if (prevValues != values) memcpy(values, prevValues, count * sizeof(float));
+			float nextBuffer[ChunkSize];
+			const float *nextValues = next.compute(nextBuffer, start, end - start);
+			float *interpolated = values + (start - first);
+			for (size_t i = 0, n = end - start; i < n; i++) {
+				float prevValue = interpolated[i];
+				interpolated[i] = prevValue + (nextValues[i] - prevValue) * percent;
+			}
+			return values;
+		}
+	};
+
+	template<typename T>
+	struct FrameSource {
+		const unsigned int *ranges;
+		const T *offsets;
+		const float *scales;
+		const float *setup;
+
+		FrameVertices<T> get(size_t frame) const {
+			const unsigned int *range = ranges + frame * 3;
+			FrameVertices<T> vertices = {setup, offsets + range[2], scales ? scales[frame] : 1, range[0], range[1]};
+			return vertices;
+		}
+	};
+
+	/// Mixes vertex positions or deform offsets into the deform array.
+	/// @param setup The setup vertices of an unweighted attachment, or NULL for a weighted attachment.
+	void mixVertices(const float *vertices, float *deform, size_t vertexCount, const float *setup, float alpha,
+					 MixBlend blend) {
+		if (alpha == 1) {
+			if (blend == MixBlend_Add) {
+				if (setup) {
+					// Unweighted vertex positions, no alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += vertices[i] - setup[i];
+				} else {
+					// Weighted deform offsets, no alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += vertices[i];
+				}
+			} else {
+				// Vertex positions or deform offsets, no alpha.
+				memcpy(deform, vertices, vertexCount * sizeof(float));
+			}
+			return;
+		}
+		switch (blend) {
+			case MixBlend_Setup:
+				if (setup) {
+					// Unweighted vertex positions, with alpha.
+					for (size_t i = 0; i < vertexCount; i++) {
+						float setupValue = setup[i];
+						deform[i] = setupValue + (vertices[i] - setupValue) * alpha;
+					}
+				} else {
+					// Weighted deform offsets, with alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] = vertices[i] * alpha;
+				}
+				break;
+			case MixBlend_First:
+			case MixBlend_Replace:
+				// Vertex positions or deform offsets, with alpha.
+				for (size_t i = 0; i < vertexCount; i++)
+					deform[i] += (vertices[i] - deform[i]) * alpha;
+				break;
+			case MixBlend_Add:
+				if (setup) {
+					// Unweighted vertex positions, with alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += (vertices[i] - setup[i]) * alpha;
+				} else {
+					// Weighted deform offsets, with alpha.
+					for (size_t i = 0; i < vertexCount; i++)
+						deform[i] += vertices[i] * alpha;
+				}
+		}
+	}
+
+	template<typename T>
+	void copyVertices(const FrameVertices<T> &frameVertices, float *vertices, size_t vertexCount) {
+		for (size_t first = 0; first < vertexCount; first += ChunkSize) {
+			size_t count = MathUtil::min(ChunkSize, vertexCount - first);
+			const float *chunk = frameVertices.compute(vertices + first, first, count);
+			if (chunk != vertices + first) memcpy(vertices + first, chunk, count * sizeof(float));
+		}
+	}
+
+	template<typename V>
+	void applyVertices(const V &vertices, float *deform, size_t vertexCount, const float *setup, float alpha,
+					   MixBlend blend) {
+		float values[ChunkSize];
+		for (size_t first = 0; first < vertexCount; first += ChunkSize) {
+			size_t count = MathUtil::min(ChunkSize, vertexCount - first);
+			const float *chunk = vertices.compute(values, first, count);
+			mixVertices(chunk, deform + first, count, setup ? setup + first : NULL, alpha, blend);
+		}
+	}
+
+	/// Applies the last frame if next is false, else interpolates between the frame and the next frame.
+	template<typename T>
+	void applyFrames(const FrameSource<T> &source, size_t frame, bool next, float percent, float *deform,
+					 size_t vertexCount, const float *setup, float alpha, MixBlend blend) {
+		if (!next) {
+			applyVertices(source.get(frame), deform, vertexCount, setup, alpha, blend);
+			return;
+		}
+		InterpolatedVertices<T> vertices = {source.get(frame), source.get(frame + 1), percent};
+		applyVertices(vertices, deform, vertexCount, setup, alpha, blend);
+	}
+}
+
 DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIndex, VertexAttachment *attachment)
 	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment) {
 	PropertyId ids[] = {((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | attachment->_id) & 0xffffffff)};
 	setPropertyIds(ids, 1);
 
-	_vertices.ensureCapacity(frameCount);
-	for (size_t i = 0; i < frameCount; ++i) {
-		Vector<float> vec;
-		_vertices.add(vec);
-	}
+	Vector<float> &vertices = attachment->_vertices;
+	_vertexCount = attachment->_bones.size() > 0 ? vertices.size() / 3 * 2 : vertices.size();
+	_ranges.setSize(frameCount * 3, 0);
 }
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
@@ -85,8 +255,7 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		blend = MixBlend_Setup;
 	}
 
-	Vector<Vector<float>> &vertices = _vertices;
-	size_t vertexCount = vertices[0].size();
+	size_t vertexCount = _vertexCount;
 
 	Vector<float> &frames = _frames;
 	if (time < _frames[0]) {
@@ -121,143 +290,25 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 	}
 
 	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
 
-	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
-		Vector<float> &lastVertices = vertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
-		} else {
-			switch (blend) {
-				case MixBlend_Setup: {
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, with alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deform[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						// Weighted deform offsets, with alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] = lastVertices[i] * alpha;
-					}
-					break;
-				}
-				case MixBlend_First:
-				case MixBlend_Replace:
-					// Vertex positions or deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - deform[i]) * alpha;
-					break;
-				case MixBlend_Add:
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, no alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-					} else {
-						// Weighted deform offsets, alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += lastVertices[i] * alpha;
-					}
-			}
-		}
-		return;
+	// The frames are offsets from the setup vertices of the timeline's attachment, blending uses the slot's attachment.
+	const float *frameSetup = _attachment->_bones.size() == 0 ? _attachment->_vertices.buffer() : NULL;
+	const float *setup = attachment->_bones.size() == 0 ? attachment->_vertices.buffer() : NULL;
+	size_t frame = frames.size() - 1;
+	bool next = false;
+	float percent = 0;
+	if (time < frames[frame]) {
+		// Interpolate between the previous frame and the current frame.
+		frame = (size_t) Animation::search(frames, time);
+		percent = getCurvePercent(time, (int) frame);
+		next = true;
 	}
-
-	// Interpolate between the previous frame and the current frame.
-	int frame = Animation::search(frames, time);
-	float percent = getCurvePercent(time, frame);
-	Vector<float> &prevVertices = vertices[frame];
-	Vector<float> &nextVertices = vertices[frame + 1];
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
+	if (isQuantized()) {
+		FrameSource<short> source = {_ranges.buffer(), _quantizedOffsets.buffer(), _scales.buffer(), frameSetup};
+		applyFrames(source, frame, next, percent, deformArray.buffer(), vertexCount, setup, alpha, blend);
 	} else {
-		switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-				}
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-		}
+		FrameSource<float> source = {_ranges.buffer(), _offsets.buffer(), NULL, frameSetup};
+		applyFrames(source, frame, next, percent, deformArray.buffer(), vertexCount, setup, alpha, blend);
 	}
 }
 
@@ -314,13 +365,73 @@ float DeformTimeline::getCurvePercent(float time, int frame) {
 }
 
 void DeformTimeline::setFrame(int frame, float time, Vector<float> &vertices) {
+	assert(vertices.size() == _vertexCount);
 	_frames[frame] = time;
-	_vertices[frame].clear();
-	_vertices[frame].addAll(vertices);
+	_vertices.clear();
+	setFrameOffsets(frame, vertices);
 }
 
-Vector<Vector<float>> &DeformTimeline::getVertices() {
-	return _vertices;
+void DeformTimeline::setFrameOffsets(int frame, Vector<float> &vertices) {
+	const float *setup = _attachment->_bones.size() == 0 ? _attachment->_vertices.buffer() : NULL;
+	size_t start = 0, end = vertices.size();
+	while (start < end && vertices[start] == (setup ? setup[start] : 0))
+		start++;
+	while (end > start && vertices[end - 1] == (setup ? setup[end - 1] : 0))
+		end--;
+	float *offsets = setFrameRange(frame, start, end);
+	for (size_t i = start; i < end; i++)
+		offsets[i - start] = setup ? vertices[i] - setup[i] : vertices[i];
+}
+
+float *DeformTimeline::setFrameRange(int frame, size_t start, size_t end) {
+	assert(!isQuantized());
+	size_t index = _offsets.size();
+	unsigned int *range = _ranges.buffer() + frame * 3;
+	range[0] = (unsigned int) start;
+	range[1] = (unsigned int) end;
+	range[2] = (unsigned int) index;
+	_offsets.setSize(index + end - start, 0);
+	return _offsets.buffer() + index;
+}
+
+void DeformTimeline::getFrameVertices(size_t frame, Vector<float> &vertices) {
+	const float *setup = _attachment->_bones.size() == 0 ? _attachment->_vertices.buffer() : NULL;
+	vertices.setSize(_vertexCount, 0);
+	if (isQuantized()) {
+		FrameSource<short> source = {_ranges.buffer(), _quantizedOffsets.buffer(), _scales.buffer(), setup};
+		copyVertices(source.get(frame), vertices.buffer(), _vertexCount);
+	} else {
+		FrameSource<float> source = {_ranges.buffer(), _offsets.buffer(), NULL, setup};
+		copyVertices(source.get(frame), vertices.buffer(), _vertexCount);
+	}
+}
+
+void DeformTimeline::quantize() {
+	if (isQuantized()) return;
+	_vertices.clear();
+	size_t frameCount = getFrameCount();
+	_scales.ensureCapacity(frameCount);
+	_scales.setSize(frameCount, 0);
+	_quantizedOffsets.ensureCapacity(_offsets.size());
+	_quantizedOffsets.setSize(_offsets.size(), 0);
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		unsigned int *range = _ranges.buffer() + frame * 3;
+		float *offsets = _offsets.buffer() + range[2];
+		short *quantized = _quantizedOffsets.buffer() + range[2];
+		size_t count = range[1] - range[0];
+		float max = 0;
+		for (size_t i = 0; i < count; i++)
+			max = MathUtil::max(max, MathUtil::abs(offsets[i]));
+		float scale = max / 32767;
+		_scales[frame] = scale;
+		if (scale == 0) continue;
+		for (size_t i = 0; i < count; i++) {
+			float value = offsets[i] / scale;
+			quantized[i] = (short) (value >= 0 ? value + 0.5f : value - 0.5f);
+		}
+	}
+	_offsets.clear();
+	_offsets.shrink();
 }
 
 VertexAttachment *DeformTimeline::getAttachment() {
@@ -328,5 +439,33 @@ VertexAttachment *DeformTimeline::getAttachment() {
 }
 
 void DeformTimeline::setAttachment(VertexAttachment *inValue) {
+	if (inValue == _attachment) return;
+	Vector<Vector<float> > vertices;
+	vertices.clearAndAddAll(getVertices());
+	bool quantized = isQuantized();
 	_attachment = inValue;
+	_vertexCount = inValue->_bones.size() > 0 ? inValue->_vertices.size() / 3 * 2 : inValue->_vertices.size();
+	_offsets.clear();
+	_quantizedOffsets.clear();
+	_scales.clear();
+	_vertices.clear();
+	const float *setup = inValue->_bones.size() == 0 ? inValue->_vertices.buffer() : NULL;
+	for (size_t frame = 0, n = getFrameCount(); frame < n; frame++) {
+		Vector<float> &frameVertices = vertices[frame];
+		for (size_t i = frameVertices.size(); i < _vertexCount; i++)
+			frameVertices.add(setup ? setup[i] : 0);
+		frameVertices.setSize(_vertexCount, 0);
+		setFrameOffsets((int) frame, frameVertices);
+	}
+	if (quantized) quantize();
+}
+
+Vector<Vector<float> > &DeformTimeline::getVertices() {
+	size_t frameCount = getFrameCount();
+	if (_vertices.size() != frameCount) {
+		_vertices.setSize(frameCount, Vector<float>());
+		for (size_t frame = 0; frame < frameCount; frame++)
+			getFrameVertices(frame, _vertices[frame]);
+	}
+	return _vertices;
 }
@@ -52,6 +52,7 @@ RTTI_IMPL(EventTimeline, Timeline)
 EventTimeline::EventTimeline(size_t frameCount) : Timeline(frameCount, 1) {
 	PropertyId ids[] = {((PropertyId) Property_Event << 32)};
 	setPropertyIds(ids, 1);
+	_events.ensureCapacity(frameCount);
 	_events.setSize(frameCount, NULL);
 }
 
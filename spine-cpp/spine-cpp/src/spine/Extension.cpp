@@ -36,26 +36,50 @@
 
 #include <assert.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define SPINE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace spine;
 
-SpineExtension *SpineExtension::_instance = NULL;
+std::atomic<SpineExtension *> SpineExtension::_instance(NULL);
 
 void SpineExtension::setInstance(SpineExtension *inValue) {
 	assert(inValue);
 
-	_instance = inValue;
+	_instance.store(inValue, std::memory_order_release);
 }
 
 SpineExtension *SpineExtension::getInstance() {
-	if (!_instance) _instance = spine::getDefaultExtension();
-	assert(_instance);
+	SpineExtension *instance = _instance.load(std::memory_order_acquire);
+	if (!instance) {
+		// The default extension is created once, even if several threads get here at the same time.
+		static SpineExtension *defaultExtension = spine::getDefaultExtension();
+		if (_instance.compare_exchange_strong(instance, defaultExtension, std::memory_order_acq_rel))
+			instance = defaultExtension;
+	}
+	assert(instance);
 
-	return _instance;
+	return instance;
 }
 
 SpineExtension::~SpineExtension() {
 }
 
+const char *SpineExtension::_mapFile(const String &path, int *length) {
+	return _readFile(path, length);
+}
+
+void SpineExtension::_unmapFile(const char *data, int length) {
+	SP_UNUSED(length);
+	// _readFile() implementations allocate through SpineExtension::alloc(), so the data is freed the same way.
+	SpineExtension::free(data, __FILE__, __LINE__);
+}
+
 SpineExtension::SpineExtension() {
 }
 
@@ -125,3 +149,33 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
+
+const char *DefaultSpineExtension::_mapFile(const String &path, int *length) {
+#ifdef SPINE_MMAP
+	*length = 0;
+	int file = open(path.buffer(), O_RDONLY);
+	if (file == -1) return NULL;
+	struct stat stats;
+	void *data = MAP_FAILED;
+	if (fstat(file, &stats) == 0 && stats.st_size > 0) {
+		data = mmap(NULL, (size_t) stats.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data != MAP_FAILED) {
+			*length = (int) stats.st_size;
+			// Loaders read the file once from start to end.
+			posix_madvise(data, (size_t) stats.st_size, POSIX_MADV_SEQUENTIAL);
+		}
+	}
+	close(file);
+	return data == MAP_FAILED ? NULL : (const char *) data;
+#else
+	return SpineExtension::_mapFile(path, length);
+#endif
+}
+
+void DefaultSpineExtension::_unmapFile(const char *data, int length) {
+#ifdef SPINE_MMAP
+	if (data) munmap((void *) data, (size_t) length);
+#else
+	SpineExtension::_unmapFile(data, length);
+#endif
+}
@@ -264,13 +264,12 @@ IkConstraint::IkConstraint(IkConstraintData &data, Skeleton &skeleton) : Updatab
 																		 _stretch(data.getStretch()),
 																		 _mix(data.getMix()),
 																		 _softness(data.getSoftness()),
-																		 _target(skeleton.findBone(
-																				 data.getTarget()->getName())),
+																		 _target(skeleton.getBones()[data.getTarget()->getIndex()]),
 																		 _active(false) {
 	_bones.ensureCapacity(_data.getBones().size());
 	for (size_t i = 0; i < _data.getBones().size(); i++) {
 		BoneData *boneData = _data.getBones()[i];
-		_bones.add(skeleton.findBone(boneData->getName()));
+		_bones.add(skeleton.getBones()[boneData->getIndex()]);
 	}
 }
 
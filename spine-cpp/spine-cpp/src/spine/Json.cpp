@@ -55,11 +55,44 @@ const int Json::JSON_STRING = 4;
 const int Json::JSON_ARRAY = 5;
 const int Json::JSON_OBJECT = 6;
 
-const char *Json::_error = NULL;
+/* Objects with more items than this get a hash table of their items, smaller ones are searched linearly. */
+static const int MinIndexedSize = 8;
+
+/* Exact powers of ten, so scaling by them gives the same result as pow(). */
+static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+									1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+static double powerOf10(double exponent) {
+	return exponent <= 22 ? powersOf10[(int) exponent] : pow(10.0, exponent);
+}
+
+/* Accumulates the digits like value = value * 10 + digit in doubles, using integer math for the first 15 digits, which
+ * is exact. */
+static char *parseDigits(char *ptr, double &value, int &count) {
+	unsigned long long digits = 0;
+	int n = 0;
+	for (; n < 15 && *ptr >= '0' && *ptr <= '9'; ++ptr, ++n) {
+		digits = digits * 10 + (*ptr - '0');
+	}
+	value = (double) digits;
+	for (; *ptr >= '0' && *ptr <= '9'; ++ptr, ++n) {
+		value = value * 10.0 + (*ptr - '0');
+	}
+	count = n;
+	return ptr;
+}
 
 Json *Json::getItem(Json *object, const char *string) {
+	unsigned int h = hash(string);
+	if (object->_index) {
+		size_t mask = indexCapacity(object->_size) - 1;
+		for (size_t i = h & mask;; i = (i + 1) & mask) {
+			Json *c = object->_index[i];
+			if (!c || (c->_hash == h && !json_strcasecmp(c->_name, string))) return c;
+		}
+	}
 	Json *c = object->_child;
-	while (c && json_strcasecmp(c->_name, string)) {
+	while (c && (c->_hash != h || json_strcasecmp(c->_name, string))) {
 		c = c->_next;
 	}
 	return c;
@@ -107,10 +140,6 @@ bool Json::getBoolean(spine::Json *value, const char *name, bool defaultValue) {
 	}
 }
 
-const char *Json::getError() {
-	return _error;
-}
-
 Json::Json(const char *value) : _next(NULL),
 #if SPINE_JSON_HAVE_PREV
 								_prev(NULL),
@@ -121,31 +150,63 @@ Json::Json(const char *value) : _next(NULL),
 								_valueString(NULL),
 								_valueInt(0),
 								_valueFloat(0),
-								_name(NULL) {
+								_name(NULL),
+								_hash(0),
+								_index(NULL),
+								_blocks(NULL),
+								_error(NULL) {
 	if (value) {
-		value = parseValue(this, skip(value));
-
-		assert(value);
+		parseValue(this, skip(value));
 	}
 }
 
 Json::~Json() {
-	spine::Json *curr = NULL;
-	spine::Json *next = _child;
-	do {
-		curr = next;
-		if (curr) {
-			next = curr->_next;
-		}
-		delete curr;
-	} while (next);
-
-	if (_valueString) {
-		SpineExtension::free(_valueString, __FILE__, __LINE__);
+	/* The items are allocated in the blocks and need no destruction. */
+	Block *block = _blocks;
+	while (block) {
+		Block *next = block->next;
+		SpineExtension::free(block, __FILE__, __LINE__);
+		block = next;
 	}
+}
+
+void *Json::alloc(size_t size) {
+	size = (size + 7) & ~(size_t) 7;
+	Block *block = _blocks;
+	if (!block || block->size - block->used < size) {
+		size_t blockSize = block ? block->size * 2 : 64 * 1024;
+		if (blockSize > 1024 * 1024) blockSize = 1024 * 1024;
+		if (blockSize < size) blockSize = size;
+		block = (Block *) SpineExtension::alloc<char>(sizeof(Block) + blockSize, __FILE__, __LINE__);
+		block->next = _blocks;
+		block->size = blockSize;
+		block->used = 0;
+		_blocks = block;
+	}
+	void *mem = (char *) (block + 1) + block->used;
+	block->used += size;
+	return mem;
+}
+
+Json *Json::createItem() {
+	return new (alloc(sizeof(Json))) Json(NULL);
+}
 
-	if (_name) {
-		SpineExtension::free(_name, __FILE__, __LINE__);
+size_t Json::indexCapacity(int size) {
+	size_t capacity = 16;
+	while (capacity < (size_t) size * 2) capacity <<= 1;
+	return capacity;
+}
+
+void Json::indexObject(Json *item) {
+	/* Linear probing keeps items with the same name in document order, so the first is found first. */
+	size_t capacity = indexCapacity(item->_size), mask = capacity - 1;
+	item->_index = (Json **) alloc(capacity * sizeof(Json *));
+	memset(item->_index, 0, capacity * sizeof(Json *));
+	for (Json *child = item->_child; child; child = child->_next) {
+		size_t i = child->_hash & mask;
+		while (item->_index[i]) i = (i + 1) & mask;
+		item->_index[i] = child;
 	}
 }
 
@@ -229,6 +290,7 @@ const char *Json::parseString(Json *item, const char *str) {
 	char *ptr2;
 	char *out;
 	int len = 0;
+	bool escaped = false;
 	unsigned uc, uc2;
 	if (*str != '\"') {
 		/* TODO: don't need this check when called from parseValue, but do need from parseObject */
@@ -239,12 +301,19 @@ const char *Json::parseString(Json *item, const char *str) {
 	while (*ptr != '\"' && *ptr && ++len) {
 		if (*ptr++ == '\\') {
 			ptr++; /* Skip escaped quotes. */
+			escaped = true;
 		}
 	}
 
-	out = SpineExtension::alloc<char>(len + 1, __FILE__, __LINE__); /* The length needed for the string, roughly. */
-	if (!out) {
-		return 0;
+	out = (char *) alloc(len + 1); /* The length needed for the string, roughly. */
+
+	if (!escaped) {
+		/* Most strings have no escapes and are copied as they are. */
+		memcpy(out, str + 1, len);
+		out[len] = 0;
+		item->_valueString = out;
+		item->_type = JSON_STRING;
+		return *ptr == '\"' ? ptr + 1 : ptr;
 	}
 
 	ptr = str + 1;
@@ -351,22 +420,13 @@ const char *Json::parseNumber(Json *item, const char *num) {
 		++ptr;
 	}
 
-	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
-		++ptr;
-	}
+	int digits = 0;
+	ptr = parseDigits(ptr, result, digits);
 
 	if (*ptr == '.') {
 		double fraction = 0.0;
-		int n = 0;
-		++ptr;
-
-		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
-			++ptr;
-			++n;
-		}
-		result += fraction / pow(10.0, n);
+		ptr = parseDigits(ptr + 1, fraction, digits);
+		result += fraction / powerOf10(digits);
 	}
 
 	if (negative) {
@@ -393,9 +453,9 @@ const char *Json::parseNumber(Json *item, const char *num) {
 		}
 
 		if (expNegative) {
-			result = result / pow(10, exponent);
+			result = result / powerOf10(exponent);
 		} else {
-			result = result * pow(10, exponent);
+			result = result * powerOf10(exponent);
 		}
 	}
 
@@ -428,7 +488,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
+	item->_child = child = createItem();
 	if (!item->_child) {
 		return NULL; /* memory fail */
 	}
@@ -442,7 +502,7 @@ const char *Json::parseArray(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
+		Json *new_item = createItem();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -484,20 +544,14 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
+	item->_child = child = createItem();
 	if (!item->_child) {
 		return NULL;
 	}
-	value = skip(parseString(child, skip(value)));
+	value = parseName(child, skip(value));
 	if (!value) {
 		return NULL;
 	}
-	child->_name = child->_valueString;
-	child->_valueString = 0;
-	if (*value != ':') {
-		_error = value;
-		return NULL;
-	} /* fail! */
 
 	value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
 	if (!value) {
@@ -507,7 +561,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
+		Json *new_item = createItem();
 		if (!new_item) {
 			return NULL; /* memory fail */
 		}
@@ -516,16 +570,10 @@ const char *Json::parseObject(Json *item, const char *value) {
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parseString(child, skip(value + 1)));
+		value = parseName(child, skip(value + 1));
 		if (!value) {
 			return NULL;
 		}
-		child->_name = child->_valueString;
-		child->_valueString = 0;
-		if (*value != ':') {
-			_error = value;
-			return NULL;
-		} /* fail! */
 
 		value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
 		if (!value) {
@@ -535,6 +583,7 @@ const char *Json::parseObject(Json *item, const char *value) {
 	}
 
 	if (*value == '}') {
+		if (item->_size > MinIndexedSize) indexObject(item);
 		return value + 1; /* end of array */
 	}
 
@@ -543,6 +592,32 @@ const char *Json::parseObject(Json *item, const char *value) {
 	return NULL; /* malformed. */
 }
 
+const char *Json::parseName(Json *item, const char *value) {
+	value = skip(parseString(item, value));
+	if (!value) {
+		return NULL;
+	}
+	item->_name = item->_valueString;
+	item->_valueString = 0;
+	item->_hash = hash(item->_name);
+	if (*value != ':') {
+		_error = value;
+		return NULL;
+	} /* fail! */
+	return value;
+}
+
+unsigned int Json::hash(const char *string) {
+	/* FNV-1a of the characters with the lowercase bit set, so names differing only in case hash the same. */
+	unsigned int h = 2166136261u;
+	if (string) {
+		for (; *string; string++) {
+			h = (h ^ (unsigned char) (*string | 0x20)) * 16777619u;
+		}
+	}
+	return h;
+}
+
 int Json::json_strcasecmp(const char *s1, const char *s2) {
 	/* TODO we may be able to elide these NULL checks if we can prove
 	 * the graph and input (only callsite is Json_getItem) should not have NULLs
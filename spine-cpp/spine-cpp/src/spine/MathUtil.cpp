@@ -64,22 +64,93 @@ float MathUtil::fmod(float a, float b) {
 	return (float) ::fmod(a, b);
 }
 
-/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+#ifdef SPINE_FAST_TRIG
+/// Computes the sine and cosine of x in [-Pi / 4, Pi / 4] rotated by quadrant quarter turns. The polynomials are the
+/// minimax approximations of Cephes' sinf and cosf.
+static inline void sincosQuadrant(float x, int quadrant, float &sine, float &cosine) {
+	float x2 = x * x;
+	float s = ((-1.9515295891e-4f * x2 + 8.3321608736e-3f) * x2 - 1.6666654611e-1f) * x2 * x + x;
+	float c = ((2.443315711809948e-5f * x2 - 1.388731625493765e-3f) * x2 + 4.166664568298827e-2f) * x2 * x2 -
+			  0.5f * x2 + 1;
+	if (quadrant & 1) {
+		float t = s;
+		s = c;
+		c = -t;
+	}
+	sine = quadrant & 2 ? -s : s;
+	cosine = quadrant & 2 ? -c : c;
+}
+
+static inline int roundToInt(float x) {
+	return (int) (x < 0 ? x - 0.5f : x + 0.5f);
+}
+
+static inline bool fastSincos(float radians, float &sine, float &cosine) {
+	if (!(radians > -8192 && radians < 8192)) return false;
+	int quadrant = roundToInt(radians * 0.63661977236758134f);
+	float q = (float) quadrant;
+	// Pi / 2 split into three parts, the first two with few enough bits that multiplying them by q is exact.
+	float x = ((radians - q * 1.5703125f) - q * 4.837512969970703125e-4f) - q * 7.54978995489188216e-8f;
+	sincosQuadrant(x, quadrant, sine, cosine);
+	return true;
+}
+
+static inline bool fastSincosDeg(float degrees, float &sine, float &cosine) {
+	if (!(degrees > -1e8f && degrees < 1e8f)) return false;
+	// Reduced in double, where the quadrant times 90 is exact for the whole range. In float it isn't above 2^25 degrees.
+	double quadrant = ::floor(degrees * (1 / 90.0) + 0.5);
+	sincosQuadrant((float) (degrees - quadrant * 90) * MathUtil::Deg_Rad, (int) quadrant, sine, cosine);
+	return true;
+}
+#endif
+
 float MathUtil::atan2(float y, float x) {
+#ifdef SPINE_FAST_TRIG
+	float ax = abs(x), ay = abs(y);
+	float t = ay > ax ? ax / ay : ay / ax;
+	// t is NaN if both are zero or infinite or either is NaN, those are left to the C library.
+	if (t <= 1) {
+		float offset = 0;
+		if (t > 0.41421356237309505f) {
+			t = (t - 1) / (t + 1);
+			offset = 0.78539816339744831f;
+		}
+		// The minimax polynomial of Cephes' atanf on [-tan(Pi / 8), tan(Pi / 8)].
+		float z = t * t;
+		float a = offset + (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z -
+							3.33329491539e-1f) * z * t + t;
+		if (ay > ax) a = 1.5707963267948966f - a;
+		if (x < 0) a = Pi - a;
+		return y < 0 ? -a : a;
+	}
+#endif
 	return (float) ::atan2(y, x);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cos(float radians) {
+#ifdef SPINE_FAST_TRIG
+	float sine, cosine;
+	if (fastSincos(radians, sine, cosine)) return cosine;
+#endif
 	return (float) ::cos(radians);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sin(float radians) {
+#ifdef SPINE_FAST_TRIG
+	float sine, cosine;
+	if (fastSincos(radians, sine, cosine)) return sine;
+#endif
 	return (float) ::sin(radians);
 }
 
+void MathUtil::sincos(float radians, float &sine, float &cosine) {
+#ifdef SPINE_FAST_TRIG
+	if (fastSincos(radians, sine, cosine)) return;
+#endif
+	sine = (float) ::sin(radians);
+	cosine = (float) ::cos(radians);
+}
+
 float MathUtil::sqrt(float v) {
 	return (float) ::sqrt(v);
 }
@@ -88,16 +159,31 @@ float MathUtil::acos(float v) {
 	return (float) ::acos(v);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sinDeg(float degrees) {
+#ifdef SPINE_FAST_TRIG
+	float sine, cosine;
+	if (fastSincosDeg(degrees, sine, cosine)) return sine;
+#endif
 	return (float) ::sin(degrees * MathUtil::Deg_Rad);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cosDeg(float degrees) {
+#ifdef SPINE_FAST_TRIG
+	float sine, cosine;
+	if (fastSincosDeg(degrees, sine, cosine)) return cosine;
+#endif
 	return (float) ::cos(degrees * MathUtil::Deg_Rad);
 }
 
+void MathUtil::sincosDeg(float degrees, float &sine, float &cosine) {
+#ifdef SPINE_FAST_TRIG
+	if (fastSincosDeg(degrees, sine, cosine)) return;
+#endif
+	float radians = degrees * MathUtil::Deg_Rad;
+	sine = (float) ::sin(radians);
+	cosine = (float) ::cos(radians);
+}
+
 /* Need to pass 0 as an argument, so VC++ doesn't error with C2124 */
 static bool _isNan(float value, float zero) {
 	float _nan = (float) 0.0 / zero;
@@ -255,6 +255,7 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 		_edges.clearAndAddAll(inValue->_edges);
 		_width = inValue->_width;
 		_height = inValue->_height;
+		updateWeightBlocks();
 	}
 }
 
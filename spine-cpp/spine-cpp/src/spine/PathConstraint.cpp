@@ -53,21 +53,23 @@ const int PathConstraint::AFTER = -3;
 
 PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : Updatable(),
 																			   _data(data),
-																			   _target(skeleton.findSlot(
-																					   data.getTarget()->getName())),
+																			   _target(skeleton.getSlots()[data.getTarget()->getIndex()]),
 																			   _position(data.getPosition()),
 																			   _spacing(data.getSpacing()),
 																			   _mixRotate(data.getMixRotate()),
 																			   _mixX(data.getMixX()),
 																			   _mixY(data.getMixY()),
-																			   _active(false) {
+																			   _active(false),
+																			   _cachedPath(NULL),
+																			   _worldCached(false),
+																			   _positionsCached(false),
+																			   _cachedPosition(0),
+																			   _cachedTangents(false) {
 	_bones.ensureCapacity(_data.getBones().size());
 	for (size_t i = 0; i < _data.getBones().size(); i++) {
 		BoneData *boneData = _data.getBones()[i];
-		_bones.add(skeleton.findBone(boneData->getName()));
+		_bones.add(skeleton.getBones()[boneData->getIndex()]);
 	}
-
-	_segments.setSize(10, 0);
 }
 
 void PathConstraint::update() {
@@ -198,8 +200,7 @@ void PathConstraint::update() {
 			r -= MathUtil::atan2(c, a);
 
 			if (tip) {
-				cos = MathUtil::cos(r);
-				sin = MathUtil::sin(r);
+				MathUtil::sincos(r, sin, cos);
 				float length = bone._data.getLength();
 				boneX += (length * (cos * a - sin * c) - dx) * mixRotate;
 				boneY += (length * (sin * a + cos * c) - dy) * mixRotate;
@@ -212,8 +213,7 @@ void PathConstraint::update() {
 				r += MathUtil::Pi_2;
 
 			r *= mixRotate;
-			cos = MathUtil::cos(r);
-			sin = MathUtil::sin(r);
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -278,18 +278,84 @@ Slot *PathConstraint::getTarget() {
 
 void PathConstraint::setTarget(Slot *inValue) {
 	_target = inValue;
+	_cachedPath = NULL;
 }
 
 PathConstraintData &PathConstraint::getData() {
 	return _data;
 }
 
+bool PathConstraint::updateCachedPath(PathAttachment &path) {
+	Slot &target = *_target;
+	bool changed = false;
+	if (_cachedPath != &path) {
+		_cachedPath = &path;
+		_cachedPathBones.clear();
+		Vector<size_t> &bones = path.getBones();
+		if (bones.size() == 0)
+			_cachedPathBones.add(&target.getBone());
+		else {
+			Vector<Bone *> &skeletonBones = target.getSkeleton().getBones();
+			for (size_t i = 0, n = bones.size(); i < n;) {
+				size_t nn = bones[i++];
+				for (nn += i; i < nn; i++) {
+					Bone *bone = skeletonBones[bones[i]];
+					if (!_cachedPathBones.contains(bone)) _cachedPathBones.add(bone);
+				}
+			}
+		}
+		changed = true;
+	}
+
+	Vector<float> &deform = target.getDeform();
+	size_t boneCount = _cachedPathBones.size(), inputCount = boneCount * 6 + deform.size();
+	if (_cachedPathInputs.size() != inputCount) {
+		_cachedPathInputs.setSize(inputCount, 0);
+		changed = true;
+	}
+	float *inputs = _cachedPathInputs.buffer();
+	for (size_t i = 0; i < boneCount; i++, inputs += 6) {
+		Bone &bone = *_cachedPathBones[i];
+		if (inputs[0] != bone._a || inputs[1] != bone._b || inputs[2] != bone._c || inputs[3] != bone._d ||
+			inputs[4] != bone._worldX || inputs[5] != bone._worldY) {
+			inputs[0] = bone._a;
+			inputs[1] = bone._b;
+			inputs[2] = bone._c;
+			inputs[3] = bone._d;
+			inputs[4] = bone._worldX;
+			inputs[5] = bone._worldY;
+			changed = true;
+		}
+	}
+	float *deformValues = deform.buffer();
+	for (size_t i = 0, n = deform.size(); i < n; i++) {
+		if (inputs[i] != deformValues[i]) {
+			inputs[i] = deformValues[i];
+			changed = true;
+		}
+	}
+	return changed;
+}
+
 Vector<float> &
 PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, bool tangents) {
 	Slot &target = *_target;
 	float position = _position;
-	_positions.setSize(spacesCount * 3 + 2, 0);
 	Vector<float> &out = _positions;
+
+	// The positions only depend on the world path, the position and the spaces.
+	if (updateCachedPath(path)) {
+		_worldCached = false;
+		_positionsCached = false;
+	}
+	if (_positionsCached && _cachedPosition == position && _cachedTangents == tangents && _cachedSpaces == _spaces)
+		return out;
+	_positionsCached = true;
+	_cachedPosition = position;
+	_cachedTangents = tangents;
+	_cachedSpaces.clearAndAddAll(_spaces);
+
+	_positions.setSize(spacesCount * 3 + 2, 0);
 	Vector<float> &world = _world;
 	bool closed = path.isClosed();
 	int verticesLength = path.getWorldVerticesLength();
@@ -374,56 +440,68 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 		return out;
 	}
 
-	// World vertices.
-	if (closed) {
+	if (closed)
 		verticesLength += 2;
-		world.setSize(verticesLength, 0);
-		path.computeWorldVertices(target, 2, verticesLength - 4, world, 0);
-		path.computeWorldVertices(target, 0, 2, world, verticesLength - 4);
-		world[verticesLength - 2] = world[0];
-		world[verticesLength - 1] = world[1];
-	} else {
+	else {
 		curveCount--;
 		verticesLength -= 4;
-		world.setSize(verticesLength, 0);
-		path.computeWorldVertices(target, 2, verticesLength, world, 0);
 	}
 
-	// Curve lengths.
-	_curves.setSize(curveCount, 0);
-	pathLength = 0;
-	float x1 = world[0], y1 = world[1], cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
+	float x1 = 0, y1 = 0, cx1 = 0, cy1 = 0, cx2 = 0, cy2 = 0, x2 = 0, y2 = 0;
 	float tmpx, tmpy, dddfx, dddfy, ddfx, ddfy, dfx, dfy;
-	for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
-		cx1 = world[w];
-		cy1 = world[w + 1];
-		cx2 = world[w + 2];
-		cy2 = world[w + 3];
-		x2 = world[w + 4];
-		y2 = world[w + 5];
-		tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
-		tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
-		dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
-		dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
-		ddfx = tmpx * 2 + dddfx;
-		ddfy = tmpy * 2 + dddfy;
-		dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
-		dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		ddfx += dddfx;
-		ddfy += dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx;
-		dfy += ddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		dfx += ddfx + dddfx;
-		dfy += ddfy + dddfy;
-		pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-		_curves[i] = pathLength;
-		x1 = x2;
-		y1 = y2;
+	if (_worldCached)
+		pathLength = curveCount > 0 ? _curves[curveCount - 1] : 0;
+	else {
+		_worldCached = true;
+
+		// World vertices.
+		world.setSize(verticesLength, 0);
+		if (closed) {
+			path.computeWorldVertices(target, 2, verticesLength - 4, world, 0);
+			path.computeWorldVertices(target, 0, 2, world, verticesLength - 4);
+			world[verticesLength - 2] = world[0];
+			world[verticesLength - 1] = world[1];
+		} else
+			path.computeWorldVertices(target, 2, verticesLength, world, 0);
+
+		// Curve lengths.
+		_curves.setSize(curveCount, 0);
+		_segments.setSize(curveCount * 10, 0);
+		pathLength = 0;
+		x1 = world[0];
+		y1 = world[1];
+		for (int i = 0, w = 2; i < curveCount; i++, w += 6) {
+			cx1 = world[w];
+			cy1 = world[w + 1];
+			cx2 = world[w + 2];
+			cy2 = world[w + 3];
+			x2 = world[w + 4];
+			y2 = world[w + 5];
+			tmpx = (x1 - cx1 * 2 + cx2) * 0.1875f;
+			tmpy = (y1 - cy1 * 2 + cy2) * 0.1875f;
+			dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.09375f;
+			dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.09375f;
+			ddfx = tmpx * 2 + dddfx;
+			ddfy = tmpy * 2 + dddfy;
+			dfx = (cx1 - x1) * 0.75f + tmpx + dddfx * 0.16666667f;
+			dfy = (cy1 - y1) * 0.75f + tmpy + dddfy * 0.16666667f;
+			pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+			dfx += ddfx;
+			dfy += ddfy;
+			ddfx += dddfx;
+			ddfy += dddfy;
+			pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+			dfx += ddfx;
+			dfy += ddfy;
+			pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+			dfx += ddfx + dddfx;
+			dfy += ddfy + dddfy;
+			pathLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+			_curves[i] = pathLength;
+			_segments[i * 10] = -1;
+			x1 = x2;
+			y1 = y2;
+		}
 	}
 
 	if (_data._positionMode == PositionMode_Percent) position *= pathLength;
@@ -440,7 +518,7 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			multiplier = 1;
 	}
 
-	float curveLength = 0;
+	float curveLength = 0, *segments = NULL;
 	for (int i = 0, o = 0, curve = 0, segment = 0; i < spacesCount; i++, o += 3) {
 		float space = _spaces[i] * multiplier;
 		position += space;
@@ -471,7 +549,7 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			break;
 		}
 
-		// Curve segment lengths.
+		// Curve segment lengths, computed the first time a bone is positioned on the curve.
 		if (curve != prevCurve) {
 			prevCurve = curve;
 			int ii = curve * 6;
@@ -483,44 +561,48 @@ PathConstraint::computeWorldPositions(PathAttachment &path, int spacesCount, boo
 			cy2 = world[ii + 5];
 			x2 = world[ii + 6];
 			y2 = world[ii + 7];
-			tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
-			tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
-			dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
-			dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
-			ddfx = tmpx * 2 + dddfx;
-			ddfy = tmpy * 2 + dddfy;
-			dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
-			dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
-			curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[0] = curveLength;
-			for (ii = 1; ii < 8; ii++) {
+			segments = _segments.buffer() + curve * 10;
+			if (segments[0] < 0) {
+				tmpx = (x1 - cx1 * 2 + cx2) * 0.03f;
+				tmpy = (y1 - cy1 * 2 + cy2) * 0.03f;
+				dddfx = ((cx1 - cx2) * 3 - x1 + x2) * 0.006f;
+				dddfy = ((cy1 - cy2) * 3 - y1 + y2) * 0.006f;
+				ddfx = tmpx * 2 + dddfx;
+				ddfy = tmpy * 2 + dddfy;
+				dfx = (cx1 - x1) * 0.3f + tmpx + dddfx * 0.16666667f;
+				dfy = (cy1 - y1) * 0.3f + tmpy + dddfy * 0.16666667f;
+				curveLength = MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				segments[0] = curveLength;
+				for (ii = 1; ii < 8; ii++) {
+					dfx += ddfx;
+					dfy += ddfy;
+					ddfx += dddfx;
+					ddfy += dddfy;
+					curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+					segments[ii] = curveLength;
+				}
 				dfx += ddfx;
 				dfy += ddfy;
-				ddfx += dddfx;
-				ddfy += dddfy;
 				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-				_segments[ii] = curveLength;
+				segments[8] = curveLength;
+				dfx += ddfx + dddfx;
+				dfy += ddfy + dddfy;
+				curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
+				segments[9] = curveLength;
 			}
-			dfx += ddfx;
-			dfy += ddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[8] = curveLength;
-			dfx += ddfx + dddfx;
-			dfy += ddfy + dddfy;
-			curveLength += MathUtil::sqrt(dfx * dfx + dfy * dfy);
-			_segments[9] = curveLength;
+			curveLength = segments[9];
 			segment = 0;
 		}
 
 		// Weight by segment length.
 		p *= curveLength;
 		for (;; segment++) {
-			float length = _segments[segment];
+			float length = segments[segment];
 			if (p > length) continue;
 			if (segment == 0)
 				p /= length;
 			else {
-				float prev = _segments[segment - 1];
+				float prev = segments[segment - 1];
 				p = segment + (p - prev) / (length - prev);
 			}
 			break;
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/ProfileStats.h>
+
+#include <spine/Skeleton.h>
+
+using namespace spine;
+
+ProfileStats::Key::Key(int phase, SkeletonData *skeletonData, const String *name) : _phase(phase),
+																					  _skeletonData(skeletonData),
+																					  _name(name) {
+}
+
+bool ProfileStats::Key::operator==(const Key &other) const {
+	return _phase == other._phase && _skeletonData == other._skeletonData && _name == other._name;
+}
+
+size_t ProfileStats::Key::hash() const {
+	return hashKey((long long) (size_t) _name) ^ (hashKey((long long) (size_t) _skeletonData) * 31) ^ _phase;
+}
+
+ProfileStats::ProfileStats() {
+}
+
+ProfileStats::~ProfileStats() {
+}
+
+void ProfileStats::record(ProfilePhase phase, Skeleton *skeleton, const String *name, double nanoseconds,
+						  size_t count) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	Key key(phase, skeleton ? skeleton->getData() : NULL, name);
+	if (!_indices.containsKey(key)) {
+		_indices.put(key, _stats.size());
+		ProfileStat stat;
+		stat.phase = phase;
+		stat.skeletonData = key._skeletonData;
+		if (name) stat.name = *name;
+		stat.nanoseconds = 0;
+		stat.calls = 0;
+		stat.count = 0;
+		_stats.add(stat);
+	}
+	ProfileStat &stat = _stats[_indices[key]];
+	stat.nanoseconds += nanoseconds;
+	stat.calls++;
+	stat.count += count;
+}
+
+Vector<ProfileStat> &ProfileStats::getStats() {
+	return _stats;
+}
+
+double ProfileStats::getNanoseconds(ProfilePhase phase) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	double nanoseconds = 0;
+	for (size_t i = 0; i < _stats.size(); i++)
+		if (_stats[i].phase == phase) nanoseconds += _stats[i].nanoseconds;
+	return nanoseconds;
+}
+
+void ProfileStats::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stats.clear();
+	_indices.clear();
+}
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/Profiler.h>
+
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/IkConstraint.h>
+#include <spine/IkConstraintData.h>
+#include <spine/PathConstraint.h>
+#include <spine/PathConstraintData.h>
+#include <spine/TransformConstraint.h>
+#include <spine/TransformConstraintData.h>
+
+#include <chrono>
+
+using namespace spine;
+
+std::atomic<Profiler *> Profiler::_instance(NULL);
+
+static double nanoTime() {
+	return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						   std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+}
+
+void Profiler::setInstance(Profiler *profiler) {
+	_instance.store(profiler, std::memory_order_release);
+}
+
+Profiler *Profiler::getInstance() {
+	return _instance.load(std::memory_order_acquire);
+}
+
+Profiler::Profiler() {
+}
+
+Profiler::~Profiler() {
+}
+
+ProfileScope::ProfileScope(ProfilePhase phase, Skeleton *skeleton, const String *name, size_t count)
+	: _profiler(Profiler::getInstance()), _phase(phase), _skeleton(skeleton), _name(name), _count(count), _start(0) {
+	if (_profiler) _start = nanoTime();
+}
+
+ProfileScope::ProfileScope(Skeleton *skeleton, Updatable *updatable)
+	: _profiler(Profiler::getInstance()), _phase(ProfilePhase_Bone), _skeleton(skeleton), _name(NULL), _count(1),
+	  _start(0) {
+	if (!_profiler) return;
+	const RTTI &rtti = updatable->getRTTI();
+	if (rtti.isExactly(Bone::rtti)) {
+		_name = &static_cast<Bone *>(updatable)->getData().getName();
+	} else if (rtti.isExactly(IkConstraint::rtti)) {
+		_phase = ProfilePhase_IkConstraint;
+		_name = &static_cast<IkConstraint *>(updatable)->getData().getName();
+	} else if (rtti.isExactly(TransformConstraint::rtti)) {
+		_phase = ProfilePhase_TransformConstraint;
+		_name = &static_cast<TransformConstraint *>(updatable)->getData().getName();
+	} else if (rtti.isExactly(PathConstraint::rtti)) {
+		_phase = ProfilePhase_PathConstraint;
+		_name = &static_cast<PathConstraint *>(updatable)->getData().getName();
+	}
+	_start = nanoTime();
+}
+
+ProfileScope::~ProfileScope() {
+	if (_profiler) _profiler->record(_phase, _skeleton, _name, nanoTime() - _start, _count);
+}
@@ -33,6 +33,7 @@
 
 #include <spine/RootMotionTimeline.h>
 
+#include <spine/AnimationState.h>
 #include <spine/Event.h>
 #include <spine/Skeleton.h>
 
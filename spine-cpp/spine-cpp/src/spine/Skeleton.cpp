@@ -35,8 +35,10 @@
 
 #include <spine/Attachment.h>
 #include <spine/Bone.h>
+#include <spine/ConstraintType.h>
 #include <spine/IkConstraint.h>
 #include <spine/PathConstraint.h>
+#include <spine/Profiler.h>
 #include <spine/SkeletonData.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
@@ -57,26 +59,31 @@
 
 using namespace spine;
 
-Skeleton::Skeleton(SkeletonData *skeletonData) : _data(skeletonData),
+Skeleton::Skeleton(SkeletonData *skeletonData, bool batchUpdate) : _arena(),
+												 _data(skeletonData),
+												 _batchUpdate(batchUpdate),
 												 _skin(NULL),
+												 _keyedAttachmentsSkin(NULL),
+												 _keyedAttachmentsDefaultSkin(NULL),
+												 _keyedAttachmentsChanges(0),
+												 _keyedAttachmentsValid(false),
 												 _color(1, 1, 1, 1),
 												 _time(0),
 												 _scaleX(1),
 												 _scaleY(1),
 												 _x(0),
 												 _y(0) {
-	_bones.ensureCapacity(_data->getBones().size());
-	for (size_t i = 0; i < _data->getBones().size(); ++i) {
+	ArenaScope arenaScope(_data->getArena() ? _arena.create() : Arena::getCurrent());
+
+	size_t boneCount = _data->getBones().size();
+
+	_bones.ensureCapacity(boneCount);
+	for (size_t i = 0; i < boneCount; ++i) {
 		BoneData *data = _data->getBones()[i];
+		Bone *parent = data->getParent() == NULL ? NULL : _bones[data->getParent()->getIndex()];
 
-		Bone *bone;
-		if (data->getParent() == NULL) {
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, NULL);
-		} else {
-			Bone *parent = _bones[data->getParent()->getIndex()];
-			bone = new (__FILE__, __LINE__) Bone(*data, *this, parent);
-			parent->getChildren().add(bone);
-		}
+		Bone *bone = new (__FILE__, __LINE__) Bone(*data, *this, parent);
+		if (parent) parent->getChildren().add(bone);
 
 		_bones.add(bone);
 	}
@@ -123,6 +130,127 @@ Skeleton::Skeleton(SkeletonData *skeletonData) : _data(skeletonData),
 	updateCache();
 }
 
+Skeleton::Skeleton(Skeleton &prototype) : _arena(),
+										  _data(prototype._data),
+										  _batchUpdate(prototype._batchUpdate),
+										  _skin(prototype._skin),
+										  _keyedAttachmentsSkin(prototype._keyedAttachmentsSkin),
+										  _keyedAttachmentsDefaultSkin(prototype._keyedAttachmentsDefaultSkin),
+										  _keyedAttachmentsChanges(prototype._keyedAttachmentsChanges),
+										  _keyedAttachmentsValid(prototype._keyedAttachmentsValid),
+										  _color(prototype._color),
+										  _time(prototype._time),
+										  _scaleX(prototype._scaleX),
+										  _scaleY(prototype._scaleY),
+										  _x(prototype._x),
+										  _y(prototype._y),
+										  _currRootMotionID(prototype._currRootMotionID),
+										  _rootMotionDeltaX(prototype._rootMotionDeltaX),
+										  _rootMotionDeltaY(prototype._rootMotionDeltaY) {
+	ArenaScope arenaScope(_data->getArena() ? _arena.create() : Arena::getCurrent());
+	_keyedAttachments.clearAndAddAll(prototype._keyedAttachments);
+
+	size_t boneCount = prototype._bones.size();
+
+	_bones.ensureCapacity(boneCount);
+	for (size_t i = 0; i < boneCount; ++i) {
+		Bone *source = prototype._bones[i];
+		Bone *parent = source->_parent == NULL ? NULL : _bones[source->_parent->_data.getIndex()];
+
+		Bone *bone = new (__FILE__, __LINE__) Bone(source->_data, *this, parent);
+		bone->_sorted = source->_sorted;
+		bone->_active = source->_active;
+		if (parent) parent->getChildren().add(bone);
+
+		_bones.add(bone);
+	}
+
+	// The bone constructors set the setup pose, so the prototype's pose is copied afterward.
+	float pose[BonePose_Count];
+	for (size_t i = 0; i < boneCount; ++i) {
+		prototype._bones[i]->getPose(pose);
+		_bones[i]->setPose(pose);
+	}
+
+	size_t slotCount = prototype._slots.size();
+	_slots.ensureCapacity(slotCount);
+	for (size_t i = 0; i < slotCount; ++i) {
+		Slot *source = prototype._slots[i];
+		_slots.add(new (__FILE__, __LINE__) Slot(*source, *_bones[source->_bone._data.getIndex()]));
+	}
+
+	_drawOrder.ensureCapacity(slotCount);
+	for (size_t i = 0; i < slotCount; ++i)
+		_drawOrder.add(_slots[prototype._drawOrder[i]->_data.getIndex()]);
+
+	_ikConstraints.ensureCapacity(prototype._ikConstraints.size());
+	for (size_t i = 0; i < prototype._ikConstraints.size(); ++i) {
+		IkConstraint *source = prototype._ikConstraints[i];
+
+		IkConstraint *constraint = new (__FILE__, __LINE__) IkConstraint(source->_data, *this);
+		constraint->_bendDirection = source->_bendDirection;
+		constraint->_compress = source->_compress;
+		constraint->_stretch = source->_stretch;
+		constraint->_mix = source->_mix;
+		constraint->_softness = source->_softness;
+		constraint->_active = source->_active;
+
+		_ikConstraints.add(constraint);
+	}
+
+	_transformConstraints.ensureCapacity(prototype._transformConstraints.size());
+	for (size_t i = 0; i < prototype._transformConstraints.size(); ++i) {
+		TransformConstraint *source = prototype._transformConstraints[i];
+
+		TransformConstraint *constraint = new (__FILE__, __LINE__) TransformConstraint(source->_data, *this);
+		constraint->_mixRotate = source->_mixRotate;
+		constraint->_mixX = source->_mixX;
+		constraint->_mixY = source->_mixY;
+		constraint->_mixScaleX = source->_mixScaleX;
+		constraint->_mixScaleY = source->_mixScaleY;
+		constraint->_mixShearY = source->_mixShearY;
+		constraint->_active = source->_active;
+
+		_transformConstraints.add(constraint);
+	}
+
+	_pathConstraints.ensureCapacity(prototype._pathConstraints.size());
+	for (size_t i = 0; i < prototype._pathConstraints.size(); ++i) {
+		PathConstraint *source = prototype._pathConstraints[i];
+
+		PathConstraint *constraint = new (__FILE__, __LINE__) PathConstraint(source->_data, *this);
+		constraint->_position = source->_position;
+		constraint->_spacing = source->_spacing;
+		constraint->_mixRotate = source->_mixRotate;
+		constraint->_mixX = source->_mixX;
+		constraint->_mixY = source->_mixY;
+		constraint->_active = source->_active;
+
+		_pathConstraints.add(constraint);
+	}
+
+	// Bones map by data index, constraints by their index in the prototype.
+	_updateCache.ensureCapacity(prototype._updateCache.size());
+	for (size_t i = 0, n = prototype._updateCache.size(); i < n; ++i) {
+		Updatable *updatable = prototype._updateCache[i];
+		const RTTI &rtti = updatable->getRTTI();
+		if (rtti.isExactly(Bone::rtti))
+			_updateCache.add(_bones[static_cast<Bone *>(updatable)->_data.getIndex()]);
+		else if (rtti.isExactly(IkConstraint::rtti))
+			_updateCache.add(_ikConstraints[prototype._ikConstraints.indexOf(static_cast<IkConstraint *>(updatable))]);
+		else if (rtti.isExactly(TransformConstraint::rtti))
+			_updateCache.add(_transformConstraints[prototype._transformConstraints.indexOf(
+					static_cast<TransformConstraint *>(updatable))]);
+		else
+			_updateCache.add(_pathConstraints[prototype._pathConstraints.indexOf(static_cast<PathConstraint *>(updatable))]);
+	}
+	_updateCacheRuns.clearAndAddAll(prototype._updateCacheRuns);
+}
+
+Skeleton *Skeleton::copy() {
+	return new (__FILE__, __LINE__) Skeleton(*this);
+}
+
 Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_bones);
 	ContainerUtil::cleanUpVectorOfPointers(_slots);
@@ -131,6 +259,14 @@ Skeleton::~Skeleton() {
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
 }
 
+/// Returns the data of an IK, transform or path constraint.
+static ConstraintData &getConstraintData(Updatable *constraint) {
+	if (constraint->getRTTI().isExactly(IkConstraint::rtti)) return static_cast<IkConstraint *>(constraint)->getData();
+	if (constraint->getRTTI().isExactly(TransformConstraint::rtti))
+		return static_cast<TransformConstraint *>(constraint)->getData();
+	return static_cast<PathConstraint *>(constraint)->getData();
+}
+
 void Skeleton::updateCache() {
 	_updateCache.clear();
 
@@ -152,47 +288,136 @@ void Skeleton::updateCache() {
 		}
 	}
 
+	// The constraints by order. A constraint is not sorted if an earlier IK, transform or path constraint has the same
+	// order, or if its order is not less than the number of constraints.
 	size_t ikCount = _ikConstraints.size();
 	size_t transformCount = _transformConstraints.size();
 	size_t pathCount = _pathConstraints.size();
-
 	size_t constraintCount = ikCount + transformCount + pathCount;
+	_constraintsByOrder.setSize(constraintCount, NULL);
+	for (size_t i = 0; i < constraintCount; i++)
+		_constraintsByOrder[i] = NULL;
+	for (size_t i = 0; i < ikCount; i++) {
+		size_t order = _ikConstraints[i]->_data.getOrder();
+		if (order < constraintCount && !_constraintsByOrder[order]) _constraintsByOrder[order] = _ikConstraints[i];
+	}
+	for (size_t i = 0; i < transformCount; i++) {
+		size_t order = _transformConstraints[i]->_data.getOrder();
+		if (order < constraintCount && !_constraintsByOrder[order])
+			_constraintsByOrder[order] = _transformConstraints[i];
+	}
+	for (size_t i = 0; i < pathCount; i++) {
+		size_t order = _pathConstraints[i]->_data.getOrder();
+		if (order < constraintCount && !_constraintsByOrder[order]) _constraintsByOrder[order] = _pathConstraints[i];
+	}
 
-	size_t i = 0;
-continue_outer:
-	for (; i < constraintCount; ++i) {
-		for (size_t ii = 0; ii < ikCount; ++ii) {
-			IkConstraint *constraint = _ikConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortIkConstraint(constraint);
-				i++;
-				goto continue_outer;
-			}
+	// A constraint is active if its target is and, if it requires a skin, the skin has it.
+	for (size_t i = 0; i < constraintCount; i++)
+		if (_constraintsByOrder[i]) _constraintsByOrder[i]->setActive(false);
+	if (_skin) {
+		Vector<ConstraintData *> &skinConstraints = _skin->_constraints;
+		for (size_t i = 0, n = skinConstraints.size(); i < n; i++) {
+			size_t order = skinConstraints[i]->getOrder();
+			Updatable *constraint = order < constraintCount ? _constraintsByOrder[order] : NULL;
+			if (constraint && &getConstraintData(constraint) == skinConstraints[i]) constraint->setActive(true);
 		}
+	}
+	for (size_t i = 0; i < constraintCount; i++) {
+		Updatable *constraint = _constraintsByOrder[i];
+		if (!constraint) continue;
+		bool targetActive;
+		if (constraint->getRTTI().isExactly(IkConstraint::rtti))
+			targetActive = static_cast<IkConstraint *>(constraint)->_target->_active;
+		else if (constraint->getRTTI().isExactly(TransformConstraint::rtti))
+			targetActive = static_cast<TransformConstraint *>(constraint)->_target->_active;
+		else
+			targetActive = static_cast<PathConstraint *>(constraint)->_target->_bone._active;
+		constraint->setActive(targetActive && (!getConstraintData(constraint).isSkinRequired() || constraint->isActive()));
+	}
 
-		for (size_t ii = 0; ii < transformCount; ++ii) {
-			TransformConstraint *constraint = _transformConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortTransformConstraint(constraint);
-				i++;
-				goto continue_outer;
+	// The order only depends on which bones and constraints are active and on the path attachments of the skin and the
+	// attached path attachments of path constraint targets, the path attachments of the skeleton data's skins are
+	// checked by the skeleton data.
+	bool shared = _data->_shareUpdateOrders;
+	size_t hash = 0;
+	if (shared) {
+		const size_t bits = sizeof(size_t) * 8;
+		size_t boneCount = _bones.size(), keySize = (boneCount + bits - 1) / bits + (constraintCount + bits - 1) / bits;
+		_updateOrderKey.setSize(keySize, 0);
+		size_t *key = _updateOrderKey.buffer();
+		for (size_t i = 0; i < keySize; i++)
+			key[i] = 0;
+		for (size_t i = 0; i < boneCount; i++)
+			if (_bones[i]->_active) key[i / bits] |= (size_t) 1 << (i % bits);
+		key += (boneCount + bits - 1) / bits;
+		for (size_t i = 0; i < constraintCount; i++)
+			if (_constraintsByOrder[i] && _constraintsByOrder[i]->isActive()) key[i / bits] |= (size_t) 1 << (i % bits);
+		for (size_t i = 0; i < pathCount; i++) {
+			PathConstraint *constraint = _pathConstraints[i];
+			if (!constraint->_active) continue;
+			_updateOrderAttachments.clear();
+			if (_skin) _skin->findAttachmentsForSlot(constraint->_target->getData().getIndex(), _updateOrderAttachments);
+			_updateOrderAttachments.add(constraint->_target->getAttachment());
+			for (size_t ii = 0, nn = _updateOrderAttachments.size(); ii < nn; ii++) {
+				Attachment *attachment = _updateOrderAttachments[ii];
+				if (attachment && attachment->getRTTI().instanceOf(PathAttachment::rtti))
+					_updateOrderKey.add((size_t) attachment);
 			}
+			_updateOrderKey.add(i);
 		}
+		for (size_t i = 0, n = _updateOrderKey.size(); i < n; i++)
+			hash = hash * 31 + _updateOrderKey[i];
 
-		for (size_t ii = 0; ii < pathCount; ++ii) {
-			PathConstraint *constraint = _pathConstraints[ii];
-			if (constraint->getData().getOrder() == i) {
-				sortPathConstraint(constraint);
-				i++;
-				goto continue_outer;
+		if (_data->findUpdateOrder(_updateOrderKey, hash, _updateOrder)) {
+			for (size_t i = 0, n = _updateOrder.size(); i < n; i++) {
+				int index = _updateOrder[i];
+				_updateCache.add(index >= 0 ? (Updatable *) _bones[index] : _constraintsByOrder[-1 - index]);
 			}
+			if (_batchUpdate) updateCacheRuns();
+			return;
 		}
 	}
 
-	size_t n = _bones.size();
-	for (i = 0; i < n; ++i) {
+	for (size_t i = 0; i < constraintCount; i++) {
+		Updatable *constraint = _constraintsByOrder[i];
+		if (!constraint || !constraint->isActive()) continue;
+		if (constraint->getRTTI().isExactly(IkConstraint::rtti))
+			sortIkConstraint(static_cast<IkConstraint *>(constraint));
+		else if (constraint->getRTTI().isExactly(TransformConstraint::rtti))
+			sortTransformConstraint(static_cast<TransformConstraint *>(constraint));
+		else
+			sortPathConstraint(static_cast<PathConstraint *>(constraint));
+	}
+
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
 		sortBone(_bones[i]);
 	}
+
+	if (shared) {
+		_updateOrder.setSize(_updateCache.size(), 0);
+		for (size_t i = 0, n = _updateCache.size(); i < n; i++) {
+			Updatable *updatable = _updateCache[i];
+			_updateOrder[i] = updatable->getRTTI().isExactly(Bone::rtti)
+							  ? static_cast<Bone *>(updatable)->_data.getIndex()
+							  : -1 - (int) getConstraintData(updatable).getOrder();
+		}
+		_data->addUpdateOrder(_updateOrderKey, hash, _updateOrder);
+	}
+
+	if (_batchUpdate) updateCacheRuns();
+}
+
+void Skeleton::updateCacheRuns() {
+	size_t n = _updateCache.size();
+	_updateCacheRuns.setSize(n, 0);
+	for (size_t i = n; i-- > 0;) {
+		_updateCacheRuns[i] = 0;
+		Updatable *updatable = _updateCache[i];
+		if (!updatable->getRTTI().isExactly(Bone::rtti)) continue;
+		Bone *bone = static_cast<Bone *>(updatable);
+		if (bone->_parent == NULL || bone->_data.getTransformMode() != TransformMode_Normal) continue;
+		_updateCacheRuns[i] = i + 1 < n ? _updateCacheRuns[i + 1] + 1 : 1;
+	}
 }
 
 void Skeleton::printUpdateCache() {
@@ -211,6 +436,18 @@ void Skeleton::printUpdateCache() {
 }
 
 void Skeleton::updateWorldTransform() {
+	updateWorldTransformSkipping(0);
+}
+
+static inline bool isSkipped(Updatable *updatable, int constraintTypes) {
+	const RTTI &rtti = updatable->getRTTI();
+	if (rtti.isExactly(Bone::rtti)) return false;
+	if (rtti.isExactly(IkConstraint::rtti)) return (constraintTypes & ConstraintType_Ik) != 0;
+	if (rtti.isExactly(TransformConstraint::rtti)) return (constraintTypes & ConstraintType_Transform) != 0;
+	return (constraintTypes & ConstraintType_Path) != 0;
+}
+
+void Skeleton::updateWorldTransformSkipping(int constraintTypes) {
 	for (size_t i = 0, n = _bones.size(); i < n; i++) {
 		Bone *bone = _bones[i];
 		bone->_ax = bone->_x;
@@ -222,8 +459,55 @@ void Skeleton::updateWorldTransform() {
 		bone->_ashearY = bone->_shearY;
 	}
 
+	if (_batchUpdate) {
+		for (size_t i = 0, n = _updateCache.size(); i < n;) {
+			size_t run = _updateCacheRuns[i];
+			if (run > 0) {
+				SP_PROFILE(ProfilePhase_Bone, this, NULL, run);
+				updateWorldTransformRun(i, i + run);
+				i += run;
+			} else {
+				Updatable *updatable = _updateCache[i++];
+				if (constraintTypes != 0 && isSkipped(updatable, constraintTypes)) continue;
+				SP_PROFILE(this, updatable);
+				updatable->update();
+			}
+		}
+		return;
+	}
+
 	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
-		_updateCache[i]->update();
+		Updatable *updatable = _updateCache[i];
+		if (constraintTypes != 0 && isSkipped(updatable, constraintTypes)) continue;
+		SP_PROFILE(this, updatable);
+		updatable->update();
+	}
+}
+
+void Skeleton::updateWorldTransformRun(size_t start, size_t end) {
+	Updatable **updateCache = _updateCache.buffer();
+
+	// Same as Bone::updateWorldTransform for TransformMode_Normal, without the virtual call and transform mode switch.
+	for (size_t i = start; i < end; i++) {
+		Bone &bone = *static_cast<Bone *>(updateCache[i]);
+		Bone &parent = *bone._parent;
+		float x = bone._ax, y = bone._ay, rotation = bone._arotation;
+		float pa = parent._a, pb = parent._b, pc = parent._c, pd = parent._d;
+		bone._worldX = pa * x + pb * y + parent._worldX;
+		bone._worldY = pc * x + pd * y + parent._worldY;
+
+		float rotationY = rotation + 90 + bone._ashearY;
+		float cosX, sinX, cosY, sinY;
+		MathUtil::sincosDeg(rotation + bone._ashearX, sinX, cosX);
+		MathUtil::sincosDeg(rotationY, sinY, cosY);
+		float la = cosX * bone._ascaleX;
+		float lb = cosY * bone._ascaleY;
+		float lc = sinX * bone._ascaleX;
+		float ld = sinY * bone._ascaleY;
+		bone._a = pa * la + pb * lc;
+		bone._b = pa * lb + pb * ld;
+		bone._c = pc * la + pd * lc;
+		bone._d = pc * lb + pd * ld;
 	}
 }
 
@@ -235,10 +519,13 @@ void Skeleton::updateWorldTransform(Bone *parent) {
 	rootBone._worldY = pc * _x + pd * _y + parent->_worldY;
 
 	float rotationY = rootBone._rotation + 90 + rootBone._shearY;
-	float la = MathUtil::cosDeg(rootBone._rotation + rootBone._shearX) * rootBone._scaleX;
-	float lb = MathUtil::cosDeg(rotationY) * rootBone._scaleY;
-	float lc = MathUtil::sinDeg(rootBone._rotation + rootBone._shearX) * rootBone._scaleX;
-	float ld = MathUtil::sinDeg(rotationY) * rootBone._scaleY;
+	float cosX, sinX, cosY, sinY;
+	MathUtil::sincosDeg(rootBone._rotation + rootBone._shearX, sinX, cosX);
+	MathUtil::sincosDeg(rotationY, sinY, cosY);
+	float la = cosX * rootBone._scaleX;
+	float lb = cosY * rootBone._scaleY;
+	float lc = sinX * rootBone._scaleX;
+	float ld = sinY * rootBone._scaleY;
 	rootBone._a = (pa * la + pb * lc) * _scaleX;
 	rootBone._b = (pa * lb + pb * ld) * _scaleX;
 	rootBone._c = (pc * la + pd * lc) * _scaleY;
@@ -247,6 +534,12 @@ void Skeleton::updateWorldTransform(Bone *parent) {
 	// Update everything except root bone.
 	Bone *rb = getRootBone();
 	for (size_t i = 0, n = _updateCache.size(); i < n; i++) {
+		size_t run = _batchUpdate ? _updateCacheRuns[i] : 0;
+		if (run > 0) {
+			updateWorldTransformRun(i, i + run);
+			i += run - 1;
+			continue;
+		}
 		Updatable *updatable = _updateCache[i];
 		if (updatable != rb) updatable->update();
 	}
@@ -311,11 +604,13 @@ void Skeleton::setSlotsToSetupPose() {
 }
 
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	BoneData *data = _data->findBone(boneName);
+	return data ? _bones[data->getIndex()] : NULL;
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	SlotData *data = _data->findSlot(slotName);
+	return data ? _slots[data->getIndex()] : NULL;
 }
 
 void Skeleton::setSkin(const String &skinName) {
@@ -345,6 +640,7 @@ void Skeleton::setSkin(Skin *newSkin) {
 	}
 
 	_skin = newSkin;
+	_keyedAttachmentsValid = false;
 	updateCache();
 }
 
@@ -352,6 +648,34 @@ Attachment *Skeleton::getAttachment(const String &slotName, const String &attach
 	return getAttachment(_data->findSlot(slotName)->getIndex(), attachmentName);
 }
 
+Attachment *Skeleton::getAttachment(int attachmentKey) {
+	Skin *defaultSkin = _data->_defaultSkin;
+	size_t changes = (_skin ? _skin->_changes : 0) + (defaultSkin ? defaultSkin->_changes : 0);
+	if (!_keyedAttachmentsValid || _keyedAttachmentsSkin != _skin || _keyedAttachmentsDefaultSkin != defaultSkin ||
+		_keyedAttachmentsChanges != changes || (size_t) attachmentKey >= _keyedAttachments.size()) {
+		// Skins only gain changes, so the sum differs after any change to either skin. The skins are compared too, since
+		// SkeletonPose::restore() and SkeletonData::setDefaultSkin() replace them without going through setSkin().
+		_keyedAttachmentsValid = true;
+		_keyedAttachmentsSkin = _skin;
+		_keyedAttachmentsDefaultSkin = defaultSkin;
+		_keyedAttachmentsChanges = changes;
+		// Another thread decoding a lazily loaded animation may be adding attachment keys.
+		std::unique_lock<std::mutex> lock(_data->_animationsMutex, std::defer_lock);
+		if (_data->_animationsDecoded.size() > 0) lock.lock();
+		size_t keyCount = _data->_attachmentKeyNames.size();
+		_keyedAttachments.setSize(keyCount, NULL);
+		for (size_t i = 0; i < keyCount; i++)
+			_keyedAttachments[i] = getAttachment((int) _data->_attachmentKeySlots[i], _data->_attachmentKeyNames[i]);
+	}
+	assert((size_t) attachmentKey < _keyedAttachments.size());
+	return _keyedAttachments[attachmentKey];
+}
+
+Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName, int attachmentKey) {
+	if (attachmentName.isEmpty()) return NULL;
+	return attachmentKey != -1 ? getAttachment(attachmentKey) : getAttachment(slotIndex, attachmentName);
+}
+
 Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName) {
 	if (attachmentName.isEmpty()) return NULL;
 
@@ -368,20 +692,18 @@ Attachment *Skeleton::getAttachment(int slotIndex, const String &attachmentName)
 void Skeleton::setAttachment(const String &slotName, const String &attachmentName) {
 	assert(slotName.length() > 0);
 
-	for (size_t i = 0, n = _slots.size(); i < n; ++i) {
-		Slot *slot = _slots[i];
-		if (slot->_data.getName() == slotName) {
-			Attachment *attachment = NULL;
-			if (attachmentName.length() > 0) {
-				attachment = getAttachment(i, attachmentName);
+	SlotData *data = _data->findSlot(slotName);
+	if (data) {
+		Attachment *attachment = NULL;
+		if (attachmentName.length() > 0) {
+			attachment = getAttachment(data->getIndex(), attachmentName);
 
-				assert(attachment != NULL);
-			}
+			assert(attachment != NULL);
+		}
 
-			slot->setAttachment(attachment);
+		_slots[data->getIndex()]->setAttachment(attachment);
 
-			return;
-		}
+		return;
 	}
 
 	printf("Slot not found: %s", slotName.buffer());
@@ -390,11 +712,12 @@ void Skeleton::setAttachment(const String &slotName, const String &attachmentNam
 }
 
 IkConstraint *Skeleton::findIkConstraint(const String &constraintName) {
-	assert(constraintName.length() > 0);
+	IkConstraintData *data = _data->findIkConstraint(constraintName);
+	if (!data) return NULL;
 
 	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i) {
 		IkConstraint *ikConstraint = _ikConstraints[i];
-		if (ikConstraint->_data.getName() == constraintName) {
+		if (&ikConstraint->_data == data) {
 			return ikConstraint;
 		}
 	}
@@ -402,11 +725,12 @@ IkConstraint *Skeleton::findIkConstraint(const String &constraintName) {
 }
 
 TransformConstraint *Skeleton::findTransformConstraint(const String &constraintName) {
-	assert(constraintName.length() > 0);
+	TransformConstraintData *data = _data->findTransformConstraint(constraintName);
+	if (!data) return NULL;
 
 	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i) {
 		TransformConstraint *transformConstraint = _transformConstraints[i];
-		if (transformConstraint->_data.getName() == constraintName) {
+		if (&transformConstraint->_data == data) {
 			return transformConstraint;
 		}
 	}
@@ -415,11 +739,12 @@ TransformConstraint *Skeleton::findTransformConstraint(const String &constraintN
 }
 
 PathConstraint *Skeleton::findPathConstraint(const String &constraintName) {
-	assert(constraintName.length() > 0);
+	PathConstraintData *data = _data->findPathConstraint(constraintName);
+	if (!data) return NULL;
 
 	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i) {
 		PathConstraint *constraint = _pathConstraints[i];
-		if (constraint->_data.getName() == constraintName) {
+		if (&constraint->_data == data) {
 			return constraint;
 		}
 	}
@@ -495,6 +820,10 @@ Vector<Updatable *> &Skeleton::getUpdateCacheList() {
 	return _updateCache;
 }
 
+bool Skeleton::getBatchUpdate() {
+	return _batchUpdate;
+}
+
 Vector<Slot *> &Skeleton::getSlots() {
 	return _slots;
 }
@@ -585,10 +914,6 @@ void Skeleton::clearRootMotionDelta() {
 
 
 void Skeleton::sortIkConstraint(IkConstraint *constraint) {
-	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
-	if (!constraint->_active) return;
-
 	Bone *target = constraint->getTarget();
 	sortBone(target);
 
@@ -611,19 +936,15 @@ void Skeleton::sortIkConstraint(IkConstraint *constraint) {
 }
 
 void Skeleton::sortPathConstraint(PathConstraint *constraint) {
-	constraint->_active = constraint->_target->_bone._active && (!constraint->_data.isSkinRequired() || (_skin &&
-																										 _skin->_constraints.contains(
-																												 &constraint->_data)));
-	if (!constraint->_active) return;
-
 	Slot *slot = constraint->getTarget();
 	int slotIndex = slot->getData().getIndex();
 	Bone &slotBone = slot->getBone();
 	if (_skin != NULL) sortPathConstraintAttachment(_skin, slotIndex, slotBone);
 	if (_data->_defaultSkin != NULL && _data->_defaultSkin != _skin)
 		sortPathConstraintAttachment(_data->_defaultSkin, slotIndex, slotBone);
-	for (size_t ii = 0, nn = _data->_skins.size(); ii < nn; ii++)
-		sortPathConstraintAttachment(_data->_skins[ii], slotIndex, slotBone);
+	_data->findPathAttachments(slotIndex, _updateOrderAttachments);
+	for (size_t ii = 0, nn = _updateOrderAttachments.size(); ii < nn; ii++)
+		sortPathConstraintAttachment(_updateOrderAttachments[ii], slotBone);
 
 	Attachment *attachment = slot->getAttachment();
 	if (attachment != NULL && attachment->getRTTI().instanceOf(PathAttachment::rtti))
@@ -644,10 +965,6 @@ void Skeleton::sortPathConstraint(PathConstraint *constraint) {
 }
 
 void Skeleton::sortTransformConstraint(TransformConstraint *constraint) {
-	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
-	if (!constraint->_active) return;
-
 	sortBone(constraint->getTarget());
 
 	Vector<Bone *> &constrained = constraint->getBones();
@@ -673,15 +990,10 @@ void Skeleton::sortTransformConstraint(TransformConstraint *constraint) {
 }
 
 void Skeleton::sortPathConstraintAttachment(Skin *skin, size_t slotIndex, Bone &slotBone) {
-	Skin::AttachmentMap::Entries attachments = skin->getAttachments();
-
-	while (attachments.hasNext()) {
-		Skin::AttachmentMap::Entry entry = attachments.next();
-		if (entry._slotIndex == slotIndex) {
-			Attachment *value = entry._attachment;
-			sortPathConstraintAttachment(value, slotBone);
-		}
-	}
+	_updateOrderAttachments.clear();
+	skin->findAttachmentsForSlot(slotIndex, _updateOrderAttachments);
+	for (size_t i = 0, n = _updateOrderAttachments.size(); i < n; i++)
+		sortPathConstraintAttachment(_updateOrderAttachments[i], slotBone);
 }
 
 void Skeleton::sortPathConstraintAttachment(Attachment *attachment, Bone &slotBone) {
@@ -74,21 +74,36 @@
 #include <spine/TranslateTimeline.h>
 #include <spine/RootMotionTimeline.h>
 
+#include <atomic>
+#include <thread>
+
 using namespace spine;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _useArena(false), _lazyAnimations(false),
+													_quantizeDeform(false), _threadCount(1), _mappedFile(NULL),
+													_ownsLoader(true) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
+																					  _useArena(false),
+																					  _lazyAnimations(false),
+																					  _quantizeDeform(false),
+																					  _threadCount(1),
+																					  _mappedFile(NULL),
 																					  _ownsLoader(ownsLoader) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale) : _attachmentLoader(NULL), _error(), _scale(scale), _useArena(false),
+											  _lazyAnimations(false), _quantizeDeform(false), _threadCount(1),
+											  _mappedFile(NULL), _ownsLoader(false) {
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -107,6 +122,9 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	_linkedMeshes.clear();
 
 	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	// Everything read from here on is owned by the skeleton data. An arena disposed on error stays valid until the
+	// scope ends.
+	ArenaScope arenaScope(_useArena ? skeletonData->_arena.create(64 * 1024) : Arena::getCurrent());
 
 	char buffer[16] = {0};
 	int lowHash = readInt(input);
@@ -283,6 +301,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	}
 
 	/* Linked meshes. */
+	skeletonData->_skinIndex.update(skeletonData->_skins);
 	for (int i = 0, n = _linkedMeshes.size(); i < n; ++i) {
 		LinkedMesh *linkedMesh = _linkedMeshes[i];
 		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(linkedMesh->_skin);
@@ -328,6 +347,12 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
+	size_t threadCount = _threadCount != 0 ? _threadCount : std::thread::hardware_concurrency();
+	if (threadCount > (size_t) animationsCount) threadCount = animationsCount;
+	// Lazily loaded or concurrently decoded animations are skipped first, remembering where each one starts.
+	bool skipAnimations = _lazyAnimations || threadCount > 1;
+	Vector<size_t> offsets;
+	if (skipAnimations) offsets.setSize(animationsCount, 0);
 	for (int i = 0; i < animationsCount; ++i) {
 		String fullname(readString(input), true);
 		
@@ -343,7 +368,17 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		String name;
 		name.append(&(fullname.buffer()[lastSeparatorIndex + 1]));
 		
-		Animation *animation = readAnimation(name, input, skeletonData);
+		Animation *animation;
+		if (skipAnimations) {
+			offsets[i] = input->cursor - binary;
+			float duration = 0;
+			if (skipAnimation(input, skeletonData, duration)) {
+				Vector<Timeline *> timelines;
+				animation = new (__FILE__, __LINE__) Animation(name, timelines, duration);
+			} else
+				animation = NULL;
+		} else
+			animation = readAnimation(name, input, skeletonData);
 		if (!animation) {
 			delete input;
 			delete skeletonData;
@@ -352,24 +387,57 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		skeletonData->_animations[i] = animation;
 	}
 
+	if (_lazyAnimations && animationsCount > 0) {
+		// Decoded animations can be evicted, so they and the data they are decoded from never live in the arena.
+		ArenaScope heapScope(NULL);
+		skeletonData->_animationReader = new (__FILE__, __LINE__) SkeletonBinary(_scale);
+		skeletonData->_animationReader->_quantizeDeform = _quantizeDeform;
+		skeletonData->_animationsDecoded.setSize(animationsCount, false);
+		skeletonData->_animationOffsets.addAll(offsets);
+		if ((const char *) binary == _mappedFile) {
+			skeletonData->_animationData = binary;
+			skeletonData->_animationDataLength = length;
+			skeletonData->_animationDataMapped = true;
+		} else {
+			// The animations are at the end of the binary, only they are copied.
+			size_t start = skeletonData->_animationOffsets[0];
+			unsigned char *data = SpineExtension::alloc<unsigned char>(length - start, __FILE__, __LINE__);
+			memcpy(data, binary + start, length - start);
+			for (int i = 0; i < animationsCount; ++i)
+				skeletonData->_animationOffsets[i] -= start;
+			skeletonData->_animationData = data;
+			skeletonData->_animationDataLength = (int) (length - start);
+		}
+	} else if (skipAnimations)
+		decodeAnimations(skeletonData, binary, length, offsets, threadCount);
+
+	skeletonData->updateNameIndexes();
 	delete input;
 	return skeletonData;
 }
 
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
-	int length;
+	int length = 0;
 	SkeletonData *skeletonData;
-	const char *binary = SpineExtension::readFile(path.buffer(), &length);
+	// Unless animations are decoded lazily, everything read from the file is decoded into the skeleton data, so the
+	// mapping is released right after reading.
+	const char *binary = SpineExtension::mapFile(path.buffer(), &length);
 	if (length == 0 || !binary) {
+		if (binary) SpineExtension::unmapFile(binary, length);
 		setError("Unable to read skeleton file: ", path.buffer());
 		return NULL;
 	}
+	_mappedFile = binary;
 	skeletonData = readSkeletonData((unsigned char *) binary, length);
-	SpineExtension::free(binary, __FILE__, __LINE__);
+	_mappedFile = NULL;
+	if (!skeletonData || skeletonData->_animationData != (const unsigned char *) binary)
+		SpineExtension::unmapFile(binary, length);
 	return skeletonData;
 }
 
 void SkeletonBinary::setError(const char *value1, const char *value2) {
+	// The error outlives the skeleton data's arena.
+	ArenaScope heapScope(NULL);
 	char message[256];
 	int length;
 	strcpy(message, value1);
@@ -583,6 +651,8 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 				mesh->_height = readFloat(input) * _scale;
 			}
 
+			// Linked meshes are kept by the loader, they must not come from the skeleton data's arena.
+			ArenaScope heapScope(NULL);
 			LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh, String(skinName), slotIndex,
 																		 String(parent), inheritDeform);
 			_linkedMeshes.add(linkedMesh);
@@ -655,10 +725,22 @@ void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment
 		return;
 	}
 
+	// Count the weights first, so the vectors are allocated with their exact size.
+	DataInput counter = *input;
+	int weightCount = 0;
+	for (int i = 0; i < vertexCount; ++i) {
+		int boneCount = readVarint(&counter, true);
+		weightCount += boneCount;
+		for (int ii = 0; ii < boneCount; ++ii) {
+			readVarint(&counter, true);
+			counter.cursor += 12;
+		}
+	}
+
 	Vector<float> &vertices = attachment->getVertices();
 	Vector<size_t> &bones = attachment->getBones();
-	vertices.ensureCapacity(verticesLength * 3 * 3);
-	bones.ensureCapacity(verticesLength * 3);
+	vertices.ensureCapacity(weightCount * 3);
+	bones.ensureCapacity(vertexCount + weightCount);
 
 	for (int i = 0; i < vertexCount; ++i) {
 		int boneCount = readVarint(input, true);
@@ -670,9 +752,11 @@ void SkeletonBinary::readVertices(DataInput *input, VertexAttachment *attachment
 			vertices.add(readFloat(input));
 		}
 	}
+	attachment->updateWeightBlocks();
 }
 
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
+	array.ensureCapacity(n);
 	array.setSize(n, 0);
 
 	int i;
@@ -689,6 +773,7 @@ void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array) {
 	int n = readVarint(input, true);
+	array.ensureCapacity(n);
 	array.setSize(n, 0);
 
 	int i;
@@ -1230,47 +1315,49 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
 
-				bool weighted = attachment->_bones.size() > 0;
-				Vector<float> &vertices = attachment->_vertices;
-				int deformLength = weighted ? vertices.size() / 3 * 2 : vertices.size();
-
 				int frameCount = readVarint(input, true);
 				int frameLast = frameCount - 1;
 				int bezierCount = readVarint(input, true);
 				DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(frameCount, bezierCount, slotIndex,
 																				   attachment);
 
+				// The offsets of all frames are counted first, so they are allocated once.
+				const unsigned char *framesStart = input->cursor;
+				size_t offsetCount = 0;
+				input->cursor += 4;
+				for (int frame = 0;; ++frame) {
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						input->cursor += end * 4;
+						offsetCount += end;
+					}
+					if (frame == frameLast) break;
+					input->cursor += 4;
+					if (readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+				}
+				input->cursor = framesStart;
+				timeline->_offsets.ensureCapacity(offsetCount);
+
+				// Frames keep the offsets as they are stored, the setup vertices are added when they are applied.
 				float time = readFloat(input);
 				for (int frame = 0, bezier = 0;; ++frame) {
-					Vector<float> deform;
 					size_t end = (size_t) readVarint(input, true);
-					if (end == 0) {
-						if (weighted) {
-							deform.setSize(deformLength, 0);
-							for (int iiii = 0; iiii < deformLength; ++iiii)
-								deform[iiii] = 0;
-						} else {
-							deform.clearAndAddAll(vertices);
-						}
-					} else {
-						deform.setSize(deformLength, 0);
+					if (end == 0)
+						timeline->setFrameRange(frame, 0, 0);
+					else {
 						size_t start = (size_t) readVarint(input, true);
-						end += start;
+						float *offsets = timeline->setFrameRange(frame, start, start + end);
 						if (scale == 1) {
-							for (size_t v = start; v < end; ++v)
-								deform[v] = readFloat(input);
+							for (size_t v = 0; v < end; ++v)
+								offsets[v] = readFloat(input);
 						} else {
-							for (size_t v = start; v < end; ++v)
-								deform[v] = readFloat(input) * scale;
-						}
-
-						if (!weighted) {
-							for (size_t v = 0, vn = deform.size(); v < vn; ++v)
-								deform[v] += vertices[v];
+							for (size_t v = 0; v < end; ++v)
+								offsets[v] = readFloat(input) * scale;
 						}
 					}
 
-					timeline->setFrame(frame, time, deform);
+					timeline->getFrames()[frame] = time;
 					if (frame == frameLast) break;
 					float time2 = readFloat(input);
 					switch (readSByte(input)) {
@@ -1282,6 +1369,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 					}
 					time = time2;
 				}
+				if (_quantizeDeform) timeline->quantize();
 
 				timelines.add(timeline);
 			}
@@ -1361,3 +1449,251 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 	}
 	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
 }
+
+void SkeletonBinary::skipCurveFrames(DataInput *input, int frameCount, int frameSize, int extraSize, int bezierCount,
+									 float &duration) {
+	float time = 0;
+	for (int frame = 0; frame < frameCount; frame++) {
+		time = readFloat(input);
+		input->cursor += frameSize - 4;
+		if (frame > 0 && readSByte(input) == CURVE_BEZIER) input->cursor += bezierCount * 16;
+		input->cursor += extraSize;
+	}
+	duration = MathUtil::max(duration, time);
+}
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData, float &duration) {
+	readVarint(input, true);
+
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int slotIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					duration = MathUtil::max(duration, readFloat(input));
+					readVarint(input, true);
+				}
+				continue;
+			}
+			readVarint(input, true);
+			switch (timelineType) {
+				case SLOT_RGBA:
+					skipCurveFrames(input, frameCount, 8, 0, 4, duration);
+					break;
+				case SLOT_RGB:
+					skipCurveFrames(input, frameCount, 7, 0, 3, duration);
+					break;
+				case SLOT_RGBA2:
+					skipCurveFrames(input, frameCount, 11, 0, 7, duration);
+					break;
+				case SLOT_RGB2:
+					skipCurveFrames(input, frameCount, 10, 0, 6, duration);
+					break;
+				case SLOT_ALPHA:
+					skipCurveFrames(input, frameCount, 5, 0, 1, duration);
+					break;
+				default:
+					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+					return false;
+			}
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int boneIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			switch (timelineType) {
+				case BONE_ROTATE:
+				case BONE_TRANSLATEX:
+				case BONE_TRANSLATEY:
+				case BONE_SCALEX:
+				case BONE_SCALEY:
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					skipCurveFrames(input, frameCount, 8, 0, 1, duration);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					skipCurveFrames(input, frameCount, 12, 0, 2, duration);
+					break;
+				default:
+					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+					return false;
+			}
+		}
+	}
+
+	// IK timelines, each frame ends with the bend direction, compress and stretch.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipCurveFrames(input, frameCount, 12, 3, 2, duration);
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipCurveFrames(input, frameCount, 28, 0, 6, duration);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readSByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			switch (type) {
+				case PATH_POSITION:
+				case PATH_SPACING:
+					skipCurveFrames(input, frameCount, 8, 0, 1, duration);
+					break;
+				case PATH_MIX:
+					skipCurveFrames(input, frameCount, 16, 0, 3, duration);
+			}
+		}
+	}
+
+	// Deform timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		Skin *skin = skeletonData->_skins[readVarint(input, true)];
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int slotIndex = readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				const char *attachmentName = readStringRef(input, skeletonData);
+				if (!skin->getAttachment(slotIndex, String(attachmentName))) {
+					setError("Attachment not found: ", attachmentName);
+					return false;
+				}
+				int frameCount = readVarint(input, true);
+				readVarint(input, true);
+				float time = readFloat(input);
+				for (int frame = 0;; ++frame) {
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						input->cursor += end * 4;
+					}
+					if (frame == frameCount - 1) break;
+					time = readFloat(input);
+					if (readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+				}
+				duration = MathUtil::max(duration, time);
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		readFloat(input);
+		if (readBoolean(input)) {
+			int length = readVarint(input, true);
+			if (length > 0) input->cursor += length - 1;
+		}
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
+	}
+	return true;
+}
+
+void SkeletonBinary::decodeAnimation(SkeletonData *skeletonData, Animation *animation, const unsigned char *data,
+									 const unsigned char *end) {
+	// Lazily decoded animations can be evicted and an arena can't be used by several threads, so skipped animations
+	// are never decoded into the skeleton data's arena.
+	ArenaScope heapScope(NULL);
+	DataInput input;
+	input.cursor = data;
+	input.end = end;
+	Animation *decoded = readAnimation(animation->getName(), &input, skeletonData);
+	// The animation was validated when it was skipped while loading.
+	assert(decoded);
+	animation->setTimelines(decoded->_timelines);
+	decoded->_timelines.clear();
+	delete decoded;
+}
+
+namespace {
+	class DecodeThread : public SpineObject {
+	public:
+		std::thread _thread;
+	};
+}
+
+struct SkeletonBinary::DecodeJob {
+	SkeletonData *skeletonData;
+	const unsigned char *binary;
+	const unsigned char *end;
+	Vector<size_t> *offsets;
+	Vector<int> order;
+	std::atomic<size_t> next;
+};
+
+void SkeletonBinary::decodeAnimations(SkeletonData *skeletonData, const unsigned char *binary, int length,
+									  Vector<size_t> &offsets, size_t threadCount) {
+	// The scratch memory for the threads doesn't belong in the skeleton data's arena.
+	ArenaScope heapScope(NULL);
+	DecodeJob job;
+	job.skeletonData = skeletonData;
+	job.binary = binary;
+	job.end = binary + length;
+	job.offsets = &offsets;
+	job.next.store(0, std::memory_order_relaxed);
+
+	// Largest animations first, so the threads run out of work at about the same time.
+	size_t count = offsets.size();
+	Vector<size_t> sizes;
+	sizes.setSize(count, 0);
+	for (size_t i = 0; i < count; i++)
+		sizes[i] = (i + 1 < count ? offsets[i + 1] : (size_t) length) - offsets[i];
+	job.order.setSize(count, 0);
+	for (size_t i = 0; i < count; i++) {
+		size_t ii = i;
+		for (; ii > 0 && sizes[job.order[ii - 1]] < sizes[i]; ii--)
+			job.order[ii] = job.order[ii - 1];
+		job.order[ii] = (int) i;
+	}
+
+	// The loading thread decodes too, so one less thread is started.
+	Vector<DecodeThread *> threads;
+	for (size_t i = 1; i < threadCount; i++) {
+		DecodeThread *thread = new (__FILE__, __LINE__) DecodeThread();
+		thread->_thread = std::thread(&SkeletonBinary::runDecodeJob, this, &job);
+		threads.add(thread);
+	}
+	runDecodeJob(&job);
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i]->_thread.join();
+		delete threads[i];
+	}
+}
+
+void SkeletonBinary::runDecodeJob(DecodeJob *job) {
+	Vector<size_t> &offsets = *job->offsets;
+	for (size_t i; (i = job->next.fetch_add(1, std::memory_order_relaxed)) < offsets.size();) {
+		int index = job->order[i];
+		decodeAnimation(job->skeletonData, job->skeletonData->_animations[index], job->binary + offsets[index],
+						job->end);
+	}
+}
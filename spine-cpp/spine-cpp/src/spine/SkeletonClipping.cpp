@@ -34,39 +34,103 @@
 #include <spine/SkeletonClipping.h>
 
 #include <spine/ClippingAttachment.h>
+#include <spine/Profiler.h>
 #include <spine/Slot.h>
 
 using namespace spine;
 
-SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL) {
+SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL), _clipSkeleton(NULL), _nextClipCache(0) {
 	_clipOutput.ensureCapacity(128);
 	_clippedVertices.ensureCapacity(128);
 	_clippedTriangles.ensureCapacity(128);
 	_clippedUVs.ensureCapacity(128);
 }
 
+SkeletonClipping::~SkeletonClipping() {
+	ContainerUtil::cleanUpVectorOfPointers(_clipCaches);
+}
+
+SkeletonClipping::ClipCache::~ClipCache() {
+	ContainerUtil::cleanUpVectorOfPointers(polygons);
+}
+
 size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 	if (_clipAttachment != NULL) {
 		return 0;
 	}
 
 	_clipAttachment = clip;
+	_clipSkeleton = &slot.getSkeleton();
 
 	int n = clip->getWorldVerticesLength();
 	_clippingPolygon.setSize(n, 0);
 	clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
-	makeClockwise(_clippingPolygon);
-	_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
-
-	for (size_t i = 0; i < _clippingPolygons->size(); ++i) {
-		Vector<float> *polygonP = (*_clippingPolygons)[i];
-		Vector<float> &polygon = *polygonP;
-		makeClockwise(polygon);
-		polygon.add(polygon[0]);
-		polygon.add(polygon[1]);
+	bool reversed = makeClockwise(_clippingPolygon);
+	bool local = clip->getBones().size() == 0 && slot.getDeform().size() == 0;
+	Vector<float> &shape = local ? clip->getVertices() : _clippingPolygon;
+
+	ClipCache *cache = NULL;
+	for (size_t i = 0; i < _clipCaches.size(); ++i) {
+		if (_clipCaches[i]->attachment == clip) {
+			cache = _clipCaches[i];
+			break;
+		}
+	}
+	if (cache == NULL) {
+		if (_clipCaches.size() < ClipCacheSize) {
+			cache = new (__FILE__, __LINE__) ClipCache();
+			_clipCaches.add(cache);
+		} else {
+			cache = _clipCaches[_nextClipCache];
+			_nextClipCache = (_nextClipCache + 1) % ClipCacheSize;
+		}
+		cache->attachment = NULL;
+	}
+
+	Vector<Vector<float> *> &polygons = cache->polygons;
+	if (cache->attachment != clip || cache->local != local || cache->reversed != reversed || !(cache->shape == shape)) {
+		Vector<Vector<float> *> &convexPolygons = _triangulator.decompose(_clippingPolygon,
+																		   _triangulator.triangulate(_clippingPolygon));
+		Vector<Vector<int> *> &convexPolygonsIndices = _triangulator.getConvexPolygonsIndices();
+		size_t polygonsCount = convexPolygons.size();
+		while (polygons.size() > polygonsCount) {
+			delete polygons[polygons.size() - 1];
+			polygons.removeAt(polygons.size() - 1);
+		}
+		while (polygons.size() < polygonsCount)
+			polygons.add(new (__FILE__, __LINE__) Vector<float>());
+
+		cache->indices.clear();
+		for (size_t i = 0; i < polygonsCount; ++i) {
+			Vector<int> &polygonIndices = *convexPolygonsIndices[i];
+			bool polygonReversed = makeClockwise(*convexPolygons[i]);
+			for (size_t ii = 0, nn = polygonIndices.size(); ii < nn; ++ii)
+				cache->indices.add(polygonIndices[polygonReversed ? nn - 1 - ii : ii]);
+			polygons[i]->setSize(convexPolygons[i]->size() + 2, 0);
+		}
+		cache->attachment = clip;
+		cache->shape.clear();
+		cache->shape.addAll(shape);
+		cache->local = local;
+		cache->reversed = reversed;
+	}
+
+	// Each polygon is closed by repeating its first point.
+	float *vertices = _clippingPolygon.buffer();
+	int *indices = cache->indices.buffer();
+	for (size_t i = 0; i < polygons.size(); ++i) {
+		float *polygon = polygons[i]->buffer();
+		size_t count = polygons[i]->size() - 2;
+		for (size_t ii = 0; ii < count; ii += 2, ++indices) {
+			polygon[ii] = vertices[*indices];
+			polygon[ii + 1] = vertices[*indices + 1];
+		}
+		polygon[count] = polygon[0];
+		polygon[count + 1] = polygon[1];
 	}
+	_clippingPolygons = &polygons;
 
-	return (*_clippingPolygons).size();
+	return polygons.size();
 }
 
 void SkeletonClipping::clipEnd(Slot &slot) {
@@ -93,6 +157,7 @@ void SkeletonClipping::clipTriangles(Vector<float> &vertices, Vector<unsigned sh
 
 void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 									 size_t trianglesLength, float *uvs, size_t stride) {
+	SP_PROFILE(ProfilePhase_Clipping, _clipSkeleton, &_clipAttachment->getName(), trianglesLength / 3);
 	Vector<float> &clipOutput = _clipOutput;
 	Vector<float> &clippedVertices = _clippedVertices;
 	Vector<unsigned short> &clippedTriangles = _clippedTriangles;
@@ -300,7 +365,7 @@ bool SkeletonClipping::clip(float x1, float y1, float x2, float y2, float x3, fl
 	return clipped;
 }
 
-void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
+bool SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 	size_t verticeslength = polygon.size();
 
 	float area = polygon[verticeslength - 2] * polygon[1] - polygon[0] * polygon[verticeslength - 1];
@@ -314,7 +379,7 @@ void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 		area += p1x * p2y - p2x * p1y;
 	}
 
-	if (area < 0) return;
+	if (area < 0) return false;
 
 	for (size_t i = 0, lastX = verticeslength - 2, n = verticeslength >> 1; i < n; i += 2) {
 		float x = polygon[i], y = polygon[i + 1];
@@ -324,4 +389,5 @@ void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 		polygon[other] = x;
 		polygon[other + 1] = y;
 	}
+	return true;
 }
@@ -34,10 +34,13 @@
 #include <spine/SkeletonData.h>
 
 #include <spine/Animation.h>
+#include <spine/AttachmentTimeline.h>
 #include <spine/BoneData.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
+#include <spine/PathAttachment.h>
 #include <spine/PathConstraintData.h>
+#include <spine/SkeletonBinary.h>
 #include <spine/Skin.h>
 #include <spine/SlotData.h>
 #include <spine/TransformConstraintData.h>
@@ -55,7 +58,15 @@ SkeletonData::SkeletonData() : _name(),
 							   _version(),
 							   _hash(),
 							   _fps(0),
-							   _imagesPath() {
+							   _imagesPath(),
+							   _shareUpdateOrders(true),
+							   _updateOrdersSkinChanges(0),
+							   _updateOrdersSkinCount(0),
+							   _slotPathAttachmentsValid(false),
+							   _animationReader(NULL),
+							   _animationData(NULL),
+							   _animationDataLength(0),
+							   _animationDataMapped(false) {
 }
 
 SkeletonData::~SkeletonData() {
@@ -70,41 +81,233 @@ SkeletonData::~SkeletonData() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	ContainerUtil::cleanUpVectorOfPointers(_updateOrders);
 	for (size_t i = 0; i < _strings.size(); i++) {
 		SpineExtension::free(_strings[i], __FILE__, __LINE__);
 	}
+	delete _animationReader;
+	if (_animationData) {
+		if (_animationDataMapped)
+			SpineExtension::unmapFile((const char *) _animationData, _animationDataLength);
+		else
+			SpineExtension::free(_animationData, __FILE__, __LINE__);
+	}
+}
+
+void SkeletonData::updateNameIndexes() {
+	rebuildNameIndexes();
+
+	for (size_t i = 0, n = _slots.size(); i < n; i++) {
+		SlotData *slot = _slots[i];
+		slot->_attachmentKey = slot->_attachmentName.isEmpty() ? -1 : addAttachmentKey(i, slot->_attachmentName);
+	}
+	for (size_t i = 0, n = _animations.size(); i < n; i++)
+		addAttachmentKeys(_animations[i]);
+}
+
+void SkeletonData::rebuildNameIndexes() {
+	_boneIndex.rebuild(_bones);
+	_slotIndex.rebuild(_slots);
+	_skinIndex.rebuild(_skins);
+	_eventIndex.rebuild(_events);
+	_animationIndex.rebuild(_animations);
+	_ikConstraintIndex.rebuild(_ikConstraints);
+	_transformConstraintIndex.rebuild(_transformConstraints);
+	_pathConstraintIndex.rebuild(_pathConstraints);
+}
+
+int SkeletonData::findAttachmentKey(size_t slotIndex, const String &attachmentName) {
+	std::unique_lock<std::mutex> lock(_animationsMutex, std::defer_lock);
+	if (_animationsDecoded.size() > 0) lock.lock();
+	return lookUpAttachmentKey(slotIndex, attachmentName);
+}
+
+int SkeletonData::lookUpAttachmentKey(size_t slotIndex, const String &attachmentName) {
+	if (slotIndex >= _slotAttachmentKeys.size()) return -1;
+	Vector<int> &keys = _slotAttachmentKeys[slotIndex];
+	for (size_t i = 0, n = keys.size(); i < n; i++)
+		if (_attachmentKeyNames[keys[i]] == attachmentName) return keys[i];
+	return -1;
+}
+
+size_t SkeletonData::getAttachmentKeyCount() {
+	std::unique_lock<std::mutex> lock(_animationsMutex, std::defer_lock);
+	if (_animationsDecoded.size() > 0) lock.lock();
+	return _attachmentKeyNames.size();
+}
+
+int SkeletonData::addAttachmentKey(size_t slotIndex, const String &attachmentName) {
+	int key = lookUpAttachmentKey(slotIndex, attachmentName);
+	if (key != -1) return key;
+	if (slotIndex >= _slotAttachmentKeys.size()) _slotAttachmentKeys.setSize(slotIndex + 1, Vector<int>());
+	key = (int) _attachmentKeyNames.size();
+	_attachmentKeySlots.add(slotIndex);
+	_attachmentKeyNames.add(attachmentName);
+	_slotAttachmentKeys[slotIndex].add(key);
+	return key;
+}
+
+void SkeletonData::addAttachmentKeys(Animation *animation) {
+	Vector<Timeline *> &timelines = animation->getTimelines();
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		if (!timelines[i]->getRTTI().isExactly(AttachmentTimeline::rtti)) continue;
+		AttachmentTimeline *timeline = static_cast<AttachmentTimeline *>(timelines[i]);
+		Vector<String> &names = timeline->_attachmentNames;
+		for (size_t ii = 0, nn = names.size(); ii < nn; ii++)
+			timeline->_attachmentKeys[ii] = names[ii].isEmpty() ? -1 : addAttachmentKey(timeline->_slotIndex, names[ii]);
+	}
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	return ContainerUtil::findWithName(_bones, _boneIndex, boneName);
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	return ContainerUtil::findWithName(_slots, _slotIndex, slotName);
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	return ContainerUtil::findWithName(_skins, _skinIndex, skinName);
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	return ContainerUtil::findWithName(_events, _eventIndex, eventDataName);
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	assert(animationName.length() > 0);
+	int index = _animationIndex.find(_animations, animationName);
+	if (index == -1) return NULL;
+	if ((size_t) index < _animationsDecoded.size()) {
+		std::lock_guard<std::mutex> lock(_animationsMutex);
+		if (!_animationsDecoded[index]) decodeAnimation(index);
+	}
+	return _animations[index];
+}
+
+void SkeletonData::prefetchAnimation(Animation *animation) {
+	if (_animationsDecoded.size() == 0) return;
+	int index = _animations.indexOf(animation);
+	if (index == -1 || (size_t) index >= _animationsDecoded.size()) return;
+	std::lock_guard<std::mutex> lock(_animationsMutex);
+	if (!_animationsDecoded[index]) decodeAnimation(index);
+}
+
+void SkeletonData::evictAnimation(Animation *animation) {
+	if (_animationsDecoded.size() == 0) return;
+	std::lock_guard<std::mutex> lock(_animationsMutex);
+	int index = _animations.indexOf(animation);
+	if (index == -1 || (size_t) index >= _animationsDecoded.size() || !_animationsDecoded[index]) return;
+	Vector<Timeline *> none;
+	animation->setTimelines(none);
+	_animationsDecoded[index] = false;
+}
+
+bool SkeletonData::isAnimationDecoded(Animation *animation) {
+	if (_animationsDecoded.size() == 0) return true;
+	std::lock_guard<std::mutex> lock(_animationsMutex);
+	int index = _animations.indexOf(animation);
+	return index == -1 || (size_t) index >= _animationsDecoded.size() || _animationsDecoded[index];
+}
+
+void SkeletonData::decodeAnimation(size_t index) {
+	_animationReader->decodeAnimation(this, _animations[index], _animationData + _animationOffsets[index],
+									  _animationData + _animationDataLength);
+	_animationsDecoded[index] = true;
+	addAttachmentKeys(_animations[index]);
+}
+
+void SkeletonData::setShareUpdateOrders(bool inValue) {
+	_shareUpdateOrders = inValue;
+}
+
+bool SkeletonData::getShareUpdateOrders() {
+	return _shareUpdateOrders;
+}
+
+size_t SkeletonData::getUpdateOrderCount() {
+	std::lock_guard<std::mutex> lock(_updateOrdersMutex);
+	validateUpdateOrders();
+	return _updateOrders.size();
+}
+
+bool SkeletonData::findUpdateOrder(Vector<size_t> &key, size_t hash, Vector<int> &order) {
+	std::lock_guard<std::mutex> lock(_updateOrdersMutex);
+	validateUpdateOrders();
+	for (size_t i = 0, n = _updateOrders.size(); i < n; i++) {
+		UpdateOrder *updateOrder = _updateOrders[i];
+		if (updateOrder->hash == hash && updateOrder->key == key) {
+			order.clearAndAddAll(updateOrder->order);
+			return true;
+		}
+	}
+	return false;
+}
+
+void SkeletonData::addUpdateOrder(Vector<size_t> &key, size_t hash, Vector<int> &order) {
+	// The update orders outlive the arena of the skeleton that computed them.
+	ArenaScope arenaScope(NULL);
+	std::lock_guard<std::mutex> lock(_updateOrdersMutex);
+	validateUpdateOrders();
+	for (size_t i = 0, n = _updateOrders.size(); i < n; i++)
+		if (_updateOrders[i]->hash == hash && _updateOrders[i]->key == key) return;
+	UpdateOrder *updateOrder;
+	if (_updateOrders.size() == 64) {
+		updateOrder = _updateOrders[0];
+		_updateOrders.removeAt(0);
+	} else
+		updateOrder = new (__FILE__, __LINE__) UpdateOrder();
+	updateOrder->hash = hash;
+	updateOrder->key.clearAndAddAll(key);
+	updateOrder->order.clearAndAddAll(order);
+	_updateOrders.add(updateOrder);
+}
+
+void SkeletonData::findPathAttachments(size_t slotIndex, Vector<Attachment *> &attachments) {
+	// The index outlives the arena of the skeleton that needed it.
+	ArenaScope arenaScope(NULL);
+	std::lock_guard<std::mutex> lock(_updateOrdersMutex);
+	validateUpdateOrders();
+	if (!_slotPathAttachmentsValid) {
+		_slotPathAttachmentsValid = true;
+		_slotPathAttachments.setSize(_slots.size(), Vector<Attachment *>());
+		for (size_t i = 0, n = _slotPathAttachments.size(); i < n; i++)
+			_slotPathAttachments[i].clear();
+		for (size_t i = 0, n = _skins.size(); i < n; i++) {
+			Skin::AttachmentMap::Entries entries = _skins[i]->getAttachments();
+			while (entries.hasNext()) {
+				Skin::AttachmentMap::Entry &entry = entries.next();
+				if (entry._slotIndex < _slotPathAttachments.size() &&
+					entry._attachment->getRTTI().instanceOf(PathAttachment::rtti))
+					_slotPathAttachments[entry._slotIndex].add(entry._attachment);
+			}
+		}
+	}
+	attachments.clear();
+	if (slotIndex < _slotPathAttachments.size()) attachments.addAll(_slotPathAttachments[slotIndex]);
+}
+
+void SkeletonData::validateUpdateOrders() {
+	size_t changes = 0;
+	for (size_t i = 0, n = _skins.size(); i < n; i++)
+		changes += _skins[i]->_changes;
+	if (changes == _updateOrdersSkinChanges && _skins.size() == _updateOrdersSkinCount) return;
+	_updateOrdersSkinChanges = changes;
+	_updateOrdersSkinCount = _skins.size();
+	ContainerUtil::cleanUpVectorOfPointers(_updateOrders);
+	_slotPathAttachmentsValid = false;
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	return ContainerUtil::findWithName(_ikConstraints, _ikConstraintIndex, constraintName);
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	return ContainerUtil::findWithName(_transformConstraints, _transformConstraintIndex, constraintName);
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	return ContainerUtil::findWithName(_pathConstraints, _pathConstraintIndex, constraintName);
 }
 
 const String &SkeletonData::getName() {
@@ -224,6 +427,10 @@ float SkeletonData::getFps() {
 	return _fps;
 }
 
+Arena *SkeletonData::getArena() {
+	return _arena.get();
+}
+
 void SkeletonData::setFps(float inValue) {
 	_fps = inValue;
 }
@@ -63,6 +63,7 @@
 #include <spine/PathConstraintSpacingTimeline.h>
 #include <spine/PointAttachment.h>
 #include <spine/RegionAttachment.h>
+#include <spine/RootMotionTimeline.h>
 #include <spine/RotateTimeline.h>
 #include <spine/ScaleTimeline.h>
 #include <spine/ShearTimeline.h>
@@ -101,10 +102,12 @@ static void toColor(Color &color, const char *value, bool hasAlpha) {
 }
 
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new (__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-										   _scale(1), _ownsLoader(true) {}
+										   _scale(1), _useArena(false), _quantizeDeform(false), _ownsLoader(true) {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(attachmentLoader),
 																				  _scale(1),
+																				  _useArena(false),
+																				  _quantizeDeform(false),
 																				  _ownsLoader(ownsLoader) {
 	assert(_attachmentLoader != NULL);
 }
@@ -141,12 +144,15 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 
 	root = new (__FILE__, __LINE__) Json(json);
 
-	if (!root) {
-		setError(NULL, "Invalid skeleton JSON: ", Json::getError());
+	if (root->getError()) {
+		setError(root, "Invalid skeleton JSON: ", root->getError());
 		return NULL;
 	}
 
 	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	// Everything read from here on is owned by the skeleton data. An arena disposed on error stays valid until the
+	// scope ends.
+	ArenaScope arenaScope(_useArena ? skeletonData->_arena.create(64 * 1024) : Arena::getCurrent());
 
 	skeleton = Json::getItem(root, "skeleton");
 	if (skeleton) {
@@ -207,6 +213,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		if (color) toColor(data->getColor(), color, true);
 
 		skeletonData->_bones[i] = data;
+		skeletonData->_boneIndex.update(skeletonData->_bones);
 		bonesCount++;
 	}
 
@@ -264,6 +271,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			}
 
 			skeletonData->_slots[i] = data;
+			skeletonData->_slotIndex.update(skeletonData->_slots);
 		}
 	}
 
@@ -309,6 +317,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			data->_uniform = Json::getInt(constraintMap, "uniform", 0) ? true : false;
 
 			skeletonData->_ikConstraints[i] = data;
+			skeletonData->_ikConstraintIndex.update(skeletonData->_ikConstraints);
 		}
 	}
 
@@ -363,6 +372,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			data->_mixShearY = Json::getFloat(constraintMap, "mixShearY", 1);
 
 			skeletonData->_transformConstraints[i] = data;
+			skeletonData->_transformConstraintIndex.update(skeletonData->_transformConstraints);
 		}
 	}
 
@@ -435,6 +445,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			data->_mixY = Json::getFloat(constraintMap, "mixY", data->_mixX);
 
 			skeletonData->_pathConstraints[i] = data;
+			skeletonData->_pathConstraintIndex.update(skeletonData->_pathConstraints);
 		}
 	}
 
@@ -504,6 +515,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 			}
 
 			skeletonData->_skins[skinsIndex++] = skin;
+			skeletonData->_skinIndex.update(skeletonData->_skins);
 			if (strcmp(Json::getString(skinMap, "name", ""), "default") == 0) {
 				skeletonData->_defaultSkin = skin;
 			}
@@ -622,6 +634,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 								_attachmentLoader->configureAttachment(mesh);
 							} else {
 								bool inheritDeform = Json::getInt(attachmentMap, "deform", 1) ? true : false;
+								// Linked meshes are kept by the loader, they must not come from the skeleton data's arena.
+								ArenaScope heapScope(NULL);
 								LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh,
 																							 String(Json::getString(
 																									 attachmentMap,
@@ -749,6 +763,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 				eventData->_balance = Json::getFloat(eventMap, "balance", 0);
 			}
 			skeletonData->_events[i] = eventData;
+			skeletonData->_eventIndex.update(skeletonData->_events);
 		}
 	}
 
@@ -770,6 +785,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		}
 	}
 
+	skeletonData->updateNameIndexes();
 	delete root;
 
 	return skeletonData;
@@ -1272,44 +1288,39 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				}
 				VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
 
-				bool weighted = attachment->_bones.size() != 0;
-				Vector<float> &verts = attachment->_vertices;
-				int deformLength = weighted ? verts.size() / 3 * 2 : verts.size();
-
 				DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(timelineMap->_size,
 																				   timelineMap->_size, slotIndex,
 																				   attachment);
+				// The offsets of all frames are counted first, so they are allocated once.
+				size_t offsetCount = 0;
+				for (Json *frameMap = keyMap; frameMap; frameMap = frameMap->_next) {
+					Json *vertices = Json::getItem(frameMap, "vertices");
+					if (vertices) offsetCount += vertices->_size;
+				}
+				timeline->_offsets.ensureCapacity(offsetCount);
+
+				// Frames keep the offsets as they are stored, the setup vertices are added when they are applied.
 				float time = Json::getFloat(keyMap, "time", 0);
 				for (frame = 0, bezier = 0;; frame++) {
 					Json *vertices = Json::getItem(keyMap, "vertices");
-					Vector<float> deformed;
-					if (!vertices) {
-						if (weighted) {
-							deformed.setSize(deformLength, 0);
-						} else {
-							deformed.clearAndAddAll(attachment->_vertices);
-						}
-					} else {
-						int v, start = Json::getInt(keyMap, "offset", 0);
+					if (!vertices)
+						timeline->setFrameRange(frame, 0, 0);
+					else {
+						size_t start = (size_t) Json::getInt(keyMap, "offset", 0);
+						float *offsets = timeline->setFrameRange(frame, start, start + vertices->_size);
 						Json *vertex;
-						deformed.setSize(deformLength, 0);
+						int v;
 						if (_scale == 1) {
-							for (vertex = vertices->_child, v = start; vertex; vertex = vertex->_next, ++v) {
-								deformed[v] = vertex->_valueFloat;
+							for (vertex = vertices->_child, v = 0; vertex; vertex = vertex->_next, ++v) {
+								offsets[v] = vertex->_valueFloat;
 							}
 						} else {
-							for (vertex = vertices->_child, v = start; vertex; vertex = vertex->_next, ++v) {
-								deformed[v] = vertex->_valueFloat * _scale;
-							}
-						}
-						if (!weighted) {
-							Vector<float> &verticesAttachment = attachment->_vertices;
-							for (v = 0; v < deformLength; ++v) {
-								deformed[v] += verticesAttachment[v];
+							for (vertex = vertices->_child, v = 0; vertex; vertex = vertex->_next, ++v) {
+								offsets[v] = vertex->_valueFloat * _scale;
 							}
 						}
 					}
-					timeline->setFrame(frame, time, deformed);
+					timeline->getFrames()[frame] = time;
 					nextMap = keyMap->_next;
 					if (!nextMap) {
 						// timeline.shrink(); // BOZO
@@ -1323,6 +1334,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 					time = time2;
 					keyMap = nextMap;
 				}
+				if (_quantizeDeform) timeline->quantize();
 				timelines.add(timeline);
 			}
 		}
@@ -1444,9 +1456,12 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 
 	attachment->getVertices().clearAndAddAll(bonesAndWeights._vertices);
 	attachment->getBones().clearAndAddAll(bonesAndWeights._bones);
+	attachment->updateWeightBlocks();
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
+	// The error outlives the skeleton data's arena.
+	ArenaScope heapScope(NULL);
 	_error = String(value1).append(value2);
 	delete root;
 }
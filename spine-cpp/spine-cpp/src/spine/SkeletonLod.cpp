@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonLod.h>
+
+#include <spine/AnimationState.h>
+#include <spine/Bone.h>
+#include <spine/Skeleton.h>
+
+using namespace spine;
+
+/// The world transform values of a bone: a, b, c, d, worldX and worldY.
+static const int WorldValueCount = 6;
+
+LodTier::LodTier() : minMetric(0),
+					 updateInterval(1),
+					 interpolate(false),
+					 skippedConstraints(0),
+					 freezeDeform(false),
+					 minSlotSize(0) {
+}
+
+SkeletonLod::SkeletonLod(Skeleton &skeleton, AnimationState &state) : _skeleton(skeleton),
+																	  _state(state),
+																	  _tierIndex(-1),
+																	  _wait(0),
+																	  _elapsed(0),
+																	  _x(0),
+																	  _y(0),
+																	  _lastPose(0),
+																	  _poseCount(0) {
+}
+
+SkeletonLod::~SkeletonLod() {
+}
+
+void SkeletonLod::addTier(const LodTier &tier) {
+	assert(tier.updateInterval >= 1);
+	assert(_tiers.size() == 0 || _tiers[_tiers.size() - 1].minMetric <= tier.minMetric);
+	_tiers.add(tier);
+}
+
+Vector<LodTier> &SkeletonLod::getTiers() {
+	return _tiers;
+}
+
+bool SkeletonLod::update(float delta, float metric) {
+	int tierIndex = -1;
+	for (size_t i = 0, n = _tiers.size(); i < n && _tiers[i].minMetric <= metric; i++)
+		tierIndex = (int) i;
+	LodTier &tier = tierIndex == -1 ? _fullDetail : _tiers[tierIndex];
+	if (tierIndex != _tierIndex) {
+		_tierIndex = tierIndex;
+		_wait = 0;
+		_poseCount = 0;
+	}
+
+	_elapsed += delta;
+	if (_wait > 0) {
+		_wait--;
+		if (tier.interpolate && _poseCount == 2)
+			interpolate(1 - (float) (_wait + 1) / tier.updateInterval);
+		else
+			translate(_skeleton.getX() - _x, _skeleton.getY() - _y);
+		_x = _skeleton.getX();
+		_y = _skeleton.getY();
+		return false;
+	}
+	_wait = tier.updateInterval - 1;
+
+	_state.update(_elapsed);
+	_elapsed = 0;
+	_state.setFreezeDeform(tier.freezeDeform);
+	_state.apply(_skeleton);
+	_skeleton.updateWorldTransformSkipping(tier.skippedConstraints);
+	_x = _skeleton.getX();
+	_y = _skeleton.getY();
+
+	if (tier.interpolate && tier.updateInterval > 1) {
+		// Show the previous update until the next one, moving toward this one on the frames in between.
+		_lastPose ^= 1;
+		storePose(_poses[_lastPose]);
+		if (_poseCount < 2) _poseCount++;
+		if (_poseCount == 2) interpolate(0);
+	}
+	return true;
+}
+
+void SkeletonLod::storePose(Vector<float> &pose) {
+	Vector<Bone *> &bones = _skeleton.getBones();
+	pose.setSize(bones.size() * WorldValueCount, 0);
+	float *values = pose.buffer();
+	for (size_t i = 0, n = bones.size(); i < n; i++, values += WorldValueCount) {
+		Bone &bone = *bones[i];
+		values[0] = bone.getA();
+		values[1] = bone.getB();
+		values[2] = bone.getC();
+		values[3] = bone.getD();
+		values[4] = bone.getWorldX() - _x;
+		values[5] = bone.getWorldY() - _y;
+	}
+}
+
+void SkeletonLod::interpolate(float alpha) {
+	Vector<Bone *> &bones = _skeleton.getBones();
+	float x = _skeleton.getX(), y = _skeleton.getY();
+	const float *from = _poses[_lastPose ^ 1].buffer(), *to = _poses[_lastPose].buffer();
+	for (size_t i = 0, n = bones.size(); i < n; i++, from += WorldValueCount, to += WorldValueCount) {
+		Bone &bone = *bones[i];
+		bone.setA(from[0] + (to[0] - from[0]) * alpha);
+		bone.setB(from[1] + (to[1] - from[1]) * alpha);
+		bone.setC(from[2] + (to[2] - from[2]) * alpha);
+		bone.setD(from[3] + (to[3] - from[3]) * alpha);
+		bone.setWorldX(from[4] + (to[4] - from[4]) * alpha + x);
+		bone.setWorldY(from[5] + (to[5] - from[5]) * alpha + y);
+	}
+}
+
+void SkeletonLod::translate(float x, float y) {
+	if (x == 0 && y == 0) return;
+	Vector<Bone *> &bones = _skeleton.getBones();
+	for (size_t i = 0, n = bones.size(); i < n; i++) {
+		Bone &bone = *bones[i];
+		bone.setWorldX(bone.getWorldX() + x);
+		bone.setWorldY(bone.getWorldY() + y);
+	}
+}
+
+LodTier &SkeletonLod::getTier() {
+	return _tierIndex == -1 ? _fullDetail : _tiers[_tierIndex];
+}
+
+int SkeletonLod::getTierIndex() {
+	return _tierIndex;
+}
+
+Skeleton &SkeletonLod::getSkeleton() {
+	return _skeleton;
+}
+
+AnimationState &SkeletonLod::getState() {
+	return _state;
+}
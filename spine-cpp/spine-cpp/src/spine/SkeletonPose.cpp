@@ -0,0 +1,210 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonPose.h>
+
+#include <spine/Bone.h>
+#include <spine/IkConstraint.h>
+#include <spine/PathConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraint.h>
+
+#include <string.h>
+
+using namespace spine;
+
+static const int SlotValueCount = 9;
+
+SkeletonPose::SkeletonPose() : _data(NULL),
+							   _skin(NULL),
+							   _color(1, 1, 1, 1),
+							   _x(0),
+							   _y(0),
+							   _scaleX(1),
+							   _scaleY(1),
+							   _time(0) {
+}
+
+SkeletonPose::~SkeletonPose() {
+}
+
+void SkeletonPose::capture(Skeleton &skeleton) {
+	_data = skeleton._data;
+
+	size_t boneCount = skeleton._bones.size();
+	_bones.setSize(boneCount * BonePose_Count, 0);
+	float *bones = _bones.buffer();
+	for (size_t i = 0; i < boneCount; i++, bones += BonePose_Count)
+		skeleton._bones[i]->getPose(bones);
+
+	size_t slotCount = skeleton._slots.size();
+	_slots.setSize(slotCount * SlotValueCount, 0);
+	_attachmentStates.setSize(slotCount, 0);
+	_attachments.setSize(slotCount, NULL);
+	_deformOffsets.setSize(slotCount + 1, 0);
+	_drawOrder.setSize(slotCount, 0);
+	float *slots = _slots.buffer();
+	int deformCount = 0;
+	for (size_t i = 0; i < slotCount; i++, slots += SlotValueCount) {
+		Slot &slot = *skeleton._slots[i];
+		slots[0] = slot._color.r;
+		slots[1] = slot._color.g;
+		slots[2] = slot._color.b;
+		slots[3] = slot._color.a;
+		slots[4] = slot._darkColor.r;
+		slots[5] = slot._darkColor.g;
+		slots[6] = slot._darkColor.b;
+		slots[7] = slot._darkColor.a;
+		slots[8] = slot._attachmentTime;
+		_attachmentStates[i] = slot._attachmentState;
+		_attachments[i] = slot._attachment;
+		_deformOffsets[i] = deformCount;
+		deformCount += (int) slot._deform.size();
+		_drawOrder[i] = skeleton._drawOrder[i]->_data.getIndex();
+	}
+	_deformOffsets[slotCount] = deformCount;
+	_deform.setSize(deformCount, 0);
+	for (size_t i = 0; i < slotCount; i++) {
+		Vector<float> &deform = skeleton._slots[i]->_deform;
+		if (deform.size() > 0) memcpy(_deform.buffer() + _deformOffsets[i], deform.buffer(), sizeof(float) * deform.size());
+	}
+
+	size_t ikCount = skeleton._ikConstraints.size();
+	size_t transformCount = skeleton._transformConstraints.size();
+	size_t pathCount = skeleton._pathConstraints.size();
+	_constraints.setSize(ikCount * 5 + transformCount * 6 + pathCount * 5, 0);
+	float *constraints = _constraints.buffer();
+	for (size_t i = 0; i < ikCount; i++, constraints += 5) {
+		IkConstraint &constraint = *skeleton._ikConstraints[i];
+		constraints[0] = (float) constraint._bendDirection;
+		constraints[1] = constraint._compress ? 1 : 0;
+		constraints[2] = constraint._stretch ? 1 : 0;
+		constraints[3] = constraint._mix;
+		constraints[4] = constraint._softness;
+	}
+	for (size_t i = 0; i < transformCount; i++, constraints += 6) {
+		TransformConstraint &constraint = *skeleton._transformConstraints[i];
+		constraints[0] = constraint._mixRotate;
+		constraints[1] = constraint._mixX;
+		constraints[2] = constraint._mixY;
+		constraints[3] = constraint._mixScaleX;
+		constraints[4] = constraint._mixScaleY;
+		constraints[5] = constraint._mixShearY;
+	}
+	for (size_t i = 0; i < pathCount; i++, constraints += 5) {
+		PathConstraint &constraint = *skeleton._pathConstraints[i];
+		constraints[0] = constraint._position;
+		constraints[1] = constraint._spacing;
+		constraints[2] = constraint._mixRotate;
+		constraints[3] = constraint._mixX;
+		constraints[4] = constraint._mixY;
+	}
+
+	_skin = skeleton._skin;
+	_color.set(skeleton._color);
+	_x = skeleton._x;
+	_y = skeleton._y;
+	_scaleX = skeleton._scaleX;
+	_scaleY = skeleton._scaleY;
+	_time = skeleton._time;
+}
+
+void SkeletonPose::restore(Skeleton &skeleton) {
+	assert(_data == skeleton._data);
+
+	if (skeleton._skin != _skin) {
+		skeleton._skin = _skin;
+		skeleton._keyedAttachmentsValid = false;
+		skeleton.updateCache();
+	}
+
+	float *bones = _bones.buffer();
+	for (size_t i = 0, n = skeleton._bones.size(); i < n; i++, bones += BonePose_Count)
+		skeleton._bones[i]->setPose(bones);
+
+	float *slots = _slots.buffer();
+	for (size_t i = 0, n = skeleton._slots.size(); i < n; i++, slots += SlotValueCount) {
+		Slot &slot = *skeleton._slots[i];
+		slot._color.set(slots[0], slots[1], slots[2], slots[3]);
+		slot._darkColor.set(slots[4], slots[5], slots[6], slots[7]);
+		slot._attachmentTime = slots[8];
+		slot._attachmentState = _attachmentStates[i];
+		slot._attachment = _attachments[i];
+		size_t deformCount = _deformOffsets[i + 1] - _deformOffsets[i];
+		slot._deform.setSize(deformCount, 0);
+		if (deformCount > 0)
+			memcpy(slot._deform.buffer(), _deform.buffer() + _deformOffsets[i], sizeof(float) * deformCount);
+		skeleton._drawOrder[i] = skeleton._slots[_drawOrder[i]];
+	}
+
+	float *constraints = _constraints.buffer();
+	for (size_t i = 0, n = skeleton._ikConstraints.size(); i < n; i++, constraints += 5) {
+		IkConstraint &constraint = *skeleton._ikConstraints[i];
+		constraint._bendDirection = (int) constraints[0];
+		constraint._compress = constraints[1] != 0;
+		constraint._stretch = constraints[2] != 0;
+		constraint._mix = constraints[3];
+		constraint._softness = constraints[4];
+	}
+	for (size_t i = 0, n = skeleton._transformConstraints.size(); i < n; i++, constraints += 6) {
+		TransformConstraint &constraint = *skeleton._transformConstraints[i];
+		constraint._mixRotate = constraints[0];
+		constraint._mixX = constraints[1];
+		constraint._mixY = constraints[2];
+		constraint._mixScaleX = constraints[3];
+		constraint._mixScaleY = constraints[4];
+		constraint._mixShearY = constraints[5];
+	}
+	for (size_t i = 0, n = skeleton._pathConstraints.size(); i < n; i++, constraints += 5) {
+		PathConstraint &constraint = *skeleton._pathConstraints[i];
+		constraint._position = constraints[0];
+		constraint._spacing = constraints[1];
+		constraint._mixRotate = constraints[2];
+		constraint._mixX = constraints[3];
+		constraint._mixY = constraints[4];
+	}
+
+	skeleton._color.set(_color);
+	skeleton._x = _x;
+	skeleton._y = _y;
+	skeleton._scaleX = _scaleX;
+	skeleton._scaleY = _scaleY;
+	skeleton._time = _time;
+}
+
+SkeletonData *SkeletonPose::getData() {
+	return _data;
+}
@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonRenderer.h>
+
+#include <spine/Atlas.h>
+#include <spine/Bone.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/Color.h>
+#include <spine/MathUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skeleton.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/VertexEffect.h>
+
+using namespace spine;
+
+/// Indices are 16 bit, so a command can't have more vertices.
+static const size_t MaxCommandVertices = 65536;
+
+/// Channels are clamped, as the skeleton and attachment colors aren't and a channel above 1 would carry into the next.
+static inline unsigned int packColor(float r, float g, float b, float a) {
+	return ((unsigned int) (MathUtil::clamp(a, 0, 1) * 255) << 24) | ((unsigned int) (MathUtil::clamp(r, 0, 1) * 255) << 16) |
+		   ((unsigned int) (MathUtil::clamp(g, 0, 1) * 255) << 8) | (unsigned int) (MathUtil::clamp(b, 0, 1) * 255);
+}
+
+static inline void *getTexture(void *rendererObject) {
+	AtlasRegion *region = (AtlasRegion *) rendererObject;
+	return region ? region->page->getRendererObject() : NULL;
+}
+
+/// Returns true if a size in the bone's coordinates is smaller than the minimum size in world coordinates.
+static inline bool isSmaller(float size, Bone &bone, float minSize) {
+	float scaleX = bone.getA() * bone.getA() + bone.getC() * bone.getC();
+	float scaleY = bone.getB() * bone.getB() + bone.getD() * bone.getD();
+	return size * size * MathUtil::max(scaleX, scaleY) < minSize * minSize;
+}
+
+/// Returns true if the bounds of the world vertices are smaller than the minimum size on both axes.
+static inline bool isSmaller(const float *vertices, size_t count, float minSize) {
+	float minX = vertices[0], minY = vertices[1], maxX = minX, maxY = minY;
+	for (size_t i = 2; i < count; i += 2) {
+		minX = MathUtil::min(minX, vertices[i]);
+		maxX = MathUtil::max(maxX, vertices[i]);
+		minY = MathUtil::min(minY, vertices[i + 1]);
+		maxY = MathUtil::max(maxY, vertices[i + 1]);
+	}
+	return maxX - minX < minSize && maxY - minY < minSize;
+}
+
+SkeletonRenderer::SkeletonRenderer() : _minSlotSize(0) {
+	_quadIndices.add(0);
+	_quadIndices.add(1);
+	_quadIndices.add(2);
+	_quadIndices.add(2);
+	_quadIndices.add(3);
+	_quadIndices.add(0);
+}
+
+SkeletonRenderer::~SkeletonRenderer() {
+}
+
+RenderCommand &SkeletonRenderer::getCommand(void *texture, BlendMode blendMode, size_t vertexCount) {
+	if (_commands.size() > 0) {
+		RenderCommand &last = _commands[_commands.size() - 1];
+		if (last.texture == texture && last.blendMode == blendMode && last.vertexCount + vertexCount <= MaxCommandVertices)
+			return last;
+	}
+	RenderCommand command;
+	command.texture = texture;
+	command.blendMode = blendMode;
+	command.vertexStart = _vertices.size();
+	command.vertexCount = 0;
+	command.indexStart = _indices.size();
+	command.indexCount = 0;
+	_commands.add(command);
+	return _commands[_commands.size() - 1];
+}
+
+void SkeletonRenderer::render(Skeleton &skeleton, VertexEffect *vertexEffect) {
+	_commands.clear();
+	_vertices.clear();
+	_indices.clear();
+
+	Color &skeletonColor = skeleton.getColor();
+	if (skeletonColor.a == 0) return;
+
+	if (vertexEffect) vertexEffect->begin(skeleton);
+
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	for (size_t i = 0, n = drawOrder.size(); i < n; ++i) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) {
+			_clipper.clipEnd(slot);
+			continue;
+		}
+
+		size_t vertexCount, indexCount;
+		float *uvs;
+		unsigned short *indices;
+		Color *attachmentColor;
+		void *texture;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			attachmentColor = &region->getColor();
+			if (attachmentColor->a == 0 ||
+				(_minSlotSize > 0 &&
+				 isSmaller(MathUtil::max(MathUtil::abs(region->getWidth() * region->getScaleX()),
+										 MathUtil::abs(region->getHeight() * region->getScaleY())),
+						   slot.getBone(), _minSlotSize))) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+			_worldVertices.setSize(8, 0);
+			region->computeWorldVertices(slot.getBone(), _worldVertices, 0, 2);
+			vertexCount = 4;
+			uvs = region->getUVs().buffer();
+			indices = _quadIndices.buffer();
+			indexCount = 6;
+			texture = getTexture(region->getRendererObject());
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			attachmentColor = &mesh->getColor();
+			bool measured = mesh->getWidth() > 0 && mesh->getHeight() > 0;
+			if (attachmentColor->a == 0 ||
+				(_minSlotSize > 0 && measured &&
+				 isSmaller(MathUtil::max(mesh->getWidth(), mesh->getHeight()), slot.getBone(), _minSlotSize))) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+			_worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), _worldVertices, 0, 2);
+			if (_minSlotSize > 0 && !measured &&
+				isSmaller(_worldVertices.buffer(), mesh->getWorldVerticesLength(), _minSlotSize)) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+			vertexCount = mesh->getWorldVerticesLength() >> 1;
+			uvs = mesh->getUVs().buffer();
+			indices = mesh->getTriangles().buffer();
+			indexCount = mesh->getTriangles().size();
+			texture = getTexture(mesh->getRendererObject());
+		} else {
+			if (attachment->getRTTI().isExactly(ClippingAttachment::rtti))
+				_clipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+			else
+				_clipper.clipEnd(slot);
+			continue;
+		}
+
+		float *positions = _worldVertices.buffer();
+		if (_clipper.isClipping()) {
+			_clipper.clipTriangles(positions, indices, indexCount, uvs, 2);
+			positions = _clipper.getClippedVertices().buffer();
+			vertexCount = _clipper.getClippedVertices().size() >> 1;
+			uvs = _clipper.getClippedUVs().buffer();
+			indices = _clipper.getClippedTriangles().buffer();
+			indexCount = _clipper.getClippedTriangles().size();
+			if (indexCount == 0) {
+				_clipper.clipEnd(slot);
+				continue;
+			}
+		}
+
+		Color &slotColor = slot.getColor();
+		float r = skeletonColor.r * slotColor.r * attachmentColor->r;
+		float g = skeletonColor.g * slotColor.g * attachmentColor->g;
+		float b = skeletonColor.b * slotColor.b * attachmentColor->b;
+		float a = skeletonColor.a * slotColor.a * attachmentColor->a;
+		Color dark(0, 0, 0, 0);
+		if (slot.hasDarkColor()) {
+			Color &slotDark = slot.getDarkColor();
+			dark.set(slotDark.r, slotDark.g, slotDark.b, 1);
+		}
+
+		RenderCommand &command = getCommand(texture, slot.getData().getBlendMode(), vertexCount);
+		size_t vertexStart = _vertices.size();
+		_vertices.setSize(vertexStart + vertexCount, RenderVertex());
+		RenderVertex *vertices = _vertices.buffer() + vertexStart;
+		if (!vertexEffect) {
+			unsigned int color = packColor(r, g, b, a), darkColor = packColor(dark.r, dark.g, dark.b, dark.a);
+			for (size_t ii = 0; ii < vertexCount; ii++) {
+				RenderVertex &vertex = vertices[ii];
+				vertex.x = positions[ii << 1];
+				vertex.y = positions[(ii << 1) + 1];
+				vertex.u = uvs[ii << 1];
+				vertex.v = uvs[(ii << 1) + 1];
+				vertex.color = color;
+				vertex.darkColor = darkColor;
+			}
+		} else {
+			for (size_t ii = 0; ii < vertexCount; ii++) {
+				RenderVertex &vertex = vertices[ii];
+				vertex.x = positions[ii << 1];
+				vertex.y = positions[(ii << 1) + 1];
+				vertex.u = uvs[ii << 1];
+				vertex.v = uvs[(ii << 1) + 1];
+				Color light(r, g, b, a), vertexDark(dark);
+				vertexEffect->transform(vertex.x, vertex.y, vertex.u, vertex.v, light, vertexDark);
+				vertex.color = packColor(light.r, light.g, light.b, light.a);
+				vertex.darkColor = packColor(vertexDark.r, vertexDark.g, vertexDark.b, vertexDark.a);
+			}
+		}
+
+		size_t indexStart = _indices.size();
+		_indices.setSize(indexStart + indexCount, 0);
+		unsigned short *commandIndices = _indices.buffer() + indexStart;
+		unsigned short indexOffset = (unsigned short) command.vertexCount;
+		for (size_t ii = 0; ii < indexCount; ii++)
+			commandIndices[ii] = (unsigned short) (indices[ii] + indexOffset);
+		command.vertexCount += vertexCount;
+		command.indexCount += indexCount;
+
+		_clipper.clipEnd(slot);
+	}
+	_clipper.clipEnd();
+
+	if (vertexEffect) vertexEffect->end();
+}
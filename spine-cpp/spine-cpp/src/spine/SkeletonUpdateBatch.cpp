@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated January 1, 2020. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2020, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_UE4
+#include "SpinePluginPrivatePCH.h"
+#endif
+
+#include <spine/SkeletonUpdateBatch.h>
+
+#include <spine/AnimationState.h>
+#include <spine/Skeleton.h>
+
+#include <stdint.h>
+
+using namespace spine;
+
+SkeletonUpdateBatch::SkeletonUpdateBatch(size_t threadCount) : _ranges(NULL), _rangeMemory(NULL),
+															   _threadCount(threadCount), _delta(0), _generation(0),
+															   _running(0), _stopping(false) {
+	if (_threadCount == 0) _threadCount = std::thread::hardware_concurrency();
+	if (_threadCount == 0) _threadCount = 1;
+
+	// The extension's allocations are not aligned to a cache line, so one more range is allocated to align them.
+	_rangeMemory = SpineExtension::alloc<char>(sizeof(Range) * (_threadCount + 1), __FILE__, __LINE__);
+	_ranges = (Range *) (((uintptr_t) _rangeMemory + 63) & ~(uintptr_t) 63);
+	for (size_t i = 0; i < _threadCount; i++) {
+		new (_ranges + i) Range();
+		_ranges[i].next.store(0);
+		_ranges[i].end = 0;
+	}
+
+	// The thread calling update() updates the first range, so one less worker thread is needed.
+	for (size_t i = 1; i < _threadCount; i++) {
+		Worker *worker = new (__FILE__, __LINE__) Worker();
+		worker->_thread = std::thread(&SkeletonUpdateBatch::runWorker, this, i);
+		_workers.add(worker);
+	}
+}
+
+SkeletonUpdateBatch::~SkeletonUpdateBatch() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopping = true;
+	}
+	_startCondition.notify_all();
+	for (size_t i = 0; i < _workers.size(); i++) {
+		_workers[i]->_thread.join();
+		delete _workers[i];
+	}
+	for (size_t i = 0; i < _threadCount; i++)
+		_ranges[i].~Range();
+	SpineExtension::free(_rangeMemory, __FILE__, __LINE__);
+}
+
+void SkeletonUpdateBatch::add(Skeleton &skeleton, AnimationState &state) {
+	_skeletons.add(&skeleton);
+	_states.add(&state);
+}
+
+void SkeletonUpdateBatch::clear() {
+	_skeletons.clear();
+	_states.clear();
+}
+
+size_t SkeletonUpdateBatch::size() {
+	return _skeletons.size();
+}
+
+size_t SkeletonUpdateBatch::getThreadCount() {
+	return _threadCount;
+}
+
+void SkeletonUpdateBatch::update(float delta) {
+	size_t count = _skeletons.size();
+	for (size_t i = 0; i < _threadCount; i++) {
+		_ranges[i].next.store(count * i / _threadCount, std::memory_order_relaxed);
+		_ranges[i].end = count * (i + 1) / _threadCount;
+	}
+	_delta = delta;
+
+	if (_workers.size() == 0) {
+		updateRanges(0);
+		return;
+	}
+
+	// Locking the mutex publishes the ranges to the workers.
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_generation++;
+		_running = _workers.size();
+	}
+	_startCondition.notify_all();
+
+	updateRanges(0);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (_running > 0)
+		_doneCondition.wait(lock);
+}
+
+void SkeletonUpdateBatch::runWorker(size_t index) {
+	size_t generation = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (!_stopping && _generation == generation)
+				_startCondition.wait(lock);
+			if (_stopping) return;
+			generation = _generation;
+		}
+
+		updateRanges(index);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_running == 0) _doneCondition.notify_one();
+	}
+}
+
+void SkeletonUpdateBatch::updateRanges(size_t index) {
+	// Start with the thread's own range, then take pairs from the ranges of the following threads.
+	for (size_t i = 0; i < _threadCount; i++) {
+		Range &range = _ranges[(index + i) % _threadCount];
+		while (true) {
+			size_t pair = range.next.fetch_add(1, std::memory_order_relaxed);
+			if (pair >= range.end) break;
+			AnimationState &state = *_states[pair];
+			Skeleton &skeleton = *_skeletons[pair];
+			state.update(_delta);
+			state.apply(skeleton);
+			skeleton.updateWorldTransform();
+		}
+	}
+}
@@ -92,7 +92,7 @@ Skin::AttachmentMap::Entries Skin::AttachmentMap::getEntries() {
 	return Skin::AttachmentMap::Entries(_buckets);
 }
 
-Skin::Skin(const String &name) : _name(name), _attachments() {
+Skin::Skin(const String &name) : _name(name), _attachments(), _changes(0) {
 	assert(_name.length() > 0);
 }
 
@@ -107,6 +107,7 @@ Skin::~Skin() {
 void Skin::setAttachment(size_t slotIndex, const String &name, Attachment *attachment) {
 	assert(attachment);
 	_attachments.put(slotIndex, name, attachment);
+	_changes++;
 }
 
 Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
@@ -115,6 +116,7 @@ Attachment *Skin::getAttachment(size_t slotIndex, const String &name) {
 
 void Skin::removeAttachment(size_t slotIndex, const String &name) {
 	_attachments.remove(slotIndex, name);
+	_changes++;
 }
 
 void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
@@ -128,11 +130,10 @@ void Skin::findNamesForSlot(size_t slotIndex, Vector<String> &names) {
 }
 
 void Skin::findAttachmentsForSlot(size_t slotIndex, Vector<Attachment *> &attachments) {
-	Skin::AttachmentMap::Entries entries = _attachments.getEntries();
-	while (entries.hasNext()) {
-		Skin::AttachmentMap::Entry &entry = entries.next();
-		if (entry._slotIndex == slotIndex) attachments.add(entry._attachment);
-	}
+	if (slotIndex >= _attachments._buckets.size()) return;
+	Vector<AttachmentMap::Entry> &bucket = _attachments._buckets[slotIndex];
+	for (size_t i = 0, n = bucket.size(); i < n; i++)
+		attachments.add(bucket[i]._attachment);
 }
 
 const String &Skin::getName() {
@@ -53,6 +53,18 @@ Slot::Slot(SlotData &data, Bone &bone) : _data(data),
 	setToSetupPose();
 }
 
+Slot::Slot(Slot &prototype, Bone &bone) : _data(prototype._data),
+										  _bone(bone),
+										  _skeleton(bone.getSkeleton()),
+										  _color(prototype._color),
+										  _darkColor(prototype._darkColor),
+										  _hasDarkColor(prototype._hasDarkColor),
+										  _attachment(prototype._attachment),
+										  _attachmentState(prototype._attachmentState),
+										  _attachmentTime(prototype._attachmentTime) {
+	_deform.clearAndAddAll(prototype._deform);
+}
+
 void Slot::setToSetupPose() {
 	_color.set(_data.getColor());
 	if (_hasDarkColor) _darkColor.set(_data.getDarkColor());
@@ -60,7 +72,7 @@ void Slot::setToSetupPose() {
 	const String &attachmentName = _data.getAttachmentName();
 	if (attachmentName.length() > 0) {
 		_attachment = NULL;
-		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName));
+		setAttachment(_skeleton.getAttachment(_data.getIndex(), attachmentName, _data.getAttachmentKey()));
 	} else {
 		setAttachment(NULL);
 	}
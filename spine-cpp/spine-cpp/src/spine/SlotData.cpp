@@ -44,6 +44,7 @@ SlotData::SlotData(int index, const String &name, BoneData &boneData) : _index(i
 																		_darkColor(0, 0, 0, 0),
 																		_hasDarkColor(false),
 																		_attachmentName(),
+																		_attachmentKey(-1),
 																		_blendMode(BlendMode_Normal) {
 	assert(_index >= 0);
 	assert(_name.length() > 0);
@@ -83,6 +84,11 @@ const String &SlotData::getAttachmentName() {
 
 void SlotData::setAttachmentName(const String &inValue) {
 	_attachmentName = inValue;
+	_attachmentKey = -1;
+}
+
+int SlotData::getAttachmentKey() {
+	return _attachmentKey;
 }
 
 BlendMode SlotData::getBlendMode() {
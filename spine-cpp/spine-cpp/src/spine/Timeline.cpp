@@ -41,6 +41,7 @@ namespace spine {
 
 	Timeline::Timeline(size_t frameCount, size_t frameEntries)
 		: _propertyIds(), _frames(), _frameEntries(frameEntries) {
+		_frames.ensureCapacity(frameCount * frameEntries);
 		_frames.setSize(frameCount * frameEntries, 0);
 	}
 
@@ -45,8 +45,7 @@ RTTI_IMPL(TransformConstraint, Updatable)
 
 TransformConstraint::TransformConstraint(TransformConstraintData &data, Skeleton &skeleton) : Updatable(),
 																							  _data(data),
-																							  _target(skeleton.findBone(
-																									  data.getTarget()->getName())),
+																							  _target(skeleton.getBones()[data.getTarget()->getIndex()]),
 																							  _mixRotate(
 																									  data.getMixRotate()),
 																							  _mixX(data.getMixX()),
@@ -61,7 +60,7 @@ TransformConstraint::TransformConstraint(TransformConstraintData &data, Skeleton
 	_bones.ensureCapacity(_data.getBones().size());
 	for (size_t i = 0; i < _data.getBones().size(); ++i) {
 		BoneData *boneData = _data.getBones()[i];
-		_bones.add(skeleton.findBone(boneData->getName()));
+		_bones.add(skeleton.getBones()[boneData->getIndex()]);
 	}
 }
 
@@ -170,7 +169,8 @@ void TransformConstraint::applyAbsoluteWorld() {
 				r += MathUtil::Pi_2;
 
 			r *= mixRotate;
-			float cos = MathUtil::cos(r), sin = MathUtil::sin(r);
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -209,8 +209,10 @@ void TransformConstraint::applyAbsoluteWorld() {
 
 			r = by + (r + offsetShearY) * mixShearY;
 			float s = MathUtil::sqrt(b * b + d * d);
-			bone._b = MathUtil::cos(r) * s;
-			bone._d = MathUtil::sin(r) * s;
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
+			bone._b = cos * s;
+			bone._d = sin * s;
 		}
 
 		bone.updateAppliedTransform();
@@ -237,7 +239,8 @@ void TransformConstraint::applyRelativeWorld() {
 				r += MathUtil::Pi_2;
 
 			r *= mixRotate;
-			float cos = MathUtil::cos(r), sin = MathUtil::sin(r);
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
 			bone._a = cos * a - sin * c;
 			bone._b = cos * b - sin * d;
 			bone._c = sin * a + cos * c;
@@ -272,8 +275,10 @@ void TransformConstraint::applyRelativeWorld() {
 			float b = bone._b, d = bone._d;
 			r = MathUtil::atan2(d, b) + (r - MathUtil::Pi / 2 + offsetShearY) * mixShearY;
 			float s = MathUtil::sqrt(b * b + d * d);
-			bone._b = MathUtil::cos(r) * s;
-			bone._d = MathUtil::sin(r) * s;
+			float sin, cos;
+			MathUtil::sincos(r, sin, cos);
+			bone._b = cos * s;
+			bone._d = sin * s;
 		}
 
 		bone.updateAppliedTransform();
@@ -43,86 +43,73 @@ Triangulator::~Triangulator() {
 }
 
 Vector<int> &Triangulator::triangulate(Vector<float> &vertices) {
-	size_t vertexCount = vertices.size() >> 1;
-
-	Vector<int> &indices = _indices;
-	indices.clear();
-	indices.ensureCapacity(vertexCount);
-	indices.setSize(vertexCount, 0);
-	for (size_t i = 0; i < vertexCount; ++i) {
-		indices[i] = i;
+	int vertexCount = (int) (vertices.size() >> 1);
+
+	Vector<int> &previous = _previous, &next = _next;
+	previous.setSize(vertexCount, 0);
+	next.setSize(vertexCount, 0);
+	for (int i = 0; i < vertexCount; ++i) {
+		previous[i] = i == 0 ? vertexCount - 1 : i - 1;
+		next[i] = i == vertexCount - 1 ? 0 : i + 1;
 	}
 
 	Vector<bool> &isConcaveArray = _isConcaveArray;
-	isConcaveArray.ensureCapacity(vertexCount);
-	isConcaveArray.setSize(vertexCount, 0);
-	for (size_t i = 0, n = vertexCount; i < n; ++i) {
-		isConcaveArray[i] = isConcave(i, vertexCount, vertices, indices);
+	isConcaveArray.setSize(vertexCount, false);
+	_concaveIndex.setSize(vertexCount, -1);
+	_concave.clear();
+	for (int i = 0; i < vertexCount; ++i) {
+		isConcaveArray[i] = false;
+		setConcave(i, isConcave(previous[i], i, next[i], vertices));
 	}
 
 	Vector<int> &triangles = _triangles;
 	triangles.clear();
 	triangles.ensureCapacity(MathUtil::max((int) 0, (int) vertexCount - 2) << 2);
 
+	// Ears are searched from the first remaining vertex, the vertices before start are known not to be ears.
+	int first = 0, start = 0;
 	while (vertexCount > 3) {
 		// Find ear tip.
-		size_t previous = vertexCount - 1, i = 0, next = 1;
-
-		// outer:
+		int i = start;
+		bool restart = false;
 		while (true) {
-			if (!isConcaveArray[i]) {
-				int p1 = indices[previous] << 1, p2 = indices[i] << 1, p3 = indices[next] << 1;
-				float p1x = vertices[p1], p1y = vertices[p1 + 1];
-				float p2x = vertices[p2], p2y = vertices[p2 + 1];
-				float p3x = vertices[p3], p3y = vertices[p3 + 1];
-				for (size_t ii = (next + 1) % vertexCount; ii != previous; ii = (ii + 1) % vertexCount) {
-					if (!isConcaveArray[ii]) continue;
-
-					int v = indices[ii] << 1;
-					float &vx = vertices[v], vy = vertices[v + 1];
-					if (positiveArea(p3x, p3y, p1x, p1y, vx, vy)) {
-						if (positiveArea(p1x, p1y, p2x, p2y, vx, vy)) {
-							if (positiveArea(p2x, p2y, p3x, p3y, vx, vy)) {
-								goto break_outer;// break outer;
-							}
-						}
-					}
-				}
-				break;
-			}
-		break_outer:
-
-			if (next == 0) {
-				do {
-					if (!isConcaveArray[i]) break;
-					i--;
-				} while (i > 0);
+			if (!isConcaveArray[i] && isEar(previous[i], i, next[i], vertices)) break;
+			if (next[i] == first) {
+				// No ear was found, cut the last convex vertex, or the first vertex.
+				while (i != first && isConcaveArray[i])
+					i = previous[i];
+				restart = true;
 				break;
 			}
-
-			previous = i;
-			i = next;
-			next = (next + 1) % vertexCount;
+			i = next[i];
 		}
 
 		// Cut ear tip.
-		triangles.add(indices[(vertexCount + i - 1) % vertexCount]);
-		triangles.add(indices[i]);
-		triangles.add(indices[(i + 1) % vertexCount]);
-		indices.removeAt(i);
-		isConcaveArray.removeAt(i);
+		int previousIndex = previous[i], nextIndex = next[i];
+		triangles.add(previousIndex);
+		triangles.add(i);
+		triangles.add(nextIndex);
+		next[previousIndex] = nextIndex;
+		previous[nextIndex] = previousIndex;
+		setConcave(i, false);
+		// Cutting the first or last vertex changes the neighbors of a vertex before start.
+		if (i == first) first = nextIndex;
+		if (nextIndex == first) restart = true;
 		vertexCount--;
 
-		int previousIndex = (vertexCount + i - 1) % vertexCount;
-		int nextIndex = i == vertexCount ? 0 : i;
-		isConcaveArray[previousIndex] = isConcave(previousIndex, vertexCount, vertices, indices);
-		isConcaveArray[nextIndex] = isConcave(nextIndex, vertexCount, vertices, indices);
+		// A vertex that is no longer concave may have been the only one inside an ear before start.
+		bool previousConcave = isConcaveArray[previousIndex], nextConcave = isConcaveArray[nextIndex];
+		setConcave(previousIndex, isConcave(previous[previousIndex], previousIndex, nextIndex, vertices));
+		setConcave(nextIndex, isConcave(previousIndex, nextIndex, next[nextIndex], vertices));
+		if ((previousConcave && !isConcaveArray[previousIndex]) || (nextConcave && !isConcaveArray[nextIndex]))
+			restart = true;
+		start = restart ? first : previousIndex;
 	}
 
 	if (vertexCount == 3) {
-		triangles.add(indices[2]);
-		triangles.add(indices[0]);
-		triangles.add(indices[1]);
+		triangles.add(next[next[first]]);
+		triangles.add(first);
+		triangles.add(next[first]);
 	}
 
 	return triangles;
@@ -269,13 +256,47 @@ Vector<Vector<float> *> &Triangulator::decompose(Vector<float> &vertices, Vector
 	return convexPolygons;
 }
 
-bool Triangulator::isConcave(int index, int vertexCount, Vector<float> &vertices, Vector<int> &indices) {
-	int previous = indices[(vertexCount + index - 1) % vertexCount] << 1;
-	int current = indices[index] << 1;
-	int next = indices[(index + 1) % vertexCount] << 1;
+void Triangulator::setConcave(int index, bool concave) {
+	if (_isConcaveArray[index] == concave) return;
+	_isConcaveArray[index] = concave;
+	if (concave) {
+		_concaveIndex[index] = (int) _concave.size();
+		_concave.add(index);
+	} else {
+		int last = _concave[_concave.size() - 1], position = _concaveIndex[index];
+		_concave[position] = last;
+		_concaveIndex[last] = position;
+		_concave.removeAt(_concave.size() - 1);
+	}
+}
+
+bool Triangulator::isEar(int previous, int index, int next, Vector<float> &vertices) {
+	int p1 = previous << 1, p2 = index << 1, p3 = next << 1;
+	float p1x = vertices[p1], p1y = vertices[p1 + 1];
+	float p2x = vertices[p2], p2y = vertices[p2 + 1];
+	float p3x = vertices[p3], p3y = vertices[p3 + 1];
+	for (size_t i = 0, n = _concave.size(); i < n; ++i) {
+		int concave = _concave[i];
+		if (concave == previous || concave == next) continue;
+
+		int v = concave << 1;
+		float vx = vertices[v], vy = vertices[v + 1];
+		if (positiveArea(p3x, p3y, p1x, p1y, vx, vy)) {
+			if (positiveArea(p1x, p1y, p2x, p2y, vx, vy)) {
+				if (positiveArea(p2x, p2y, p3x, p3y, vx, vy)) return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool Triangulator::isConcave(int previous, int index, int next, Vector<float> &vertices) {
+	previous <<= 1;
+	index <<= 1;
+	next <<= 1;
 
 	return !positiveArea(vertices[previous], vertices[previous + 1],
-						 vertices[current], vertices[current + 1],
+						 vertices[index], vertices[index + 1],
 						 vertices[next], vertices[next + 1]);
 }
 
@@ -36,14 +36,108 @@
 #include <spine/Slot.h>
 
 #include <spine/Bone.h>
+#include <spine/Profiler.h>
 #include <spine/Skeleton.h>
 
+#include <atomic>
+
+// Define SPINE_NO_SIMD to skin weighted vertices with the portable 4 wide fallback below.
+#if !defined(SPINE_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SPINE_SIMD_SSE2
+#include <emmintrin.h>
+#elif !defined(SPINE_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define SPINE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 using namespace spine;
 
+namespace {
+	// 4 wide float operations used to skin 4 vertices at a time. Every lane performs the same IEEE single precision
+	// multiplies and adds, in the same order, as the scalar path, so results are bit identical.
+#if defined(SPINE_SIMD_SSE2)
+	typedef __m128 Float4;
+
+	inline Float4 zero4() { return _mm_setzero_ps(); }
+
+	inline Float4 load4(const float *values) { return _mm_loadu_ps(values); }
+
+	inline void store4(float *values, Float4 v) { _mm_storeu_ps(values, v); }
+
+	inline Float4 add4(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+
+	inline Float4 mul4(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) { _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+#elif defined(SPINE_SIMD_NEON)
+	typedef float32x4_t Float4;
+
+	inline Float4 zero4() { return vdupq_n_f32(0); }
+
+	inline Float4 load4(const float *values) { return vld1q_f32(values); }
+
+	inline void store4(float *values, Float4 v) { vst1q_f32(values, v); }
+
+	inline Float4 add4(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+
+	inline Float4 mul4(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) {
+		float32x4x2_t t01 = vtrnq_f32(r0, r1), t23 = vtrnq_f32(r2, r3);
+		r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+		r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+		r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+		r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+	}
+#else
+	struct Float4 {
+		float v[4];
+	};
+
+	inline Float4 zero4() {
+		Float4 r = {{0, 0, 0, 0}};
+		return r;
+	}
+
+	inline Float4 load4(const float *values) {
+		Float4 r = {{values[0], values[1], values[2], values[3]}};
+		return r;
+	}
+
+	inline void store4(float *values, Float4 v) {
+		for (int i = 0; i < 4; i++) values[i] = v.v[i];
+	}
+
+	inline Float4 add4(Float4 a, Float4 b) {
+		for (int i = 0; i < 4; i++) a.v[i] += b.v[i];
+		return a;
+	}
+
+	inline Float4 mul4(Float4 a, Float4 b) {
+		for (int i = 0; i < 4; i++) a.v[i] *= b.v[i];
+		return a;
+	}
+
+	inline void transpose4(Float4 &r0, Float4 &r1, Float4 &r2, Float4 &r3) {
+		Float4 rows[4] = {r0, r1, r2, r3};
+		for (int i = 0; i < 4; i++) {
+			r0.v[i] = rows[i].v[0];
+			r1.v[i] = rows[i].v[1];
+			r2.v[i] = rows[i].v[2];
+			r3.v[i] = rows[i].v[3];
+		}
+	}
+#endif
+
+	// Floats per gathered bone matrix: a, b, c, d, worldX, worldY and 2 padding values.
+	const int BoneMatrixSize = 8;
+}
+
 RTTI_IMPL(VertexAttachment, Attachment)
 
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0),
-														 _deformAttachment(this), _id(getNextID()) {
+														 _deformAttachment(this), _id(getNextID()),
+														 _weightBlockWeights(0) {
 }
 
 VertexAttachment::~VertexAttachment() {
@@ -64,21 +158,27 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 
 void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 											size_t stride) {
+	SP_PROFILE(ProfilePhase_WorldVertices, &slot.getSkeleton(), &getName(), count >> 1);
+	if (_weightBlockWeights > 0 && _weightBlockWeights * 3 == _vertices.size() && ((start >> 1) & 3) == 0) {
+		computeWeightedWorldVertices(slot, start, count, worldVertices, offset, stride);
+		return;
+	}
+
 	count = offset + (count >> 1) * stride;
 	Skeleton &skeleton = slot._bone._skeleton;
 	Vector<float> *deformArray = &slot.getDeform();
-	Vector<float> *vertices = &_vertices;
-	Vector<size_t> &bones = _bones;
-	if (bones.size() == 0) {
-		if (deformArray->size() > 0) vertices = deformArray;
+	float *vertices = _vertices.buffer();
+	size_t *bones = _bones.buffer();
+	if (_bones.size() == 0) {
+		if (deformArray->size() > 0) vertices = deformArray->buffer();
 
 		Bone &bone = slot._bone;
 		float x = bone._worldX;
 		float y = bone._worldY;
 		float a = bone._a, b = bone._b, c = bone._c, d = bone._d;
 		for (size_t vv = start, w = offset; w < count; vv += 2, w += stride) {
-			float vx = (*vertices)[vv];
-			float vy = (*vertices)[vv + 1];
+			float vx = vertices[vv];
+			float vy = vertices[vv + 1];
 			worldVertices[w] = vx * a + vy * b + x;
 			worldVertices[w + 1] = vx * c + vy * d + y;
 		}
@@ -92,18 +192,17 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 		skip += n;
 	}
 
-	Vector<Bone *> &skeletonBones = skeleton.getBones();
+	Bone **skeletonBones = skeleton.getBones().buffer();
 	if (deformArray->size() == 0) {
 		for (size_t w = offset, b = skip * 3; w < count; w += stride) {
 			float wx = 0, wy = 0;
 			int n = bones[v++];
 			n += v;
 			for (; v < n; v++, b += 3) {
-				Bone *boneP = skeletonBones[bones[v]];
-				Bone &bone = *boneP;
-				float vx = (*vertices)[b];
-				float vy = (*vertices)[b + 1];
-				float weight = (*vertices)[b + 2];
+				Bone &bone = *skeletonBones[bones[v]];
+				float vx = vertices[b];
+				float vy = vertices[b + 1];
+				float weight = vertices[b + 2];
 				wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
 				wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
 			}
@@ -111,16 +210,16 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 			worldVertices[w + 1] = wy;
 		}
 	} else {
+		float *deform = deformArray->buffer();
 		for (size_t w = offset, b = skip * 3, f = skip << 1; w < count; w += stride) {
 			float wx = 0, wy = 0;
 			int n = bones[v++];
 			n += v;
 			for (; v < n; v++, b += 3, f += 2) {
-				Bone *boneP = skeletonBones[bones[v]];
-				Bone &bone = *boneP;
-				float vx = (*vertices)[b] + (*deformArray)[f];
-				float vy = (*vertices)[b + 1] + (*deformArray)[f + 1];
-				float weight = (*vertices)[b + 2];
+				Bone &bone = *skeletonBones[bones[v]];
+				float vx = vertices[b] + deform[f];
+				float vy = vertices[b + 1] + deform[f + 1];
+				float weight = vertices[b + 2];
 				wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
 				wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
 			}
@@ -130,6 +229,138 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 	}
 }
 
+void VertexAttachment::computeWeightedWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices,
+													size_t offset, size_t stride) {
+	// Gather the matrices of the bones used by this attachment so each lane can load its bone with 2 loads. The first
+	// matrix is zero for the padding lanes, so a bone with non-finite values can't turn their zero weights into NaN.
+	Skeleton &skeleton = slot._bone._skeleton;
+	size_t matrixCount = _weightBoneTable.size() + 1;
+	if (skeleton._skinningMatrices.size() < matrixCount * BoneMatrixSize)
+		skeleton._skinningMatrices.setSize(matrixCount * BoneMatrixSize, 0);
+	float *matrices = skeleton._skinningMatrices.buffer();
+	for (int i = 0; i < BoneMatrixSize; i++)
+		matrices[i] = 0;
+	Bone **skeletonBones = skeleton.getBones().buffer();
+	for (size_t i = 0, n = _weightBoneTable.size(); i < n; i++) {
+		Bone &bone = *skeletonBones[_weightBoneTable[i]];
+		float *matrix = matrices + (i + 1) * BoneMatrixSize;
+		matrix[0] = bone._a;
+		matrix[1] = bone._b;
+		matrix[2] = bone._c;
+		matrix[3] = bone._d;
+		matrix[4] = bone._worldX;
+		matrix[5] = bone._worldY;
+		matrix[6] = 0;
+		matrix[7] = 0;
+	}
+
+	size_t firstBlock = start >> 3, vertexCount = count >> 1;
+	int *blockCounts = _weightBlockCounts.buffer();
+	size_t influence = 0;
+	for (size_t i = 0; i < firstBlock; i++)
+		influence += blockCounts[i];
+	int *laneBones = _weightBlockBones.buffer() + influence * 4;
+	int *laneDeform = _weightBlockDeform.buffer() + influence * 4;
+	float *blockVertices = _weightBlockVertices.buffer() + influence * 12;
+	Vector<float> &deformArray = slot.getDeform();
+	float *deform = deformArray.size() > 0 ? deformArray.buffer() : NULL;
+
+	float outX[4], outY[4];
+	for (size_t block = firstBlock, w = offset; vertexCount > 0; block++) {
+		Float4 wx = zero4(), wy = zero4();
+		for (int n = blockCounts[block]; n > 0; n--, laneBones += 4, laneDeform += 4, blockVertices += 12) {
+			Float4 a = load4(matrices + laneBones[0] * BoneMatrixSize);
+			Float4 b = load4(matrices + laneBones[1] * BoneMatrixSize);
+			Float4 c = load4(matrices + laneBones[2] * BoneMatrixSize);
+			Float4 d = load4(matrices + laneBones[3] * BoneMatrixSize);
+			transpose4(a, b, c, d);
+			Float4 x = load4(matrices + laneBones[0] * BoneMatrixSize + 4);
+			Float4 y = load4(matrices + laneBones[1] * BoneMatrixSize + 4);
+			Float4 unused1 = load4(matrices + laneBones[2] * BoneMatrixSize + 4);
+			Float4 unused2 = load4(matrices + laneBones[3] * BoneMatrixSize + 4);
+			transpose4(x, y, unused1, unused2);
+
+			Float4 vx = load4(blockVertices), vy = load4(blockVertices + 4), weight = load4(blockVertices + 8);
+			if (deform) {
+				float deformX[4] = {deform[laneDeform[0]], deform[laneDeform[1]], deform[laneDeform[2]],
+									deform[laneDeform[3]]};
+				float deformY[4] = {deform[laneDeform[0] + 1], deform[laneDeform[1] + 1], deform[laneDeform[2] + 1],
+									deform[laneDeform[3] + 1]};
+				vx = add4(vx, load4(deformX));
+				vy = add4(vy, load4(deformY));
+			}
+			wx = add4(wx, mul4(add4(add4(mul4(vx, a), mul4(vy, b)), x), weight));
+			wy = add4(wy, mul4(add4(add4(mul4(vx, c), mul4(vy, d)), y), weight));
+		}
+		store4(outX, wx);
+		store4(outY, wy);
+		for (int lane = 0; lane < 4 && vertexCount > 0; lane++, vertexCount--, w += stride) {
+			worldVertices[w] = outX[lane];
+			worldVertices[w + 1] = outY[lane];
+		}
+	}
+}
+
+void VertexAttachment::updateWeightBlocks() {
+	_weightBoneTable.clear();
+	_weightBlockCounts.clear();
+	_weightBlockBones.clear();
+	_weightBlockDeform.clear();
+	_weightBlockVertices.clear();
+	_weightBlockWeights = 0;
+	if (_bones.size() == 0) return;
+
+	// Map skeleton bone indices to indices of the gathered matrices, which start with the zero matrix.
+	Vector<int> tableIndices;
+	size_t *bones = _bones.buffer();
+	for (size_t i = 0, n = _bones.size(); i < n;) {
+		size_t nn = bones[i++];
+		for (nn += i; i < nn; i++) {
+			size_t bone = bones[i];
+			if (bone >= tableIndices.size()) tableIndices.setSize(bone + 1, -1);
+			if (tableIndices[bone] == -1) {
+				_weightBoneTable.add((int) bone);
+				tableIndices[bone] = (int) _weightBoneTable.size();
+			}
+		}
+	}
+	float *vertices = _vertices.buffer();
+	size_t vertexCount = _worldVerticesLength >> 1;
+	size_t v = 0, weight = 0;
+	for (size_t first = 0; first < vertexCount; first += 4) {
+		// Index of each lane's bone count in _bones and of its first weight.
+		size_t laneV[4], laneWeight[4];
+		int laneCount[4], blockCount = 0;
+		for (int lane = 0; lane < 4; lane++) {
+			laneV[lane] = v;
+			laneWeight[lane] = weight;
+			laneCount[lane] = 0;
+			if (first + lane >= vertexCount) continue;
+			laneCount[lane] = (int) bones[v];
+			v += laneCount[lane] + 1;
+			weight += laneCount[lane];
+			blockCount = MathUtil::max(blockCount, laneCount[lane]);
+		}
+		_weightBlockCounts.add(blockCount);
+
+		// Lanes with fewer bones are padded with the zero matrix and zero weights, which add exactly 0 to the result.
+		for (int i = 0; i < blockCount; i++) {
+			for (int lane = 0; lane < 4; lane++) {
+				bool used = i < laneCount[lane];
+				_weightBlockBones.add(used ? tableIndices[bones[laneV[lane] + 1 + i]] : 0);
+				_weightBlockDeform.add(used ? (int) (laneWeight[lane] + i) << 1 : 0);
+			}
+			for (int component = 0; component < 3; component++) {
+				for (int lane = 0; lane < 4; lane++) {
+					bool used = i < laneCount[lane];
+					_weightBlockVertices.add(used ? vertices[(laneWeight[lane] + i) * 3 + component] : 0);
+				}
+			}
+		}
+	}
+	_weightBlockWeights = weight;
+}
+
 int VertexAttachment::getId() {
 	return _id;
 }
@@ -159,8 +390,8 @@ void VertexAttachment::setDeformAttachment(VertexAttachment *attachment) {
 }
 
 int VertexAttachment::getNextID() {
-	static int nextID = 0;
-	return nextID++;
+	static std::atomic<int> nextID(0);
+	return nextID.fetch_add(1, std::memory_order_relaxed);
 }
 
 void VertexAttachment::copyTo(VertexAttachment *other) {
@@ -168,4 +399,5 @@ void VertexAttachment::copyTo(VertexAttachment *other) {
 	other->_vertices.clearAndAddAll(this->_vertices);
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_deformAttachment = this->_deformAttachment;
+	other->updateWeightBlocks();
 }
@@ -99,7 +99,8 @@ void SwirlVertexEffect::transform(float &positionX, float &positionY, float &u,
 	float dist = (float) MathUtil::sqrt(x * x + y * y);
 	if (dist < _radius) {
 		float theta = _interpolation.interpolate(0, _angle, (_radius - dist) / _radius);
-		float cos = MathUtil::cos(theta), sin = MathUtil::sin(theta);
+		float sin, cos;
+		MathUtil::sincos(theta, sin, cos);
 		positionX = cos * x - sin * y + _worldX;
 		positionY = sin * x + cos * y + _worldY;
 	}
@@ -62,11 +62,9 @@ namespace spine {
 
 	private:
 		mutable bool ownsAnimationStateData;
-		mutable Vector<float> worldVertices;
-		mutable Vector<float> tempUvs;
-		mutable Vector<Color> tempColors;
-		mutable Vector<unsigned short> quadIndices;
-		mutable SkeletonClipping clipper;
+		mutable SkeletonRenderer renderer;
+		/// The vertices of the current render command, converted to SFML once before they are copied to the triangles.
+		mutable Vector<sf::Vertex> commandVertices;
 		mutable bool usePremultipliedAlpha;
 	};
 